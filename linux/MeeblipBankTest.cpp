@@ -0,0 +1,355 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipBankTest.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   getChunk/setChunk round trip of a bank and a preset, bad
+//                      chunks are rejected and leave the bank unchanged
+//    17.10.2026  AWe   compare masks, morph end points and randomize with a
+//                      fixed seed of MeeblipVST_ProgramBank, and the bank
+//                      commands of the plugin through effVendorSpecific
+//
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST.h"
+#include "MeeblipVST_Chunk.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern "C" AEffect* VSTPluginMain( audioMasterCallback audioMaster);
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static int failures = 0;
+
+static void check( bool ok, const char* what)
+{
+   printf( "%-56s %s\n", what, ok ? "ok" : "FAILED");
+   failures += ok ? 0 : 1;
+}
+
+static bool sameRows( const MeeblipVST_ProgramBank& a, const MeeblipVST_ProgramBank& b, VstInt32 first, VstInt32 last)
+{
+   for( VstInt32 i = first; i <= last; i++)
+   {
+      if( memcmp( a.getRow( i), b.getRow( i), kNumPrograms) != 0)
+         return false;
+   }
+   return true;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static void testCompare()
+{
+   MeeblipVST_ProgramBank* a = new MeeblipVST_ProgramBank();
+   MeeblipVST_ProgramBank* b = new MeeblipVST_ProgramBank();
+   unsigned char changed[ kNumPrograms];
+
+   check( a->compare( *b, changed) == 0, "compare: equal banks");
+
+   b->setValue( 3, kCutoff, ( a->getValue( 3, kCutoff) + 1) & 0x7f);
+   b->setName( 77, "changed");
+   b->setMidiOutChannel( 100, 1.0f);
+
+   bool mask = true;
+   for( VstInt32 p = 0; p < kNumPrograms; p++)
+      mask = mask && changed[ p] == 0;
+   VstInt32 count = a->compare( *b, changed);
+   for( VstInt32 p = 0; p < kNumPrograms; p++)
+      mask = mask && changed[ p] == ( p == 3 || p == 77 || p == 100 ? 1 : 0);
+
+   check( count == 3, "compare: a value, a name and a channel differ");
+   check( mask, "compare: mask of the changed programs");
+   check( b->compare( *a) == 3, "compare: without mask, other direction");
+
+   delete a;
+   delete b;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static void testMorph()
+{
+   MeeblipVST_ProgramBank* a = new MeeblipVST_ProgramBank();
+   MeeblipVST_ProgramBank* b = new MeeblipVST_ProgramBank();
+   MeeblipVST_ProgramBank* m = new MeeblipVST_ProgramBank();
+
+   a->randomize( 0, kNumGuiParameters - 1, 1.0f, 1);
+   b->randomize( 0, kNumGuiParameters - 1, 1.0f, 2);
+   for( VstInt32 p = 0; p < kNumPrograms; p++)
+   {
+      b->setName( p, "to");
+      b->setMidiInChannel( p, 1.0f);
+   }
+
+   m->morph( *a, *b, 0.0f);
+   check( m->compare( *a) == 0, "morph: amount 0 is from");
+
+   m->morph( *a, *b, 1.0f);
+   check( m->compare( *b) == 0, "morph: amount 1 is to");
+
+   m->morph( *a, *b, 0.5f);
+   bool half = true;
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+   {
+      for( VstInt32 p = 0; p < kNumPrograms; p++)
+         half = half && m->getValue( p, i) == ( a->getValue( p, i) + b->getValue( p, i) + 1) / 2;
+   }
+   check( half, "morph: amount 0.5 is the rounded mean");
+   check( strcmp( m->getName( 5), "to") == 0, "morph: names of the nearer bank");
+
+   m->morph( *a, *b, 0.25f);
+   check( strcmp( m->getName( 5), a->getName( 5)) == 0 && m->getMidiInChannel( 5) == a->getMidiInChannel( 5),
+          "morph: amount 0.25 keeps the names and channels of from");
+
+   // in place, the bank is from
+   *m = *a;
+   m->morph( *m, *b, 1.0f);
+   check( m->compare( *b) == 0, "morph: in place");
+
+   delete a;
+   delete b;
+   delete m;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static void testRandomize()
+{
+   MeeblipVST_ProgramBank* init = new MeeblipVST_ProgramBank();
+   MeeblipVST_ProgramBank* a = new MeeblipVST_ProgramBank();
+   MeeblipVST_ProgramBank* b = new MeeblipVST_ProgramBank();
+
+   a->randomize( 0, kNumGuiParameters - 1, 0.5f, 7);
+   b->randomize( 0, kNumGuiParameters - 1, 0.5f, 7);
+   check( a->compare( *b) == 0, "randomize: the same seed gives the same bank");
+   check( a->compare( *init) > 0, "randomize: the bank is changed");
+
+   // a saved seed has to give the same bank in later versions, the hash
+   // of all values is compared to the one recorded for seed 7
+   unsigned int hash = 0;
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+   {
+      for( VstInt32 p = 0; p < kNumPrograms; p++)
+         hash = hash * 31 + a->getValue( p, i);
+   }
+   check( hash == 0xcf149129U, "randomize: seed 7 gives the recorded bank");
+
+   *b = *init;
+   b->randomize( 0, kNumGuiParameters - 1, 0.5f, 8);
+   check( a->compare( *b) > 0, "randomize: another seed gives another bank");
+
+   // offsets of up to +-amount * 64
+   bool range = true;
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+   {
+      for( VstInt32 p = 0; p < kNumPrograms; p++)
+      {
+         int offset = a->getValue( p, i) - init->getValue( p, i);
+         range = range && offset >= -32 && offset <= 32 && a->getValue( p, i) <= 127;
+      }
+   }
+   check( range, "randomize: offsets within +-amount * 64");
+
+   *b = *init;
+   b->randomize( 0, kNumGuiParameters - 1, 0.0f, 7);
+   check( b->compare( *init) == 0, "randomize: amount 0 changes nothing");
+
+   *b = *init;
+   b->randomize( 5, 9, 1.0f, 7);
+   check( sameRows( *b, *init, 0, 4) && sameRows( *b, *init, 10, kNumGuiParameters - 1) && !sameRows( *b, *init, 5, 9),
+          "randomize: only the parameters first..last");
+
+   delete init;
+   delete a;
+   delete b;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static VstIntPtr VSTCALLBACK hostCallback( AEffect* effect, VstInt32 opcode, VstInt32 index, VstIntPtr value, void* ptr, float opt)
+{
+   return opcode == audioMasterVersion ? kVstVersion : 0;
+}
+
+// the commands a host sends through the dispatcher
+
+static void testPlugin()
+{
+   AEffect* effect = VSTPluginMain( hostCallback);
+   if( effect == NULL)
+   {
+      check( false, "plugin: create");
+      return;
+   }
+   effect->dispatcher( effect, effOpen, 0, 0, NULL, 0);
+
+   void* data = NULL;
+   VstInt32 size = (VstInt32)effect->dispatcher( effect, effGetChunk, 0, 0, &data, 0);
+   unsigned char* saved = (unsigned char*)malloc( size);
+   memcpy( saved, data, size);
+
+   check( effect->dispatcher( effect, effVendorSpecific, PLUG_VENDOR_COMPARE, size, saved, 0) == 0,
+          "plugin: compare with its own chunk");
+   check( effect->dispatcher( effect, effVendorSpecific, PLUG_VENDOR_COMPARE, 16, saved, 0) == -1,
+          "plugin: compare with a truncated chunk");
+
+   float cutoff = effect->getParameter( effect, kCutoff);
+   effect->dispatcher( effect, effVendorSpecific, PLUG_VENDOR_RANDOMIZE, 3, NULL, 0.5f);
+   VstIntPtr changed = effect->dispatcher( effect, effVendorSpecific, PLUG_VENDOR_COMPARE, size, saved, 0);
+   check( changed == kNumPrograms, "plugin: randomize changes all programs");
+   check( effect->getParameter( effect, kCutoff) != cutoff, "plugin: randomize loads the current program");
+
+   check( effect->dispatcher( effect, effVendorSpecific, PLUG_VENDOR_MORPH, size, saved, 1.0f) == 1
+       && effect->dispatcher( effect, effVendorSpecific, PLUG_VENDOR_COMPARE, size, saved, 0) == 0,
+          "plugin: morph to the saved chunk");
+   check( effect->getParameter( effect, kCutoff) == cutoff, "plugin: morph loads the current program");
+
+   free( saved);
+   effect->dispatcher( effect, effClose, 0, 0, NULL, 0);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// a copy of the bank or preset chunk, free() it
+
+static unsigned char* copyChunk( AEffect* effect, bool isPreset, VstInt32& size)
+{
+   void* data = NULL;
+   size = (VstInt32)effect->dispatcher( effect, effGetChunk, isPreset ? 1 : 0, 0, &data, 0);
+   unsigned char* copy = (unsigned char*)malloc( size);
+   memcpy( copy, data, size);
+   return copy;
+}
+
+static bool sameChunk( AEffect* effect, bool isPreset, const unsigned char* expected, VstInt32 expectedSize)
+{
+   void* data = NULL;
+   VstInt32 size = (VstInt32)effect->dispatcher( effect, effGetChunk, isPreset ? 1 : 0, 0, &data, 0);
+   return size == expectedSize && memcmp( data, expected, size) == 0;
+}
+
+static VstIntPtr setChunk( AEffect* effect, bool isPreset, unsigned char* data, VstInt32 size)
+{
+   return effect->dispatcher( effect, effSetChunk, isPreset ? 1 : 0, size, data, 0);
+}
+
+// a header field of a chunk, see MeeblipVST_Chunk.h
+
+static void setHeaderField( unsigned char* chunk, VstInt32 field, VstInt32 value)
+{
+   MeeblipVST_ChunkWriter writer( chunk + 4 * field);
+   writer.putInt32( value);
+}
+
+// setChunk of a bad chunk returns 0 and leaves the bank as it is
+
+static void checkRejected( AEffect* effect, bool isPreset, const unsigned char* chunk, VstInt32 size,
+                           VstInt32 field, VstInt32 value, VstInt32 byteSize, const char* what)
+{
+   VstInt32 bankSize;
+   unsigned char* bank = copyChunk( effect, false, bankSize);
+   unsigned char* bad = (unsigned char*)malloc( size);
+   memcpy( bad, chunk, size);
+   if( field >= 0)
+      setHeaderField( bad, field, value);
+
+   check( setChunk( effect, isPreset, bad, byteSize) == 0 && sameChunk( effect, false, bank, bankSize), what);
+
+   free( bad);
+   free( bank);
+}
+
+static void testChunk()
+{
+   AEffect* effect = VSTPluginMain( hostCallback);
+   if( effect == NULL)
+   {
+      check( false, "chunk: create");
+      return;
+   }
+   effect->dispatcher( effect, effOpen, 0, 0, NULL, 0);
+
+   // a bank restores all programs, the current program and the extra
+   // parameters
+   effect->dispatcher( effect, effVendorSpecific, PLUG_VENDOR_RANDOMIZE, 11, NULL, 0.5f);
+   effect->dispatcher( effect, effSetProgram, 0, 5, NULL, 0);
+   VstInt32 bankSize;
+   unsigned char* bank = copyChunk( effect, false, bankSize);
+
+   effect->dispatcher( effect, effVendorSpecific, PLUG_VENDOR_RANDOMIZE, 12, NULL, 0.5f);
+   effect->dispatcher( effect, effSetProgram, 0, 9, NULL, 0);
+   check( !sameChunk( effect, false, bank, bankSize), "chunk: the bank is changed");
+   check( setChunk( effect, false, bank, bankSize) == 1 && sameChunk( effect, false, bank, bankSize),
+          "chunk: bank round trip");
+   check( effect->dispatcher( effect, effGetProgram, 0, 0, NULL, 0) == 5, "chunk: bank restores the current program");
+
+   // a preset goes to the current program only
+   VstInt32 presetSize;
+   unsigned char* preset = copyChunk( effect, true, presetSize);
+   effect->dispatcher( effect, effVendorSpecific, PLUG_VENDOR_RANDOMIZE, 13, NULL, 0.5f);
+   check( setChunk( effect, true, preset, presetSize) == 1 && sameChunk( effect, true, preset, presetSize),
+          "chunk: preset round trip");
+
+   // the preset of program 6 differs in curProgram only
+   effect->dispatcher( effect, effSetProgram, 0, 6, NULL, 0);
+   VstInt32 result = (VstInt32)setChunk( effect, true, preset, presetSize);
+   setHeaderField( preset, 4, 6);
+   check( result == 1 && sameChunk( effect, true, preset, presetSize), "chunk: preset to another program");
+
+   // bad chunks, the bank stays as it is
+   checkRejected( effect, false, bank, bankSize, -1, 0, 16, "chunk: bank with truncated header");
+   checkRejected( effect, false, bank, bankSize, -1, 0, bankSize - 1, "chunk: truncated bank");
+   checkRejected( effect, true, preset, presetSize, -1, 0, presetSize - 1, "chunk: truncated preset");
+   checkRejected( effect, false, bank, bankSize, 0, CCONST( 'M', 'B', 'c', 'X'), bankSize, "chunk: bad magic");
+   checkRejected( effect, true, preset, presetSize, 0, 0, presetSize, "chunk: preset with bad magic");
+   checkRejected( effect, false, bank, bankSize, 1, 0, bankSize, "chunk: version 0");
+   checkRejected( effect, false, bank, bankSize, 2, 0x7fffffff, bankSize, "chunk: oversized header size");
+   checkRejected( effect, false, bank, bankSize, 3, 0x7fffffff, bankSize, "chunk: oversized number of programs");
+   checkRejected( effect, false, bank, bankSize, 3, 0, bankSize, "chunk: no programs");
+   checkRejected( effect, false, bank, bankSize, 5, 0x7fffffff, bankSize, "chunk: oversized number of parameters");
+   checkRejected( effect, false, bank, bankSize, 6, 0x7fffffff, bankSize, "chunk: oversized number of extra parameters");
+   checkRejected( effect, false, bank, bankSize, 7, 0x7fffffff, bankSize, "chunk: oversized program size");
+   checkRejected( effect, false, bank, bankSize, 7, -1, bankSize, "chunk: negative program size");
+
+   free( preset);
+   free( bank);
+   effect->dispatcher( effect, effClose, 0, 0, NULL, 0);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+int main()
+{
+   testCompare();
+   testMorph();
+   testRandomize();
+   testPlugin();
+   testChunk();
+
+   printf( failures ? "FAILED\n" : "passed\n");
+   return failures ? 1 : 0;
+}
@@ -0,0 +1,667 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipBench.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   getFixedPointKernel() instead of getFirmwareKernel()
+//    17.10.2026  AWe   processReplacingFixedPoint, the firmware mode is the
+//                      fixed point mode
+//    17.10.2026  AWe   every kernel at 44.1, 48 and 96 kHz, the number of
+//                      voices one core renders in real time
+//    17.10.2026  AWe   compare, morph and randomize of the program bank
+//    17.10.2026  AWe   processDoubleReplacing for all polyphonies, the
+//                      difference of the float to the double output
+//    17.10.2026  AWe   processReplacing with 1..N render threads
+//    17.10.2026  AWe   processReplacing with 2x/4x/8x oversampling
+//    17.10.2026  AWe   processReplacing with the firmware emulation
+//    17.10.2026  AWe   micro benchmarks of the audio callback, the event
+//                      path and the parameter path, results as JSON
+//
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST.h"
+#include "MeeblipVST_Kernel.h"
+#include "aweThread.h"
+#include "aweAllocGuard.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <vector>
+#include <algorithm>
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+#define BENCH_SAMPLE_RATE     44100.0f
+#define BENCH_SAMPLES         ( 1 << 18)     // rendered per case
+#define BENCH_QUICK_SAMPLES   ( 1 << 15)
+#define BENCH_MIN_CALLBACKS   256
+#define BENCH_WARMUP_BLOCKS   16
+
+static const VstInt32 blockSizes[]   = { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+static const VstInt32 polyphonies[]  = { 1, 8, 32 };
+static const VstInt32 densities[]    = { 0, 2, 20 };         // events per 1000 samples
+static const VstInt32 eventBatches[] = { 1, 16, 256 };       // events per processEvents()
+static const float    kernelRates[]  = { 44100.0f, 48000.0f, 96000.0f };
+
+#define NUM_ELEMENTS(a)    ( sizeof( a) / sizeof( a[0]))
+
+static VstIntPtr VSTCALLBACK hostCallback( AEffect* effect, VstInt32 opcode, VstInt32 index, VstIntPtr value, void* ptr, float opt)
+{
+   switch( opcode)
+   {
+      case audioMasterVersion:                return kVstVersion;
+      case audioMasterGetSampleRate:          return (VstIntPtr)BENCH_SAMPLE_RATE;
+      case audioMasterGetCurrentProcessLevel: return kVstProcessLevelRealtime;
+      case audioMasterProcessEvents:          return 1;    // midi output is dropped
+   }
+   return 0;
+}
+
+// --------------------------------------------------------------------------
+// timing results of one case
+// --------------------------------------------------------------------------
+
+class BenchResult
+{
+public:
+   BenchResult( size_t capacity) : allocs( 0), units( 0) { times.reserve( capacity); }
+
+   void begin()
+   {
+      times.clear();
+      allocs = aweAllocGuard::getCount();
+      units = 0;
+   }
+
+   void add( double seconds, long count)  { times.push_back( seconds); units += count; }
+   void end()                             { allocs = aweAllocGuard::getCount() - allocs; }
+
+   double getNsPerUnit()
+   {
+      double total = 0.0;
+      for( size_t i = 0; i < times.size(); i++)
+         total += times[i];
+      return units ? 1.0e9 * total / units : 0.0;
+   }
+
+   // one JSON object, unit is "sample", "event" or "call"
+   void print( FILE* out, bool& first, const char* name, const char* unit, VstInt32 blockSize, VstInt32 polyphony, VstInt32 density, VstInt32 batch, VstInt32 threads = 0)
+   {
+      std::sort( times.begin(), times.end());
+
+      double total = 0.0;
+      for( size_t i = 0; i < times.size(); i++)
+         total += times[i];
+
+      fprintf( out, "%s\n    { \"name\": \"%s\"", first ? "" : ",", name);
+      if( blockSize) fprintf( out, ", \"blockSize\": %d", blockSize);
+      if( polyphony) fprintf( out, ", \"polyphony\": %d", polyphony);
+      if( density >= 0) fprintf( out, ", \"eventsPer1000Samples\": %d", density);
+      if( batch) fprintf( out, ", \"eventsPerCall\": %d", batch);
+      if( threads) fprintf( out, ", \"threads\": %d", threads);
+      fprintf( out, ", \"callbacks\": %u, \"ns_per_%s\": %.3f, \"p50_ns\": %.0f, \"p99_ns\": %.0f, \"p999_ns\": %.0f, \"max_ns\": %.0f, \"allocs_per_callback\": %.4f }",
+               (unsigned int)times.size(), unit, units ? 1.0e9 * total / units : 0.0,
+               1.0e9 * percentile( 0.5), 1.0e9 * percentile( 0.99), 1.0e9 * percentile( 0.999), 1.0e9 * percentile( 1.0),
+               times.empty() ? 0.0 : (double)allocs / times.size());
+      first = false;
+   }
+
+private:
+   double percentile( double p)
+   {
+      if( times.empty())
+         return 0.0;
+      size_t i = (size_t)( p * ( times.size() - 1) + 0.5);
+      return times[i];
+   }
+
+   std::vector<double> times;
+   unsigned int allocs;
+   long units;
+};
+
+// --------------------------------------------------------------------------
+// BenchVST, times postProcess() inside the real callbacks
+// --------------------------------------------------------------------------
+
+class BenchVST : public MeeblipVST
+{
+public:
+   BenchVST() : MeeblipVST( hostCallback), postResult( NULL) {}
+
+   virtual void postProcess()
+   {
+      if( postResult == NULL)
+      {
+         MeeblipVST::postProcess();
+         return;
+      }
+
+      double start = aweGetTime();
+      MeeblipVST::postProcess();
+      postResult->add( aweGetTime() - start, 1);
+   }
+
+   BenchResult* postResult;      // NULL: not timed
+};
+
+// --------------------------------------------------------------------------
+// event source, keeps the polyphony constant: every second event releases
+// the oldest held note, the other starts a new one
+// --------------------------------------------------------------------------
+
+class BenchEvents
+{
+public:
+   BenchEvents() : numEvents( 0), nextNote( 0), oldestNote( 0), noteOn( false), pending( 0.0)
+   {
+      memset( events, 0, sizeof( events));
+      memset( &vstEvents, 0, sizeof( vstEvents));
+      for( VstInt32 i = 0; i < MAX_EVENTS_PER_TIMESLICE; i++)
+         vstEvents.events[i] = (VstEvent*)&events[i];
+   }
+
+   void start( MeeblipVST* plug, VstInt32 polyphony)
+   {
+      nextNote = 0;
+      oldestNote = 0;
+      pending = 0.0;
+      numEvents = 0;
+      noteOn = false;
+
+      for( VstInt32 i = 0; i < polyphony; i++)
+         add( 0x90, note( nextNote++), 100, 0);
+      send( plug);
+   }
+
+   void add( VstInt32 status, VstInt32 data1, VstInt32 data2, VstInt32 deltaFrames)
+   {
+      if( numEvents >= MAX_EVENTS_PER_TIMESLICE)
+         return;
+
+      VstMidiEvent& event = events[ numEvents++];
+      event.type        = kVstMidiType;
+      event.byteSize    = sizeof( VstMidiEvent);
+      event.deltaFrames = deltaFrames;
+      event.midiData[0] = (char)status;
+      event.midiData[1] = (char)data1;
+      event.midiData[2] = (char)data2;
+   }
+
+   // density events per 1000 samples, spread over the block
+   void fill( VstInt32 density, VstInt32 blockSize)
+   {
+      numEvents = 0;
+      pending += density * blockSize / 1000.0;
+
+      VstInt32 count = (VstInt32)pending;
+      pending -= count;
+
+      for( VstInt32 i = 0; i < count; i++)
+      {
+         VstInt32 delta = (VstInt32)( (long)i * blockSize / count);
+         if( noteOn)
+            add( 0x90, note( nextNote++), 100, delta);
+         else
+            add( 0x80, note( oldestNote++), 0, delta);
+         noteOn = !noteOn;
+      }
+   }
+
+   void send( MeeblipVST* plug)
+   {
+      vstEvents.numEvents = numEvents;
+      if( numEvents)
+         plug->processEvents( (VstEvents*)&vstEvents);
+   }
+
+   VstInt32 numEvents;
+
+private:
+   static VstInt32 note( VstInt32 i)   { return 36 + i % 60; }
+
+   VstMidiEvent events[ MAX_EVENTS_PER_TIMESLICE];
+   MyVstEvents vstEvents;
+   VstInt32 nextNote;
+   VstInt32 oldestNote;
+   bool noteOn;
+   double pending;
+};
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// oversampling 0..3 for 1x..8x, the plugin starts no more render threads
+// than there are cores
+static BenchVST* createPlugin( VstInt32 polyphony, VstInt32 blockSize, VstInt32 oversampling = 0, VstInt32 threads = 1)
+{
+   BenchVST* plug = new BenchVST();
+   plug->setSampleRate( BENCH_SAMPLE_RATE);
+   plug->setBlockSize( blockSize);
+   plug->setParameter( kVoiceMode, float( kVoiceModePoly) / ( kNumVoiceModes - 1));
+   plug->setParameter( kPolyphony, float( polyphony - 1) / ( kMaxVoices - 1));
+   plug->setParameter( kOversampling, float( oversampling) / ( kNumOversampleFactors - 1));
+   plug->setParameter( kRenderThreads, float( threads - 1) / ( kMaxRenderThreads - 1));
+   plug->resume();
+   return plug;
+}
+
+template <typename FloatType>
+static void benchProcess( FILE* out, bool& first, long samples, VstInt32 blockSize, VstInt32 polyphony, VstInt32 density,
+                          BenchResult& result, BenchEvents& events, VstInt32 engineMode = kEngineModern, VstInt32 oversampling = 0,
+                          VstInt32 threads = 0)
+{
+   std::vector<FloatType> memory( 4 * blockSize, FloatType( 0));
+   FloatType* inputs[2]  = { &memory[0], &memory[ blockSize] };
+   FloatType* outputs[2] = { &memory[ 2 * blockSize], &memory[ 3 * blockSize] };
+
+   BenchVST* plug = createPlugin( polyphony, blockSize, oversampling, threads ? threads : 1);
+   plug->setParameter( kEngineMode, float( engineMode) / ( kNumEngineModes - 1));
+   events.start( plug, polyphony);
+
+   long callbacks = std::max( samples / blockSize, (long)BENCH_MIN_CALLBACKS);
+
+   for( long i = 0; i < BENCH_WARMUP_BLOCKS + callbacks; i++)
+   {
+      if( i == BENCH_WARMUP_BLOCKS)
+         result.begin();
+
+      events.fill( density, blockSize);
+
+      double start = aweGetTime();
+      events.send( plug);
+      if( sizeof( FloatType) == sizeof( double))
+         plug->processDoubleReplacing( (double**)inputs, (double**)outputs, blockSize);
+      else
+         plug->processReplacing( (float**)inputs, (float**)outputs, blockSize);
+      double time = aweGetTime() - start;
+
+      if( i >= BENCH_WARMUP_BLOCKS)
+         result.add( time, blockSize);
+   }
+   result.end();
+
+   const char* name = sizeof( FloatType) == sizeof( double) ? "processDoubleReplacing" : "processReplacing";
+   if( threads)
+      name = "processReplacingThreads";
+   else if( engineMode == kEngineFixedPoint)
+      name = "processReplacingFixedPoint";
+   else if( oversampling == 1)
+      name = "processReplacingOversampled2x";
+   else if( oversampling == 2)
+      name = "processReplacingOversampled4x";
+   else if( oversampling == 3)
+      name = "processReplacingOversampled8x";
+   result.print( out, first, name, "sample", blockSize, polyphony, density, 0, threads);
+
+   delete plug;
+}
+
+// the same events through processReplacing and processDoubleReplacing,
+// the difference of the outputs relative to the peak of the double one. The
+// float phases drift against the double ones, the difference grows with
+// the length of the notes
+static void benchPrecision( FILE* out, bool& first, long samples, VstInt32 polyphony, VstInt32 density, BenchEvents& events)
+{
+   const VstInt32 blockSize = 256;
+   std::vector<float> floatMemory( 4 * blockSize, 0.0f);
+   std::vector<double> doubleMemory( 4 * blockSize, 0.0);
+   float* floatInputs[2]    = { &floatMemory[0], &floatMemory[ blockSize] };
+   float* floatOutputs[2]   = { &floatMemory[ 2 * blockSize], &floatMemory[ 3 * blockSize] };
+   double* doubleInputs[2]  = { &doubleMemory[0], &doubleMemory[ blockSize] };
+   double* doubleOutputs[2] = { &doubleMemory[ 2 * blockSize], &doubleMemory[ 3 * blockSize] };
+
+   long blocks = samples / blockSize;
+   std::vector<float> floatOut( blocks * blockSize);
+   std::vector<double> doubleOut( blocks * blockSize);
+
+   BenchVST* plug = createPlugin( polyphony, blockSize);
+   events.start( plug, polyphony);
+   for( long i = 0; i < blocks; i++)
+   {
+      events.fill( density, blockSize);
+      events.send( plug);
+      memset( floatOutputs[0], 0, blockSize * sizeof( float));
+      plug->processReplacing( floatInputs, floatOutputs, blockSize);
+      memcpy( &floatOut[ i * blockSize], floatOutputs[0], blockSize * sizeof( float));
+   }
+   delete plug;
+
+   plug = createPlugin( polyphony, blockSize);
+   events.start( plug, polyphony);
+   for( long i = 0; i < blocks; i++)
+   {
+      events.fill( density, blockSize);
+      events.send( plug);
+      memset( doubleOutputs[0], 0, blockSize * sizeof( double));
+      plug->processDoubleReplacing( doubleInputs, doubleOutputs, blockSize);
+      memcpy( &doubleOut[ i * blockSize], doubleOutputs[0], blockSize * sizeof( double));
+   }
+   delete plug;
+
+   double peak = 0.0;
+   double maxDiff = 0.0;
+   double sum = 0.0;
+   for( size_t i = 0; i < doubleOut.size(); i++)
+   {
+      double diff = fabs( floatOut[i] - doubleOut[i]);
+      peak = std::max( peak, fabs( doubleOut[i]));
+      maxDiff = std::max( maxDiff, diff);
+      sum += diff * diff;
+   }
+   double rms = doubleOut.empty() ? 0.0 : sqrt( sum / doubleOut.size());
+
+   // -999 dB: no difference
+   fprintf( out, "%s\n    { \"name\": \"floatVsDouble\", \"blockSize\": %d, \"polyphony\": %d, \"eventsPer1000Samples\": %d, \"samples\": %ld, \"peak\": %.6f, \"max_diff_db\": %.1f, \"rms_diff_db\": %.1f }",
+            first ? "" : ",", blockSize, polyphony, density, blocks * blockSize, peak,
+            maxDiff > 0.0 && peak > 0.0 ? 20.0 * log10( maxDiff / peak) : -999.0,
+            rms > 0.0 && peak > 0.0 ? 20.0 * log10( rms / peak) : -999.0);
+   first = false;
+}
+
+// postProcess() with automation of kParamsPerBlock parameters, each
+// change is sent as CC to the hardware
+static void benchPostProcess( FILE* out, bool& first, long samples, VstInt32 blockSize, BenchResult& result)
+{
+   const VstInt32 kParamsPerBlock = 4;
+   std::vector<float> memory( 4 * blockSize, 0.0f);
+   float* inputs[2]  = { &memory[0], &memory[ blockSize] };
+   float* outputs[2] = { &memory[ 2 * blockSize], &memory[ 3 * blockSize] };
+
+   BenchVST* plug = createPlugin( 8, blockSize);
+   long callbacks = std::max( samples / blockSize, (long)BENCH_MIN_CALLBACKS);
+
+   for( long i = 0; i < BENCH_WARMUP_BLOCKS + callbacks; i++)
+   {
+      if( i == BENCH_WARMUP_BLOCKS)
+      {
+         result.begin();
+         plug->postResult = &result;
+      }
+
+      for( VstInt32 j = 0; j < kParamsPerBlock; j++)
+         plug->setParameter( kOscDetune + j, ( ( i + j) & 0x7f) * ( 1.0f / 127));
+
+      plug->processReplacing( inputs, outputs, blockSize);
+   }
+   result.end();
+   result.print( out, first, "postProcess", "call", blockSize, 8, -1, 0);
+
+   delete plug;
+}
+
+// processEvents() only, the queue is emptied by an untimed block
+static void benchEvents( FILE* out, bool& first, long samples, VstInt32 batch, BenchResult& result, BenchEvents& events)
+{
+   const VstInt32 blockSize = 256;
+   std::vector<float> memory( 4 * blockSize, 0.0f);
+   float* inputs[2]  = { &memory[0], &memory[ blockSize] };
+   float* outputs[2] = { &memory[ 2 * blockSize], &memory[ 3 * blockSize] };
+
+   BenchVST* plug = createPlugin( 8, blockSize);
+   long calls = std::max( samples / blockSize, (long)BENCH_MIN_CALLBACKS);
+
+   result.begin();
+   for( long i = 0; i < calls; i++)
+   {
+      events.numEvents = 0;
+      for( VstInt32 j = 0; j < batch; j++)
+         events.add( 0xb0, kCCCutoff, j & 0x7f, (VstInt32)( (long)j * blockSize / batch));
+
+      double start = aweGetTime();
+      events.send( plug);
+      result.add( aweGetTime() - start, batch);
+
+      plug->processReplacing( inputs, outputs, blockSize);
+   }
+   result.end();
+   result.print( out, first, "processEvents", "event", 0, 0, -1, batch);
+
+   delete plug;
+}
+
+// setParameter() / getParameter() from the audio thread, outside of a block
+static void benchParameters( FILE* out, bool& first, long samples, BenchResult& result)
+{
+   const VstInt32 blockSize = 256;
+   std::vector<float> memory( 4 * blockSize, 0.0f);
+   float* inputs[2]  = { &memory[0], &memory[ blockSize] };
+   float* outputs[2] = { &memory[ 2 * blockSize], &memory[ 3 * blockSize] };
+
+   BenchVST* plug = createPlugin( 8, blockSize);
+   plug->processReplacing( inputs, outputs, blockSize);
+
+   long calls = std::max( samples / 16, (long)BENCH_MIN_CALLBACKS);
+
+   result.begin();
+   for( long i = 0; i < calls; i++)
+   {
+      VstInt32 index = i % kNumGuiParameters;
+      float value = ( i & 0x7f) * ( 1.0f / 127);
+
+      double start = aweGetTime();
+      plug->setParameter( index, value);
+      result.add( aweGetTime() - start, 1);
+
+      if( ( i & 0xff) == 0xff)
+         plug->processReplacing( inputs, outputs, blockSize);
+   }
+   result.end();
+   result.print( out, first, "setParameter", "call", 0, 0, -1, 0);
+
+   volatile float sum = 0.0f;
+   result.begin();
+   for( long i = 0; i < calls; i++)
+   {
+      double start = aweGetTime();
+      sum += plug->getParameter( i % ( kNumGuiParameters + kNumExtraParameters));
+      result.add( aweGetTime() - start, 1);
+   }
+   result.end();
+   result.print( out, first, "getParameter", "call", 0, 0, -1, 0);
+
+   delete plug;
+}
+
+// The engine alone with one kernel, kMaxVoices sustained voices. One unit
+// is one sample of one voice, voicesPerCore is the number of voices the
+// kernel renders in real time on one core at the sample rate
+
+static void benchKernel( FILE* out, bool& first, long samples, VstInt32 type, VstInt32 engineMode, float sampleRate, BenchResult& result)
+{
+   const VstInt32 blockSize = 256;
+   std::vector<float> memory( 2 * blockSize, 0.0f);
+
+   MeeblipVST_Engine* engine = new MeeblipVST_Engine();
+   engine->setSampleRate( sampleRate);
+   engine->setKernel( type);
+   engine->setEngineMode( engineMode);
+   engine->reset();
+
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+      engine->setKnobValue( i, getLayoutItem( i)->defaultValue);
+   engine->setKnobValue( kSustain, 1);
+   engine->setKnobValue( kOscBEnable, 1);
+   engine->setKnobValue( kLfoEnable, 1);
+   engine->setKnobValue( kLfoLevel, 40);
+
+   engine->setPolyphony( kMaxVoices);
+   engine->setVoiceMode( kVoiceModePoly);
+   for( VstInt32 v = 0; v < kMaxVoices; v++)
+      engine->noteOn( 36 + v, 100);
+
+   long callbacks = std::max( samples / blockSize, (long)BENCH_MIN_CALLBACKS);
+
+   for( long i = 0; i < BENCH_WARMUP_BLOCKS + callbacks; i++)
+   {
+      if( i == BENCH_WARMUP_BLOCKS)
+         result.begin();
+
+      double start = aweGetTime();
+      engine->process( &memory[0], &memory[ blockSize], blockSize);
+      double time = aweGetTime() - start;
+
+      if( i >= BENCH_WARMUP_BLOCKS)
+         result.add( time, blockSize * kMaxVoices);
+   }
+   result.end();
+
+   double nsPerVoice = result.getNsPerUnit();
+   fprintf( out, "%s\n    { \"name\": \"kernel\", \"kernel\": \"%s\", \"engine\": \"%s\", \"sampleRate\": %g, \"polyphony\": %d, \"ns_per_voice_sample\": %.3f, \"voicesPerCore\": %.0f }",
+            first ? "" : ",", getKernel( type)->name, engineMode == kEngineFixedPoint ? "fixedPoint" : "modern", sampleRate, kMaxVoices,
+            nsPerVoice, nsPerVoice > 0.0 ? 1.0e9 / ( nsPerVoice * sampleRate) : 0.0);
+   first = false;
+
+   delete engine;
+}
+
+// the operations on the whole program bank, one unit is one program
+static void benchBank( FILE* out, bool& first, long samples, BenchResult& result)
+{
+   MeeblipVST_ProgramBank* a = new MeeblipVST_ProgramBank();
+   MeeblipVST_ProgramBank* b = new MeeblipVST_ProgramBank();
+   MeeblipVST_ProgramBank* m = new MeeblipVST_ProgramBank();
+   b->randomize( 0, kNumGuiParameters - 1, 0.5f, 1);
+
+   long calls = std::max( samples / 256, (long)BENCH_MIN_CALLBACKS);
+   unsigned char changed[ kNumPrograms];
+   volatile VstInt32 count = 0;
+
+   result.begin();
+   for( long i = 0; i < calls; i++)
+   {
+      double start = aweGetTime();
+      count += a->compare( *b, changed);
+      result.add( aweGetTime() - start, kNumPrograms);
+   }
+   result.end();
+   result.print( out, first, "bankCompare", "program", 0, 0, -1, 0);
+
+   result.begin();
+   for( long i = 0; i < calls; i++)
+   {
+      double start = aweGetTime();
+      m->morph( *a, *b, ( i & 0xff) * ( 1.0f / 255));
+      result.add( aweGetTime() - start, kNumPrograms);
+   }
+   result.end();
+   result.print( out, first, "bankMorph", "program", 0, 0, -1, 0);
+
+   result.begin();
+   for( long i = 0; i < calls; i++)
+   {
+      double start = aweGetTime();
+      m->randomize( 0, kNumGuiParameters - 1, 0.25f, (unsigned int)i);
+      result.add( aweGetTime() - start, kNumPrograms);
+   }
+   result.end();
+   result.print( out, first, "bankRandomize", "program", 0, 0, -1, 0);
+
+   delete a;
+   delete b;
+   delete m;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+int main( int argc, char* argv[])
+{
+   long samples = BENCH_SAMPLES;
+   const char* outPath = NULL;
+
+   for( int i = 1; i < argc; i++)
+   {
+      if( strcmp( argv[i], "-q") == 0)
+         samples = BENCH_QUICK_SAMPLES;
+      else if( strcmp( argv[i], "-o") == 0 && i + 1 < argc)
+         outPath = argv[++i];
+      else
+      {
+         fprintf( stderr, "usage: MeeblipBench [-q] [-o results.json]\n"
+                          "   -q   quick run with fewer samples per case\n");
+         return 1;
+      }
+   }
+
+   FILE* out = outPath ? fopen( outPath, "w") : stdout;
+   if( out == NULL)
+   {
+      fprintf( stderr, "can't create %s\n", outPath);
+      return 1;
+   }
+
+   // count the allocations in the callbacks, don't stop
+   aweAllocGuard::setTrap( false);
+
+   BenchResult result( std::max( samples / 16, (long)BENCH_MIN_CALLBACKS) + 1);
+   BenchEvents* events = new BenchEvents();
+   bool first = true;
+
+   fprintf( out, "{\n  \"benchmark\": \"MeeblipBench\",\n  \"sampleRate\": %g,\n  \"kernel\": \"%s\",\n  \"processors\": %d,\n  \"allocGuard\": %s,\n  \"results\": [",
+            BENCH_SAMPLE_RATE, getBestKernel()->name, aweNumProcessors(), AWE_ALLOC_GUARD ? "true" : "false");
+
+   for( size_t p = 0; p < NUM_ELEMENTS( polyphonies); p++)
+      for( size_t d = 0; d < NUM_ELEMENTS( densities); d++)
+         for( size_t b = 0; b < NUM_ELEMENTS( blockSizes); b++)
+            benchProcess<float>( out, first, samples, blockSizes[b], polyphonies[p], densities[d], result, *events);
+
+   // the double path against the float path above, speed and precision
+   for( size_t p = 0; p < NUM_ELEMENTS( polyphonies); p++)
+      for( size_t b = 0; b < NUM_ELEMENTS( blockSizes); b++)
+         benchProcess<double>( out, first, samples, blockSizes[b], polyphonies[p], densities[1], result, *events);
+
+   for( size_t p = 0; p < NUM_ELEMENTS( polyphonies); p++)
+      benchPrecision( out, first, samples, polyphonies[p], densities[1], *events);
+
+   // the integer kernels of the fixed point engine
+   for( size_t p = 0; p < NUM_ELEMENTS( polyphonies); p++)
+      benchProcess<float>( out, first, samples, 256, polyphonies[p], densities[1], result, *events, kEngineFixedPoint);
+
+   // the voices at 2x, 4x and 8x the sample rate plus the decimation
+   for( VstInt32 o = 1; o < kNumOversampleFactors; o++)
+      benchProcess<float>( out, first, samples, 256, 8, densities[1], result, *events, kEngineModern, o);
+
+   // the scaling of the render threads, 32 voices at 4x in 64 sample blocks
+   VstInt32 maxThreads = std::min( aweNumProcessors(), (int)kMaxRenderThreads);
+   for( VstInt32 t = 1; t <= maxThreads; t++)
+      benchProcess<float>( out, first, samples, 64, 32, densities[1], result, *events, kEngineModern, 2, t);
+
+   // every kernel the cpu supports, how many voices fit into one core
+   for( VstInt32 k = 0; k < kNumKernelTypes; k++)
+      for( VstInt32 m = 0; m < kNumEngineModes; m++)
+         for( size_t r = 0; r < NUM_ELEMENTS( kernelRates); r++)
+         {
+            if( getKernel( k) && ( m == kEngineModern || getFixedPointKernel( k)))
+               benchKernel( out, first, samples, k, m, kernelRates[r], result);
+         }
+
+   for( size_t b = 0; b < NUM_ELEMENTS( blockSizes); b++)
+      benchPostProcess( out, first, samples, blockSizes[b], result);
+
+   for( size_t e = 0; e < NUM_ELEMENTS( eventBatches); e++)
+      benchEvents( out, first, samples, eventBatches[e], result, *events);
+
+   benchParameters( out, first, samples, result);
+   benchBank( out, first, samples, result);
+
+   fprintf( out, "\n  ]\n}\n");
+
+   delete events;
+   if( outPath)
+      fclose( out);
+   return 0;
+}
@@ -0,0 +1,167 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipKernelTest.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   getFixedPointKernel() instead of getFirmwareKernel()
+//    17.10.2026  AWe   every kernel against the scalar kernel: the same
+//                      notes rendered with setKernel(), the output has to
+//                      match within kKernelTolerance, the fixed point
+//                      kernels exactly
+//
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST_Engine.h"
+
+#include <stdio.h>
+#include <math.h>
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+#define TEST_SAMPLE_RATE   44100.0f
+#define TEST_FRAMES        8192
+#define TEST_BLOCK         256
+#define TEST_NOTES         8
+
+// the switches which select a different path in the kernels, every
+// combination is rendered
+static const VstInt32 switches[] =
+{
+   kOscBEnable, kOscBWave, kOscAWave, kOscANoise, kAntiAlias, kOscFm, kDistortion, kFilterMode
+};
+
+static const VstInt32 numSwitches = sizeof( switches) / sizeof( switches[0]);
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// TEST_NOTES voices in poly mode, released in the second half, the lfo and
+// the pwm sweep on so the control rate part changes the voices
+
+static void render( VstInt32 kernelType, VstInt32 engineMode, VstInt32 combination, float* out)
+{
+   MeeblipVST_Engine* engine = new MeeblipVST_Engine();
+   engine->setSampleRate( TEST_SAMPLE_RATE);
+   engine->setKernel( kernelType);
+   engine->setEngineMode( engineMode);
+   engine->reset();
+
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+      engine->setKnobValue( i, getLayoutItem( i)->defaultValue);
+
+   for( VstInt32 i = 0; i < numSwitches; i++)
+      engine->setKnobValue( switches[i], ( combination >> i) & 1);
+
+   engine->setKnobValue( kLfoEnable, 1);
+   engine->setKnobValue( kLfoLevel, 40);
+   engine->setKnobValue( kLfoFreq, 80);
+   engine->setKnobValue( kPwmSweep, 1);
+   engine->setKnobValue( kResonance, 100);
+   engine->setKnobValue( kCutoff, 90);
+   engine->setKnobValue( kVcfEnvMod, 30);
+   engine->setKnobValue( kOscDetune, 5);
+
+   engine->setPolyphony( TEST_NOTES);
+   engine->setVoiceMode( kVoiceModePoly);
+
+   for( VstInt32 n = 0; n < TEST_NOTES; n++)
+      engine->noteOn( 36 + 7 * n, 100);
+
+   float* out2 = new float[ TEST_BLOCK];
+   for( VstInt32 pos = 0; pos < TEST_FRAMES; pos += TEST_BLOCK)
+   {
+      if( pos == TEST_FRAMES / 2)
+      {
+         for( VstInt32 n = 0; n < TEST_NOTES; n += 2)
+            engine->noteOff( 36 + 7 * n);
+      }
+
+      for( VstInt32 i = 0; i < TEST_BLOCK; i++)
+         out[ pos + i] = out2[i] = 0.0f;
+      engine->process( out + pos, out2, TEST_BLOCK);
+   }
+
+   delete[] out2;
+   delete engine;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+int main()
+{
+   float* reference = new float[ TEST_FRAMES];
+   float* output = new float[ TEST_FRAMES];
+
+   // the voices are summed in a different order, the tolerance is per voice
+   const float tolerance = kKernelTolerance * TEST_NOTES;
+   int failures = 0;
+
+   for( VstInt32 type = kKernelScalar + 1; type < kNumKernelTypes; type++)
+   {
+      const MeeblipVST_Kernel* kernel = getKernel( type);
+      if( kernel == NULL)
+      {
+         printf( "kernel %d not available\n", type);
+         continue;
+      }
+
+      for( VstInt32 mode = 0; mode < kNumEngineModes; mode++)
+      {
+         if( mode == kEngineFixedPoint && getFixedPointKernel( type) == NULL)
+            continue;
+
+         float maxError = 0.0f;
+         VstInt32 failed = 0;
+         VstInt32 silent = 0;
+
+         for( VstInt32 c = 0; c < ( 1 << numSwitches); c++)
+         {
+            render( kKernelScalar, mode, c, reference);
+            render( type, mode, c, output);
+
+            float error = 0.0f;
+            float peak = 0.0f;
+            for( VstInt32 i = 0; i < TEST_FRAMES; i++)
+            {
+               float d = fabsf( output[i] - reference[i]);
+               error = d > error ? d : error;
+               peak = fabsf( reference[i]) > peak ? fabsf( reference[i]) : peak;
+            }
+
+            // two silent outputs would compare equal
+            if( !( peak > 0.0f))
+               silent++;
+
+            // the integer kernels have to match exactly
+            if( mode == kEngineFixedPoint ? error != 0.0f : !( error <= tolerance))
+            {
+               if( failed == 0)
+                  printf( "   %s %s switches %02x: error %g\n", kernel->name, mode == kEngineFixedPoint ? "fixed" : "modern", c, error);
+               failed++;
+            }
+            maxError = error > maxError ? error : maxError;
+         }
+
+         printf( "%-6s %-8s %3d combinations, max error %g, %d failed, %d silent\n",
+                 kernel->name, mode == kEngineFixedPoint ? "fixed" : "modern", 1 << numSwitches, maxError, failed, silent);
+         failures += failed + silent;
+      }
+   }
+
+   delete[] reference;
+   delete[] output;
+
+   printf( failures ? "FAILED\n" : "passed\n");
+   return failures ? 1 : 0;
+}
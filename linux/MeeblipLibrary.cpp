@@ -0,0 +1,214 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipLibrary.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   command line front end of the patch library: builds
+//                      the index, looks patches up by name, prefix, tag and
+//                      similarity, reports the time of every step
+//
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST_PatchLibrary.h"
+#include "aweThread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+#define DEFAULT_RESULTS    10
+
+static void usage()
+{
+   fprintf( stderr,
+      "usage: MeeblipLibrary [options] <root>\n"
+      "   -i <file>      index file, default <root>/%s\n"
+      "   -u             scan the root and update the index first\n"
+      "   -f <name>      the patch with this name\n"
+      "   -p <prefix>    the patches whose name starts with prefix\n"
+      "   -t <tag>       the patches with this tag\n"
+      "   -s <name>      the patches most similar to the named one\n"
+      "   -n <count>     number of results, default %d\n",
+      PATCH_LIBRARY_INDEX, DEFAULT_RESULTS);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static void printPatch( MeeblipVST_PatchLibrary& library, VstInt32 patch)
+{
+   printf( "   %-24s  %s:%d  [%s]\n", library.getName( patch), library.getPath( patch),
+           library.getProgram( patch), library.getTags( patch));
+}
+
+static double elapsed( double start)
+{
+   return ( aweGetTime() - start) * 1000.0;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+int main( int argc, char* argv[])
+{
+   const char* root = NULL;
+   const char* indexPath = NULL;
+   const char* findName = NULL;
+   const char* prefix = NULL;
+   const char* tag = NULL;
+   const char* similarName = NULL;
+   bool update = false;
+   int maxResults = DEFAULT_RESULTS;
+
+   for( int i = 1; i < argc; i++)
+   {
+      if( strcmp( argv[i], "-i") == 0 && i + 1 < argc)
+         indexPath = argv[++i];
+      else if( strcmp( argv[i], "-u") == 0)
+         update = true;
+      else if( strcmp( argv[i], "-f") == 0 && i + 1 < argc)
+         findName = argv[++i];
+      else if( strcmp( argv[i], "-p") == 0 && i + 1 < argc)
+         prefix = argv[++i];
+      else if( strcmp( argv[i], "-t") == 0 && i + 1 < argc)
+         tag = argv[++i];
+      else if( strcmp( argv[i], "-s") == 0 && i + 1 < argc)
+         similarName = argv[++i];
+      else if( strcmp( argv[i], "-n") == 0 && i + 1 < argc)
+         maxResults = atoi( argv[++i]);
+      else if( argv[i][0] == '-' || root)
+      {
+         usage();
+         return 1;
+      }
+      else
+         root = argv[i];
+   }
+
+   if( root == NULL || maxResults < 1)
+   {
+      usage();
+      return 1;
+   }
+
+   MeeblipVST_PatchLibrary library;
+   double start = aweGetTime();
+
+   if( update)
+   {
+      if( !library.update( root, indexPath))
+      {
+         fprintf( stderr, "can't update the index of %s\n", root);
+         return 1;
+      }
+      printf( "update    %d files, %d patches, %.3f ms\n", library.getNumFiles(), library.getNumPatches(), elapsed( start));
+   }
+   else
+   {
+      if( !library.open( root, indexPath))
+      {
+         fprintf( stderr, "no index for %s, use -u\n", root);
+         return 1;
+      }
+      printf( "open      %d files, %d patches, %.3f ms\n", library.getNumFiles(), library.getNumPatches(), elapsed( start));
+   }
+
+   VstInt32* results = new VstInt32[ maxResults];
+   MeeblipVST_PatchMatch* matches = new MeeblipVST_PatchMatch[ maxResults];
+   int status = 0;
+
+   if( findName)
+   {
+      start = aweGetTime();
+      VstInt32 patch = library.find( findName);
+      double time = elapsed( start);
+
+      printf( "find      \"%s\" %.3f ms\n", findName, time);
+      if( patch >= 0)
+      {
+         printPatch( library, patch);
+
+         float values[ kNumGuiParameters];
+         for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+            values[ i] = 0.0f;
+
+         start = aweGetTime();
+         bool loaded = library.loadPatch( patch, values);
+         time = elapsed( start);
+
+         printf( "load      %s %.3f ms\n  ", loaded ? "ok" : "failed", time);
+         for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+            printf( " %.3f", values[ i]);
+         printf( "\n");
+         status = loaded ? status : 1;
+      }
+      else
+         status = 1;
+   }
+
+   if( prefix)
+   {
+      start = aweGetTime();
+      VstInt32 found = library.findPrefix( prefix, results, maxResults);
+      double time = elapsed( start);
+
+      printf( "prefix    \"%s\" %d found, %.3f ms\n", prefix, found, time);
+      for( VstInt32 i = 0; i < found; i++)
+         printPatch( library, results[ i]);
+   }
+
+   if( tag)
+   {
+      start = aweGetTime();
+      VstInt32 found = 0;
+      for( VstInt32 patch = 0; patch < library.getNumPatches() && found < maxResults; patch++)
+      {
+         if( library.hasTag( patch, tag))
+            results[ found++] = patch;
+      }
+      double time = elapsed( start);
+
+      printf( "tag       \"%s\" %d found, %.3f ms\n", tag, found, time);
+      for( VstInt32 i = 0; i < found; i++)
+         printPatch( library, results[ i]);
+   }
+
+   if( similarName)
+   {
+      VstInt32 patch = library.find( similarName);
+      if( patch < 0)
+      {
+         fprintf( stderr, "no patch \"%s\"\n", similarName);
+         status = 1;
+      }
+      else
+      {
+         start = aweGetTime();
+         VstInt32 found = library.findSimilar( patch, matches, maxResults);
+         double time = elapsed( start);
+
+         printf( "similar   \"%s\" %d found, %.3f ms\n", similarName, found, time);
+         for( VstInt32 i = 0; i < found; i++)
+         {
+            printf( "   %6d", matches[ i].distance);
+            printPatch( library, matches[ i].patch);
+         }
+      }
+   }
+
+   delete[] results;
+   delete[] matches;
+   return status;
+}
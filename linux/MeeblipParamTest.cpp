@@ -0,0 +1,108 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipParamTest.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   the names and display strings of all parameters fit
+//                      into kVstMaxParamStrLen, the full names are served by
+//                      effGetParameterProperties
+//
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+#define TEST_STEPS   256
+#define GUARD_BYTE   0x55
+
+static int failures = 0;
+
+static void check( bool ok, const char* what)
+{
+   printf( "%-56s %s\n", what, ok ? "ok" : "FAILED");
+   failures += ok ? 0 : 1;
+}
+
+static VstIntPtr VSTCALLBACK hostCallback( AEffect* effect, VstInt32 opcode, VstInt32 index, VstIntPtr value, void* ptr, float opt)
+{
+   return opcode == audioMasterVersion ? kVstVersion : 0;
+}
+
+// the host's buffer is kVstMaxParamStrLen bytes, the bytes behind it keep
+// the guard byte and the string is terminated within it
+
+static bool fitsBuffer( const char* text)
+{
+   for( VstInt32 i = kVstMaxParamStrLen; i < kVstExtMaxParamStrLen; i++)
+   {
+      if( (unsigned char)text[i] != GUARD_BYTE)
+         return false;
+   }
+   return memchr( text, 0, kVstMaxParamStrLen) != NULL;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+int main()
+{
+   MeeblipVST* plugin = new MeeblipVST( hostCallback);
+   AEffect* effect = plugin->getAeffect();
+   char text[ kVstExtMaxParamStrLen];
+   char what[ 96];
+
+   for( VstInt32 index = 0; index < kNumParameters; index++)
+   {
+      memset( text, GUARD_BYTE, sizeof( text));
+      effect->dispatcher( effect, effGetParamName, index, 0, text, 0.0f);
+      bool named = fitsBuffer( text) && text[0] != 0;
+      sprintf( what, "name of %d fits: %.*s", index, kVstMaxParamStrLen, text);
+      check( named, what);
+
+      bool displayed = true;
+      for( VstInt32 step = 0; step <= TEST_STEPS; step++)
+      {
+         effect->setParameter( effect, index, (float)step / TEST_STEPS);
+         memset( text, GUARD_BYTE, sizeof( text));
+         effect->dispatcher( effect, effGetParamDisplay, index, 0, text, 0.0f);
+         if( !fitsBuffer( text))
+         {
+            printf( "   %d: %.*s\n", index, kVstExtMaxParamStrLen, text);
+            displayed = false;
+         }
+      }
+      sprintf( what, "display strings of %d fit", index);
+      check( displayed, what);
+
+      VstParameterProperties properties;
+      memset( &properties, GUARD_BYTE, sizeof( properties));
+      bool served = effect->dispatcher( effect, effGetParameterProperties, index, 0, &properties, 0.0f) == 1
+                 && memchr( properties.label, 0, kVstMaxLabelLen) != NULL
+                 && strlen( properties.label) >= strlen( properties.shortLabel)
+                 && strncmp( properties.shortLabel, MeeblipVST_Display::getName( index), kVstMaxShortLabelLen) == 0;
+      sprintf( what, "properties of %d: %s", index, served ? properties.label : "");
+      check( served, what);
+   }
+
+   VstParameterProperties properties;
+   check( effect->dispatcher( effect, effGetParameterProperties, kNumParameters, 0, &properties, 0.0f) == 0,
+          "no properties of an invalid index");
+
+   delete plugin;
+
+   printf( failures ? "FAILED\n" : "passed\n");
+   return failures ? 1 : 0;
+}
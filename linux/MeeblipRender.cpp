@@ -0,0 +1,746 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipRender.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   options -g and -s, request and send sysex dumps
+//    17.10.2026  AWe   -f is the fixed point engine
+//    17.10.2026  AWe   option -l, midi learn of a gui parameter
+//    17.10.2026  AWe   option -o, oversampling factor, the latency of the
+//                      plugin is removed from the wav file
+//    17.10.2026  AWe   option -f, render with the firmware emulation
+//    17.10.2026  AWe   offline renderer for the headless Linux build:
+//                      plays a standard midi file through the plugin with a
+//                      patch from a .fxp file, writes a wav file and a log
+//                      of the midi output, reports the real-time factor
+//
+// --------------------------------------------------------------------------
+
+#include "audioeffectx.h"
+#include "MeeblipVST.h"
+#include "MeeblipVST_Oversampler.h"
+#include "aweThread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <vector>
+#include <algorithm>
+#include <string>
+
+extern "C" AEffect* VSTPluginMain( audioMasterCallback audioMaster);
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+#define DEFAULT_SAMPLE_RATE   44100.0f
+#define DEFAULT_BLOCK_SIZE    512
+#define DEFAULT_TAIL_SECONDS  2.0
+#define MAX_BLOCK_SIZE        65536
+
+static void usage()
+{
+   fprintf( stderr,
+      "usage: MeeblipRender [options] <in.mid> <patch.fxp | -> <out.wav>\n"
+      "   -r <rate>      sample rate, default %g\n"
+      "   -b <frames>    block size, default %d\n"
+      "   -t <seconds>   tail after the last midi event, default %g\n"
+      "   -m <file>      log of the midi output, default <out>_midi.txt\n"
+      "   -d             double precision processing\n"
+      "   -f             fixed point engine, 8/16 bit\n"
+      "   -o <factor>    oversampling 1, 2, 4 or 8, default 1\n"
+      "   -l <index>     midi learn, the first CC of the file is assigned to\n"
+      "                  the gui parameter\n"
+      "   -g <program>   request the sysex dump of program, -1 the bank\n"
+      "   -s <program>   send program as sysex dump, -1 the bank\n"
+      "   -16            write 16 bit pcm instead of 32 bit float\n",
+      DEFAULT_SAMPLE_RATE, DEFAULT_BLOCK_SIZE, DEFAULT_TAIL_SECONDS);
+}
+
+// --------------------------------------------------------------------------
+// file helpers
+// --------------------------------------------------------------------------
+
+static bool readFile( const char* path, std::vector<unsigned char>& data)
+{
+   FILE* file = fopen( path, "rb");
+   if( file == NULL)
+      return false;
+
+   unsigned char buffer[4096];
+   size_t n;
+   while( ( n = fread( buffer, 1, sizeof( buffer), file)) > 0)
+      data.insert( data.end(), buffer, buffer + n);
+
+   fclose( file);
+   return true;
+}
+
+static VstInt32 readBE32( const unsigned char* p)
+{
+   return (VstInt32)( ( (unsigned int)p[0] << 24) | ( (unsigned int)p[1] << 16) | ( (unsigned int)p[2] << 8) | p[3]);
+}
+
+static VstInt32 readBE16( const unsigned char* p)
+{
+   return ( p[0] << 8) | p[1];
+}
+
+static void writeLE32( FILE* file, unsigned int value)
+{
+   unsigned char b[4] = { (unsigned char)value, (unsigned char)( value >> 8), (unsigned char)( value >> 16), (unsigned char)( value >> 24) };
+   fwrite( b, 1, 4, file);
+}
+
+static void writeLE16( FILE* file, unsigned int value)
+{
+   unsigned char b[2] = { (unsigned char)value, (unsigned char)( value >> 8) };
+   fwrite( b, 1, 2, file);
+}
+
+// --------------------------------------------------------------------------
+// standard midi file, format 0 and 1
+// --------------------------------------------------------------------------
+
+struct MidiFileEvent
+{
+   long tick;
+   double time;                  // seconds
+   unsigned char data[3];
+};
+
+struct TempoChange
+{
+   long tick;
+   long usPerQuarter;
+};
+
+static bool lessTick( const MidiFileEvent& a, const MidiFileEvent& b)   { return a.tick < b.tick; }
+static bool lessTempo( const TempoChange& a, const TempoChange& b)      { return a.tick < b.tick; }
+
+static bool readVarLen( const unsigned char*& p, const unsigned char* end, unsigned long& value)
+{
+   value = 0;
+   for( int i = 0; i < 4; i++)
+   {
+      if( p >= end)
+         return false;
+
+      unsigned char c = *p++;
+      value = ( value << 7) | ( c & 0x7f);
+      if( ( c & 0x80) == 0)
+         return true;
+   }
+   return false;
+}
+
+// parse one MTrk chunk, channel messages go to events, tempo changes to tempos
+static bool parseTrack( const unsigned char* p, const unsigned char* end, std::vector<MidiFileEvent>& events, std::vector<TempoChange>& tempos, long& skipped)
+{
+   long tick = 0;
+   unsigned char runningStatus = 0;
+
+   while( p < end)
+   {
+      unsigned long delta;
+      if( !readVarLen( p, end, delta) || p >= end)
+         return false;
+      tick += delta;
+
+      unsigned char status = *p;
+      if( status & 0x80)
+         p++;
+      else if( runningStatus)
+         status = runningStatus;
+      else
+         return false;
+
+      if( status == 0xff)
+      {
+         // meta event
+         if( p >= end)
+            return false;
+         unsigned char type = *p++;
+         unsigned long length;
+         if( !readVarLen( p, end, length) || length > (unsigned long)( end - p))
+            return false;
+
+         if( type == 0x51 && length == 3)
+         {
+            TempoChange tempo;
+            tempo.tick = tick;
+            tempo.usPerQuarter = ( p[0] << 16) | ( p[1] << 8) | p[2];
+            tempos.push_back( tempo);
+         }
+         else if( type == 0x2f)
+            return true;            // end of track
+
+         p += length;
+      }
+      else if( status == 0xf0 || status == 0xf7)
+      {
+         // sysex is not played to the plugin
+         unsigned long length;
+         if( !readVarLen( p, end, length) || length > (unsigned long)( end - p))
+            return false;
+         p += length;
+         skipped++;
+         runningStatus = 0;
+      }
+      else if( status >= 0x80 && status < 0xf0)
+      {
+         VstInt32 dataBytes = ( status & 0xe0) == 0xc0 ? 1 : 2;
+         if( end - p < dataBytes)
+            return false;
+
+         MidiFileEvent event;
+         event.tick = tick;
+         event.time = 0.0;
+         event.data[0] = status;
+         event.data[1] = p[0] & 0x7f;
+         event.data[2] = dataBytes == 2 ? p[1] & 0x7f : 0;
+         events.push_back( event);
+
+         p += dataBytes;
+         runningStatus = status;
+      }
+      else
+         return false;              // system common/realtime in a file
+   }
+   return true;
+}
+
+static bool loadMidiFile( const char* path, std::vector<MidiFileEvent>& events)
+{
+   std::vector<unsigned char> data;
+   if( !readFile( path, data))
+   {
+      fprintf( stderr, "can't read %s\n", path);
+      return false;
+   }
+
+   if( data.size() < 14 || memcmp( &data[0], "MThd", 4) != 0)
+   {
+      fprintf( stderr, "%s is not a standard midi file\n", path);
+      return false;
+   }
+
+   const unsigned char* p = &data[0];
+   const unsigned char* end = p + data.size();
+
+   VstInt32 headerLength = readBE32( p + 4);
+   VstInt32 format       = readBE16( p + 8);
+   VstInt32 numTracks    = readBE16( p + 10);
+   VstInt32 division     = readBE16( p + 12);
+
+   if( format > 1)
+   {
+      fprintf( stderr, "%s: midi file format %d is not supported\n", path, format);
+      return false;
+   }
+
+   std::vector<TempoChange> tempos;
+   long skipped = 0;
+
+   p += 8 + headerLength;
+   for( VstInt32 track = 0; track < numTracks && end - p >= 8; track++)
+   {
+      VstInt32 length = readBE32( p + 4);
+      if( length < 0 || length > end - p - 8)
+      {
+         fprintf( stderr, "%s: truncated track %d\n", path, track);
+         return false;
+      }
+
+      if( memcmp( p, "MTrk", 4) == 0 && !parseTrack( p + 8, p + 8 + length, events, tempos, skipped))
+      {
+         fprintf( stderr, "%s: corrupt track %d\n", path, track);
+         return false;
+      }
+      p += 8 + length;
+   }
+
+   if( skipped)
+      fprintf( stderr, "%s: %ld sysex messages skipped\n", path, skipped);
+
+   // merge the tracks, keep the file order of simultaneous events
+   std::stable_sort( events.begin(), events.end(), lessTick);
+   std::stable_sort( tempos.begin(), tempos.end(), lessTempo);
+
+   if( division & 0x8000)
+   {
+      // smpte time code
+      double framesPerSecond = -(signed char)( division >> 8);
+      double ticksPerFrame = division & 0xff;
+      for( size_t i = 0; i < events.size(); i++)
+         events[i].time = events[i].tick / ( framesPerSecond * ticksPerFrame);
+   }
+   else
+   {
+      double ticksPerQuarter = division ? division : 96;
+      double secondsPerTick = 0.5 / ticksPerQuarter;       // 120 bpm
+      double timeBase = 0.0;
+      long tickBase = 0;
+      size_t tempo = 0;
+
+      for( size_t i = 0; i < events.size(); i++)
+      {
+         while( tempo < tempos.size() && tempos[ tempo].tick <= events[i].tick)
+         {
+            timeBase += ( tempos[ tempo].tick - tickBase) * secondsPerTick;
+            tickBase = tempos[ tempo].tick;
+            secondsPerTick = tempos[ tempo].usPerQuarter * 1.0e-6 / ticksPerQuarter;
+            tempo++;
+         }
+         events[i].time = timeBase + ( events[i].tick - tickBase) * secondsPerTick;
+      }
+   }
+   return true;
+}
+
+// --------------------------------------------------------------------------
+// fxp patch file
+// --------------------------------------------------------------------------
+
+static bool loadPatch( AEffect* effect, const char* path)
+{
+   std::vector<unsigned char> data;
+   if( !readFile( path, data))
+   {
+      fprintf( stderr, "can't read %s\n", path);
+      return false;
+   }
+
+   // fxProgram header: chunkMagic, byteSize, fxMagic, version, fxID,
+   // fxVersion, numParams, prgName[28], all values big endian
+   if( data.size() < 56 || memcmp( &data[0], "CcnK", 4) != 0)
+   {
+      fprintf( stderr, "%s is not a fxp file\n", path);
+      return false;
+   }
+
+   const unsigned char* p = &data[0];
+   VstInt32 fxID      = readBE32( p + 16);
+   VstInt32 numParams = readBE32( p + 24);
+
+   char name[29];
+   memcpy( name, p + 28, 28);
+   name[28] = 0;
+
+   if( fxID != effect->uniqueID)
+      fprintf( stderr, "%s: patch id %.4s differs from the plugin id\n", path, (const char*)p + 16);
+
+   if( memcmp( p + 8, "FxCk", 4) == 0)
+   {
+      if( numParams < 0 || data.size() < 56 + 4 * (size_t)numParams)
+      {
+         fprintf( stderr, "%s: truncated parameter list\n", path);
+         return false;
+      }
+
+      if( numParams > effect->numParams)
+         numParams = effect->numParams;
+
+      for( VstInt32 i = 0; i < numParams; i++)
+      {
+         VstInt32 bits = readBE32( p + 56 + 4 * i);
+         float value;
+         memcpy( &value, &bits, sizeof( value));
+         effect->setParameter( effect, i, value);
+      }
+   }
+   else if( memcmp( p + 8, "FPCh", 4) == 0)
+   {
+      VstInt32 chunkSize = data.size() >= 60 ? readBE32( p + 56) : -1;
+      if( chunkSize < 0 || data.size() < 60 + (size_t)chunkSize)
+      {
+         fprintf( stderr, "%s: truncated chunk\n", path);
+         return false;
+      }
+
+      if( effect->dispatcher( effect, effSetChunk, 1, chunkSize, (void*)( p + 60), 0) == 0)
+         fprintf( stderr, "%s: chunk not accepted by the plugin\n", path);
+   }
+   else
+   {
+      fprintf( stderr, "%s: only single programs (FxCk, FPCh) are supported\n", path);
+      return false;
+   }
+
+   effect->dispatcher( effect, effSetProgramName, 0, 0, name, 0);
+   printf( "patch     %s \"%s\"\n", path, name);
+   return true;
+}
+
+// --------------------------------------------------------------------------
+// host
+// --------------------------------------------------------------------------
+
+struct RenderHost
+{
+   float sampleRate;
+   VstInt32 blockSize;
+   VstInt32 blockStart;          // sample position of the current block
+   FILE* midiLog;
+   long midiOut;
+};
+
+static RenderHost host;
+
+static void logEvents( VstEvents* events)
+{
+   for( VstInt32 i = 0; i < events->numEvents; i++)
+   {
+      VstEvent* event = events->events[i];
+      VstInt32 frame = host.blockStart + event->deltaFrames;
+
+      if( host.midiLog)
+         fprintf( host.midiLog, "%10d %12.6f  ", frame, frame / host.sampleRate);
+
+      if( event->type == kVstMidiType)
+      {
+         VstMidiEvent* midiEvent = (VstMidiEvent*)event;
+         if( host.midiLog)
+            fprintf( host.midiLog, "%02X %02X %02X\n", midiEvent->midiData[0] & 0xff, midiEvent->midiData[1] & 0xff, midiEvent->midiData[2] & 0xff);
+      }
+      else if( event->type == kVstSysExType)
+      {
+         VstMidiSysexEvent* sysexEvent = (VstMidiSysexEvent*)event;
+         if( host.midiLog)
+         {
+            for( VstInt32 j = 0; j < sysexEvent->dumpBytes; j++)
+               fprintf( host.midiLog, "%02X ", sysexEvent->sysexDump[j] & 0xff);
+            fprintf( host.midiLog, "(%d bytes)\n", sysexEvent->dumpBytes);
+         }
+      }
+      host.midiOut++;
+   }
+}
+
+static VstIntPtr VSTCALLBACK hostCallback( AEffect* effect, VstInt32 opcode, VstInt32 index, VstIntPtr value, void* ptr, float opt)
+{
+   switch( opcode)
+   {
+      case audioMasterVersion:                return kVstVersion;
+      case audioMasterGetSampleRate:          return (VstIntPtr)host.sampleRate;
+      case audioMasterGetBlockSize:           return host.blockSize;
+      case audioMasterGetCurrentProcessLevel: return kVstProcessLevelOffline;
+      case audioMasterProcessEvents:          logEvents( (VstEvents*)ptr); return 1;
+   }
+   return 0;
+}
+
+// --------------------------------------------------------------------------
+// wav file, stereo, 32 bit float or 16 bit pcm
+// --------------------------------------------------------------------------
+
+static void writeWavHeader( FILE* file, float sampleRate, bool pcm16, unsigned int frames)
+{
+   unsigned int bytesPerSample = pcm16 ? 2 : 4;
+   unsigned int dataBytes = frames * 2 * bytesPerSample;
+
+   fwrite( "RIFF", 1, 4, file);
+   writeLE32( file, 36 + dataBytes);
+   fwrite( "WAVEfmt ", 1, 8, file);
+   writeLE32( file, 16);
+   writeLE16( file, pcm16 ? 1 : 3);                          // pcm / ieee float
+   writeLE16( file, 2);
+   writeLE32( file, (unsigned int)sampleRate);
+   writeLE32( file, (unsigned int)sampleRate * 2 * bytesPerSample);
+   writeLE16( file, 2 * bytesPerSample);
+   writeLE16( file, 8 * bytesPerSample);
+   fwrite( "data", 1, 4, file);
+   writeLE32( file, dataBytes);
+}
+
+static void writeWavFrames( FILE* file, bool pcm16, const float* left, const float* right, VstInt32 frames)
+{
+   for( VstInt32 i = 0; i < frames; i++)
+   {
+      float sample[2] = { left[i], right[i] };
+      for( int c = 0; c < 2; c++)
+      {
+         if( pcm16)
+         {
+            float s = sample[c] * 32767.0f;
+            s = s > 32767.0f ? 32767.0f : ( s < -32768.0f ? -32768.0f : s);
+            writeLE16( file, (unsigned int)(int)floorf( s + 0.5f) & 0xffff);
+         }
+         else
+         {
+            unsigned int bits;
+            memcpy( &bits, &sample[c], sizeof( bits));
+            writeLE32( file, bits);
+         }
+      }
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+int main( int argc, char* argv[])
+{
+   const char* args[3];
+   int numArgs = 0;
+
+   host.sampleRate = DEFAULT_SAMPLE_RATE;
+   host.blockSize  = DEFAULT_BLOCK_SIZE;
+   host.blockStart = 0;
+   host.midiLog    = NULL;
+   host.midiOut    = 0;
+
+   double tail = DEFAULT_TAIL_SECONDS;
+   const char* midiLogPath = NULL;
+   bool doublePrecision = false;
+   bool pcm16 = false;
+   bool fixedPoint = false;
+   int oversampling = 1;
+   int learn = -1;
+   int request = -2;             // -1 is the bank
+   int send = -2;
+
+   for( int i = 1; i < argc; i++)
+   {
+      if( strcmp( argv[i], "-r") == 0 && i + 1 < argc)
+         host.sampleRate = (float)atof( argv[++i]);
+      else if( strcmp( argv[i], "-b") == 0 && i + 1 < argc)
+         host.blockSize = atoi( argv[++i]);
+      else if( strcmp( argv[i], "-t") == 0 && i + 1 < argc)
+         tail = atof( argv[++i]);
+      else if( strcmp( argv[i], "-m") == 0 && i + 1 < argc)
+         midiLogPath = argv[++i];
+      else if( strcmp( argv[i], "-d") == 0)
+         doublePrecision = true;
+      else if( strcmp( argv[i], "-o") == 0 && i + 1 < argc)
+         oversampling = atoi( argv[++i]);
+      else if( strcmp( argv[i], "-l") == 0 && i + 1 < argc)
+         learn = atoi( argv[++i]);
+      else if( strcmp( argv[i], "-g") == 0 && i + 1 < argc)
+         request = atoi( argv[++i]);
+      else if( strcmp( argv[i], "-s") == 0 && i + 1 < argc)
+         send = atoi( argv[++i]);
+      else if( strcmp( argv[i], "-f") == 0)
+         fixedPoint = true;
+      else if( strcmp( argv[i], "-16") == 0)
+         pcm16 = true;
+      else if( argv[i][0] == '-' && argv[i][1] != 0)
+      {
+         usage();
+         return 1;
+      }
+      else if( numArgs < 3)
+         args[ numArgs++] = argv[i];
+   }
+
+   if( numArgs != 3 || host.sampleRate < 8000.0f || host.blockSize < 1 || host.blockSize > MAX_BLOCK_SIZE || tail < 0.0
+    || ( oversampling != 1 && oversampling != 2 && oversampling != 4 && oversampling != 8)
+    || learn >= kNumGuiParameters || request >= kNumPrograms || send >= kNumPrograms)
+   {
+      usage();
+      return 1;
+   }
+
+   std::vector<MidiFileEvent> midiEvents;
+   if( !loadMidiFile( args[0], midiEvents))
+      return 1;
+
+   std::string logPath;
+   if( midiLogPath)
+      logPath = midiLogPath;
+   else
+   {
+      logPath = args[2];
+      if( logPath.size() > 4 && logPath.compare( logPath.size() - 4, 4, ".wav") == 0)
+         logPath.erase( logPath.size() - 4);
+      logPath += "_midi.txt";
+   }
+
+   FILE* wav = fopen( args[2], "wb");
+   host.midiLog = fopen( logPath.c_str(), "w");
+   if( wav == NULL || host.midiLog == NULL)
+   {
+      fprintf( stderr, "can't create %s\n", wav == NULL ? args[2] : logPath.c_str());
+      return 1;
+   }
+
+   // open the plugin like a host does
+
+   AEffect* effect = VSTPluginMain( hostCallback);
+   if( effect == NULL)
+   {
+      fprintf( stderr, "can't create the plugin\n");
+      return 1;
+   }
+
+   if( doublePrecision && ( effect->flags & effFlagsCanDoubleReplacing) == 0)
+   {
+      fprintf( stderr, "the plugin doesn't support double precision\n");
+      doublePrecision = false;
+   }
+
+   effect->dispatcher( effect, effOpen, 0, 0, NULL, 0);
+   effect->dispatcher( effect, effSetSampleRate, 0, 0, NULL, host.sampleRate);
+   effect->dispatcher( effect, effSetBlockSize, 0, host.blockSize, NULL, 0);
+   effect->dispatcher( effect, effSetProcessPrecision, 0, doublePrecision ? kVstProcessPrecision64 : kVstProcessPrecision32, NULL, 0);
+
+   if( strcmp( args[1], "-") != 0 && !loadPatch( effect, args[1]))
+      return 1;
+
+   if( fixedPoint)
+      effect->setParameter( effect, kEngineMode, 1.0f);
+
+   // the renderer reports the offline process level, the factor is
+   // applied when the plugin is resumed
+   int os = oversampling == 8 ? 3 : oversampling == 4 ? 2 : oversampling == 2 ? 1 : 0;
+   effect->setParameter( effect, kOfflineOversampling, os / float( kNumOversampleFactors - 1));
+
+   if( learn >= 0)
+      effect->dispatcher( effect, effVendorSpecific, PLUG_VENDOR_LEARN, learn, NULL, 0);
+
+   // the messages go out paced with the CCs, they are in the midi log
+   if( request >= -1)
+      effect->dispatcher( effect, effVendorSpecific, PLUG_VENDOR_REQUEST, request, NULL, 0);
+   if( send >= -1)
+      effect->dispatcher( effect, effVendorSpecific, PLUG_VENDOR_SEND, send, NULL, 0);
+
+   effect->dispatcher( effect, effMainsChanged, 0, 1, NULL, 0);
+   effect->dispatcher( effect, effStartProcess, 0, 0, NULL, 0);
+
+   // buffers, allocated before rendering
+
+   VstInt32 blockSize = host.blockSize;
+   std::vector<float>  floatBuffer( 4 * blockSize, 0.0f);
+   std::vector<double> doubleBuffer( doublePrecision ? 4 * blockSize : 0, 0.0);
+
+   float* floatInputs[2]   = { &floatBuffer[0], &floatBuffer[ blockSize] };
+   float* floatOutputs[2]  = { &floatBuffer[ 2 * blockSize], &floatBuffer[ 3 * blockSize] };
+   double* doubleInputs[2]  = { NULL, NULL };
+   double* doubleOutputs[2] = { NULL, NULL };
+   if( doublePrecision)
+   {
+      doubleInputs[0]  = &doubleBuffer[0];
+      doubleInputs[1]  = &doubleBuffer[ blockSize];
+      doubleOutputs[0] = &doubleBuffer[ 2 * blockSize];
+      doubleOutputs[1] = &doubleBuffer[ 3 * blockSize];
+   }
+
+   std::vector<VstMidiEvent> blockEvents( midiEvents.size() + 1);
+   std::vector<char> eventsMemory( sizeof( VstEvents) + blockEvents.size() * sizeof( VstEvent*));
+   VstEvents* vstEvents = (VstEvents*)&eventsMemory[0];
+
+   double lastTime = midiEvents.empty() ? 0.0 : midiEvents.back().time;
+   unsigned int totalFrames = (unsigned int)ceil( ( lastTime + tail) * host.sampleRate);
+
+   writeWavHeader( wav, host.sampleRate, pcm16, totalFrames);
+
+   // like the delay compensation of a host, the first samples are dropped
+   unsigned int delay = effect->initialDelay > 0 ? effect->initialDelay : 0;
+
+   // render
+
+   size_t nextEvent = 0;
+   double processTime = 0.0;
+   double peak = 0.0;
+
+   for( unsigned int position = 0; position < totalFrames + delay; position += blockSize)
+   {
+      VstInt32 frames = totalFrames + delay - position < (unsigned int)blockSize ? totalFrames + delay - position : blockSize;
+      host.blockStart = position;
+
+      VstInt32 numEvents = 0;
+      while( nextEvent < midiEvents.size())
+      {
+         double frame = floor( midiEvents[ nextEvent].time * host.sampleRate + 0.5);
+         if( frame >= position + frames)
+            break;
+
+         VstMidiEvent& event = blockEvents[ numEvents];
+         memset( &event, 0, sizeof( event));
+         event.type        = kVstMidiType;
+         event.byteSize    = sizeof( VstMidiEvent);
+         event.deltaFrames = (VstInt32)frame - position;
+         event.midiData[0] = midiEvents[ nextEvent].data[0];
+         event.midiData[1] = midiEvents[ nextEvent].data[1];
+         event.midiData[2] = midiEvents[ nextEvent].data[2];
+         vstEvents->events[ numEvents] = (VstEvent*)&event;
+
+         numEvents++;
+         nextEvent++;
+      }
+
+      double start = aweGetTime();
+
+      if( numEvents)
+      {
+         vstEvents->numEvents = numEvents;
+         vstEvents->reserved = 0;
+         effect->dispatcher( effect, effProcessEvents, 0, 0, vstEvents, 0);
+      }
+
+      if( doublePrecision)
+      {
+         effect->processDoubleReplacing( effect, doubleInputs, doubleOutputs, frames);
+         processTime += aweGetTime() - start;
+
+         for( VstInt32 i = 0; i < frames; i++)
+         {
+            floatOutputs[0][i] = (float)doubleOutputs[0][i];
+            floatOutputs[1][i] = (float)doubleOutputs[1][i];
+         }
+      }
+      else
+      {
+         effect->processReplacing( effect, floatInputs, floatOutputs, frames);
+         processTime += aweGetTime() - start;
+      }
+
+      VstInt32 skip = 0;
+      if( position < delay)
+         skip = delay - position < (unsigned int)frames ? delay - position : frames;
+
+      for( VstInt32 i = skip; i < frames; i++)
+      {
+         peak = std::max( peak, (double)fabsf( floatOutputs[0][i]));
+         peak = std::max( peak, (double)fabsf( floatOutputs[1][i]));
+      }
+
+      writeWavFrames( wav, pcm16, floatOutputs[0] + skip, floatOutputs[1] + skip, frames - skip);
+   }
+
+   effect->dispatcher( effect, effStopProcess, 0, 0, NULL, 0);
+   effect->dispatcher( effect, effMainsChanged, 0, 0, NULL, 0);
+   effect->dispatcher( effect, effClose, 0, 0, NULL, 0);
+
+   bool ok = ferror( wav) == 0 && ferror( host.midiLog) == 0;
+   fclose( wav);
+   fclose( host.midiLog);
+
+   // report
+
+   double seconds = totalFrames / host.sampleRate;
+   printf( "midi in   %s, %u events\n", args[0], (unsigned int)midiEvents.size());
+   printf( "midi out  %s, %ld events\n", logPath.c_str(), host.midiOut);
+   printf( "wav       %s, %.3f s, %g Hz, %s, peak %.2f dBFS\n", args[2], seconds, host.sampleRate, pcm16 ? "16 bit" : "32 bit float",
+           peak > 0.0 ? 20.0 * log10( peak) : -999.0);
+   printf( "process   %.3f s, block size %d, %s precision\n", processTime, blockSize, doublePrecision ? "double" : "single");
+   printf( "latency   %u samples removed, %dx oversampling\n", delay, oversampling);
+   printf( "real-time factor %.1f\n", processTime > 0.0 ? seconds / processTime : 0.0);
+
+   if( !ok)
+   {
+      fprintf( stderr, "write error\n");
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,295 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipSysexTest.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   encode/decode of the dumps, the receiver with split
+//                      messages, realtime bytes, checksum errors, overflow
+//                      and the pass thru of the plugin
+//
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+#define TEST_BLOCK_SIZE   64
+
+static int failures = 0;
+
+static void check( bool ok, const char* what)
+{
+   printf( "%-56s %s\n", what, ok ? "ok" : "FAILED");
+   failures += ok ? 0 : 1;
+}
+
+static void makeDump( MeeblipVST_SysexDump& dump, VstInt32 program)
+{
+   memset( &dump, 0, sizeof( dump));
+   dump.program = program;
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+      dump.values[i] = (unsigned char)( ( i * 37 + program) & 0x7f);
+   strcpy( dump.name, "Sysex Test");
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the bytes a receiver passes thru and the dumps it collects, the events
+// are parts of one stream
+
+struct ReceiveResult
+{
+   VstInt32 dumps;
+   MeeblipVST_SysexDump dump;         // the last one
+   unsigned char passed[ 2 * kSysexMaxMessage];
+   VstInt32 passedBytes;
+   VstInt32 ownedEvents;
+};
+
+static void receiveEvent( MeeblipVST_SysexReceiver& receiver, const unsigned char* data, VstInt32 size, ReceiveResult& result)
+{
+   VstInt32 pos = 0;
+
+   receiver.beginEvent();
+   while( receiver.receive( data, size, pos, result.dump))
+      result.dumps++;
+
+   const unsigned char* held;
+   VstInt32 heldBytes = receiver.getReleased( held);
+   memcpy( result.passed + result.passedBytes, held, heldBytes);
+   result.passedBytes += heldBytes;
+
+   if( receiver.ownsEvent())
+      result.ownedEvents++;
+   else
+   {
+      memcpy( result.passed + result.passedBytes, data, size);
+      result.passedBytes += size;
+   }
+}
+
+static void receiveSplit( const unsigned char* data, VstInt32 size, VstInt32 split, ReceiveResult& result)
+{
+   MeeblipVST_SysexReceiver receiver;
+
+   memset( &result, 0, sizeof( result));
+   receiveEvent( receiver, data, split, result);
+   receiveEvent( receiver, data + split, size - split, result);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static void testEncode()
+{
+   MeeblipVST_SysexDump dump;
+   MeeblipVST_SysexDump decoded;
+   unsigned char data[ kSysexMaxMessage];
+
+   makeDump( dump, 5);
+   VstInt32 size = sysexEncodeDump( data, dump);
+   check( size == kSysexDumpSize && size == sysexMessageSize( kSysexProgramDump), "encode: size of a dump");
+   check( data[0] == kSysexStart && data[ size - 1] == kSysexEnd, "encode: F0 .. F7");
+
+   memset( &decoded, 0, sizeof( decoded));
+   check( sysexDecodeDump( data, size, decoded)
+       && decoded.program == 5
+       && memcmp( decoded.values, dump.values, kNumGuiParameters) == 0
+       && strcmp( decoded.name, dump.name) == 0, "decode: round trip");
+
+   data[ kSysexHeaderSize + 3] ^= 1;
+   check( !sysexDecodeDump( data, size, decoded), "decode: wrong checksum");
+   check( !sysexDecodeDump( data, size - 1, decoded), "decode: cut off");
+
+   size = sysexEncodeRequest( data, kSysexRequestProgram, 9);
+   check( size == kSysexRequestSize && size == sysexMessageSize( kSysexRequestProgram)
+       && data[5] == kSysexRequestProgram && data[6] == 9 && data[7] == kSysexEnd, "encode: request");
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static void testReceiver()
+{
+   MeeblipVST_SysexDump dump;
+   unsigned char data[ kSysexMaxMessage + 8];
+   ReceiveResult result;
+
+   makeDump( dump, 17);
+   VstInt32 size = sysexEncodeDump( data, dump);
+
+   // a dump split after every byte is received and nothing is passed thru
+   bool split = true;
+   for( VstInt32 i = 1; i < size; i++)
+   {
+      receiveSplit( data, size, i, result);
+      split = split && result.dumps == 1 && result.dump.program == 17
+           && result.passedBytes == 0 && result.ownedEvents == 2;
+   }
+   check( split, "receiver: dump split after every byte");
+
+   // another message split within its first 6 bytes is passed thru whole
+   unsigned char foreign[] = { 0xf0, 0x7d, 0x4d, 0x42, 0x01, 0x10, 0x01, 0xf7 };
+   bool passed = true;
+   for( VstInt32 i = 1; i < (VstInt32)sizeof( foreign); i++)
+   {
+      receiveSplit( foreign, sizeof( foreign), i, result);
+      passed = passed && result.dumps == 0 && result.passedBytes == (VstInt32)sizeof( foreign)
+            && memcmp( result.passed, foreign, sizeof( foreign)) == 0;
+   }
+   check( passed, "receiver: other message split in its header");
+
+   // a request isn't a dump
+   VstInt32 requestSize = sysexEncodeRequest( foreign, kSysexRequestBank, 0);
+   receiveSplit( foreign, requestSize, 3, result);
+   check( result.dumps == 0 && result.passedBytes == requestSize && memcmp( result.passed, foreign, requestSize) == 0,
+          "receiver: request is passed thru");
+
+   // realtime bytes within the header and the data
+   unsigned char timed[ kSysexMaxMessage + 8];
+   VstInt32 timedSize = 0;
+   for( VstInt32 i = 0; i < size; i++)
+   {
+      if( i == 3 || i == 20)
+         timed[ timedSize++] = 0xf8;
+      timed[ timedSize++] = data[i];
+   }
+   receiveSplit( timed, timedSize, 4, result);
+   check( result.dumps == 1 && result.passedBytes == 0, "receiver: realtime bytes are skipped");
+
+   // a wrong checksum is an error, the dump is not passed thru
+   MeeblipVST_SysexReceiver receiver;
+   data[ kSysexHeaderSize] ^= 1;
+   memset( &result, 0, sizeof( result));
+   receiveEvent( receiver, data, size, result);
+   check( result.dumps == 0 && receiver.getErrors() == 1 && result.passedBytes == 0,
+          "receiver: wrong checksum");
+   data[ kSysexHeaderSize] ^= 1;
+
+   // a dump with one data byte too many
+   memcpy( timed, data, size - 1);
+   timed[ size - 1] = 0;
+   timed[ size] = kSysexEnd;
+   receiver.reset();
+   memset( &result, 0, sizeof( result));
+   receiveEvent( receiver, timed, size + 1, result);
+   check( result.dumps == 0 && receiver.getErrors() >= 1, "receiver: overflow");
+
+   // the receiver is ready for the next dump
+   receiveEvent( receiver, data, size, result);
+   check( result.dumps == 1 && receiver.getReceived() == 1, "receiver: dump after an overflow");
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static unsigned char hostSysex[ 2 * kSysexMaxMessage];
+static VstInt32 hostSysexBytes = 0;
+
+static VstIntPtr VSTCALLBACK hostCallback( AEffect* effect, VstInt32 opcode, VstInt32 index, VstIntPtr value, void* ptr, float opt)
+{
+   if( opcode == audioMasterProcessEvents)
+   {
+      VstEvents* events = (VstEvents*)ptr;
+      for( VstInt32 i = 0; i < events->numEvents; i++)
+      {
+         VstMidiSysexEvent* event = (VstMidiSysexEvent*)events->events[i];
+         if( event->type == kVstSysExType && hostSysexBytes + event->dumpBytes <= (VstInt32)sizeof( hostSysex))
+         {
+            memcpy( hostSysex + hostSysexBytes, event->sysexDump, event->dumpBytes);
+            hostSysexBytes += event->dumpBytes;
+         }
+      }
+      return 1;
+   }
+   return opcode == audioMasterVersion ? kVstVersion : 0;
+}
+
+static void sendSysex( MeeblipVST* plugin, const unsigned char* data, VstInt32 size)
+{
+   float zero[ TEST_BLOCK_SIZE];
+   float left[ TEST_BLOCK_SIZE];
+   float right[ TEST_BLOCK_SIZE];
+   float* inputs[ 2]  = { zero, zero };
+   float* outputs[ 2] = { left, right };
+   memset( zero, 0, sizeof( zero));
+
+   VstMidiSysexEvent event;
+   memset( &event, 0, sizeof( event));
+   event.type      = kVstSysExType;
+   event.byteSize  = sizeof( event);
+   event.dumpBytes = size;
+   event.sysexDump = (char*)data;
+
+   struct
+   {
+      VstInt32 numEvents;
+      VstIntPtr reserved;
+      VstEvent* events[ 2];
+   } list = { 1, 0, { (VstEvent*)&event, NULL } };
+
+   plugin->processEvents( (VstEvents*)&list);
+   plugin->processReplacing( inputs, outputs, TEST_BLOCK_SIZE);
+}
+
+// a message split over two blocks reaches the host in one piece, a dump
+// doesn't reach it
+
+static void testPassThru()
+{
+   MeeblipVST* plugin = new MeeblipVST( hostCallback);
+   plugin->setSampleRate( 44100.0f);
+   plugin->setBlockSize( TEST_BLOCK_SIZE);
+   plugin->resume();
+
+   unsigned char foreign[] = { 0xf0, 0x7d, 0x4d, 0x00, 0x01, 0x02, 0xf7 };
+   hostSysexBytes = 0;
+   sendSysex( plugin, foreign, 3);
+   check( hostSysexBytes == 0, "plugin: undecided header is held");
+   sendSysex( plugin, foreign + 3, sizeof( foreign) - 3);
+   check( hostSysexBytes == (VstInt32)sizeof( foreign) && memcmp( hostSysex, foreign, sizeof( foreign)) == 0,
+          "plugin: other message is passed thru");
+
+   MeeblipVST_SysexDump dump;
+   unsigned char data[ kSysexMaxMessage];
+   makeDump( dump, 2);
+   VstInt32 size = sysexEncodeDump( data, dump);
+
+   hostSysexBytes = 0;
+   sendSysex( plugin, data, 2);
+   sendSysex( plugin, data + 2, size - 2);
+   check( hostSysexBytes == 0 && strcmp( plugin->getPrograms().getName( 2), dump.name) == 0,
+          "plugin: split dump is stored, not passed thru");
+
+   delete plugin;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+int main()
+{
+   testEncode();
+   testReceiver();
+   testPassThru();
+
+   printf( failures ? "FAILED\n" : "passed\n");
+   return failures ? 1 : 0;
+}
@@ -0,0 +1,121 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipTimingTest.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   onset of a note-on at its deltaFrames, with single
+//                      frame and with stretched sub-blocks
+//
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+#define TEST_BLOCK_SIZE   256
+
+static int failures = 0;
+
+static void check( bool ok, const char* what)
+{
+   printf( "%-56s %s\n", what, ok ? "ok" : "FAILED");
+   failures += ok ? 0 : 1;
+}
+
+static VstIntPtr VSTCALLBACK hostCallback( AEffect* effect, VstInt32 opcode, VstInt32 index, VstIntPtr value, void* ptr, float opt)
+{
+   return opcode == audioMasterVersion ? kVstVersion : 0;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// renders one block with a note-on at deltaFrames, returns the first frame
+// which is not silent or -1
+
+static VstInt32 renderOnset( VstInt32 minSubBlock, VstInt32 deltaFrames)
+{
+   MeeblipVST* plugin = new MeeblipVST( hostCallback);
+   plugin->setSampleRate( 44100.0f);
+   plugin->setBlockSize( TEST_BLOCK_SIZE);
+   plugin->setMidiOutRate( 0.0f);
+   plugin->setMinSubBlock( minSubBlock);
+   plugin->resume();
+
+   float zero[ TEST_BLOCK_SIZE];
+   float left[ TEST_BLOCK_SIZE];
+   float right[ TEST_BLOCK_SIZE];
+   float* inputs[ 2]  = { zero, zero };
+   float* outputs[ 2] = { left, right };
+   memset( zero, 0, sizeof( zero));
+
+   VstMidiEvent event;
+   memset( &event, 0, sizeof( event));
+   event.type        = kVstMidiType;
+   event.byteSize    = sizeof( event);
+   event.deltaFrames = deltaFrames;
+   event.midiData[0] = (char)0x90;
+   event.midiData[1] = 60;
+   event.midiData[2] = 100;
+
+   struct
+   {
+      VstInt32 numEvents;
+      VstIntPtr reserved;
+      VstEvent* events[ 2];
+   } list = { 1, 0, { (VstEvent*)&event, NULL } };
+
+   plugin->processEvents( (VstEvents*)&list);
+   plugin->processReplacing( inputs, outputs, TEST_BLOCK_SIZE);
+   delete plugin;
+
+   for( VstInt32 i = 0; i < TEST_BLOCK_SIZE; i++)
+   {
+      if( left[i] != 0.0f || right[i] != 0.0f)
+         return i;
+   }
+   return -1;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+int main()
+{
+   char what[ 64];
+
+   // the voice may start with a silent frame, the onsets are compared to
+   // the one of a note at frame 0
+   VstInt32 first = renderOnset( 1, 0);
+   check( first >= 0 && first < 16, "note at frame 0 is heard");
+
+   static const VstInt32 deltas[] = { 1, 31, 40, 100, 200 };
+   for( size_t i = 0; i < sizeof( deltas) / sizeof( deltas[0]); i++)
+   {
+      VstInt32 delta = deltas[i];
+
+      sprintf( what, "minSubBlock 1: note at frame %d", delta);
+      check( renderOnset( 1, delta) == delta + first, what);
+
+      // within the first 32 frames the note starts with the first
+      // sub-block, never later, behind them the sub-block ends at it
+      sprintf( what, "minSubBlock 32: note at frame %d", delta);
+      check( renderOnset( 32, delta) == ( delta < 32 ? 0 : delta) + first, what);
+   }
+
+   printf( failures ? "FAILED\n" : "passed\n");
+   return failures ? 1 : 0;
+}
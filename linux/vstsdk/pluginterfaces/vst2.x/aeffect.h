@@ -0,0 +1,165 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        aeffect.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   minimal stand-in for the VST 2.4 plugin interface,
+//                      only the parts used by MeeblipVST are declared.
+//                      Used for the headless Linux build, never shipped.
+//
+// --------------------------------------------------------------------------
+
+#ifndef __aeffect__
+#define __aeffect__
+
+#include <stdint.h>
+
+// --------------------------------------------------------------------------
+// Integral types
+// --------------------------------------------------------------------------
+
+typedef int32_t  VstInt32;
+typedef intptr_t VstIntPtr;
+typedef int16_t  VstInt16;
+typedef int64_t  VstInt64;
+
+#define VSTCALLBACK
+#define CCONST(a, b, c, d) \
+   ((((VstInt32)a) << 24) | (((VstInt32)b) << 16) | (((VstInt32)c) << 8) | (((VstInt32)d) << 0))
+
+#define kEffectMagic CCONST ('V', 's', 't', 'P')
+#define kVstVersion 2400
+
+struct AEffect;
+
+typedef VstIntPtr (VSTCALLBACK *audioMasterCallback)( AEffect* effect, VstInt32 opcode, VstInt32 index, VstIntPtr value, void* ptr, float opt);
+typedef VstIntPtr (VSTCALLBACK *AEffectDispatcherProc)( AEffect* effect, VstInt32 opcode, VstInt32 index, VstIntPtr value, void* ptr, float opt);
+typedef void (VSTCALLBACK *AEffectProcessProc)( AEffect* effect, float** inputs, float** outputs, VstInt32 sampleFrames);
+typedef void (VSTCALLBACK *AEffectProcessDoubleProc)( AEffect* effect, double** inputs, double** outputs, VstInt32 sampleFrames);
+typedef void (VSTCALLBACK *AEffectSetParameterProc)( AEffect* effect, VstInt32 index, float parameter);
+typedef float (VSTCALLBACK *AEffectGetParameterProc)( AEffect* effect, VstInt32 index);
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+struct AEffect
+{
+   VstInt32 magic;
+   AEffectDispatcherProc dispatcher;
+   AEffectProcessProc DECLARE_VST_DEPRECATED_process;
+   AEffectSetParameterProc setParameter;
+   AEffectGetParameterProc getParameter;
+
+   VstInt32 numPrograms;
+   VstInt32 numParams;
+   VstInt32 numInputs;
+   VstInt32 numOutputs;
+
+   VstInt32 flags;
+
+   VstIntPtr resvd1;
+   VstIntPtr resvd2;
+
+   VstInt32 initialDelay;
+
+   VstInt32 DECLARE_VST_DEPRECATED_realQualities;
+   VstInt32 DECLARE_VST_DEPRECATED_offQualities;
+   float    DECLARE_VST_DEPRECATED_ioRatio;
+
+   void* object;
+   void* user;
+
+   VstInt32 uniqueID;
+   VstInt32 version;
+
+   AEffectProcessProc processReplacing;
+   AEffectProcessDoubleProc processDoubleReplacing;
+
+   char future[56];
+};
+
+enum VstAEffectFlags
+{
+   effFlagsHasEditor          = 1 << 0,
+   effFlagsCanReplacing       = 1 << 4,
+   effFlagsProgramChunks      = 1 << 5,
+   effFlagsIsSynth            = 1 << 8,
+   effFlagsNoSoundInStop      = 1 << 9,
+   effFlagsCanDoubleReplacing = 1 << 12
+};
+
+enum AudioMasterOpcodes
+{
+   audioMasterAutomate = 0,
+   audioMasterVersion,
+   audioMasterCurrentId,
+   audioMasterIdle
+};
+
+enum AEffectOpcodes
+{
+   effOpen = 0,
+   effClose,
+   effSetProgram,
+   effGetProgram,
+   effSetProgramName,
+   effGetProgramName,
+   effGetParamLabel,
+   effGetParamDisplay,
+   effGetParamName,
+   DECLARE_VST_DEPRECATED_effGetVu,
+   effSetSampleRate,
+   effSetBlockSize,
+   effMainsChanged,
+   effEditGetRect,
+   effEditOpen,
+   effEditClose,
+   DECLARE_VST_DEPRECATED_effEditDraw,
+   DECLARE_VST_DEPRECATED_effEditMouse,
+   DECLARE_VST_DEPRECATED_effEditKey,
+   effEditIdle,
+   DECLARE_VST_DEPRECATED_effEditTop,
+   DECLARE_VST_DEPRECATED_effEditSleep,
+   DECLARE_VST_DEPRECATED_effIdentify,
+   effGetChunk,
+   effSetChunk,
+   effNumOpcodes
+};
+
+enum VstStringConstants
+{
+   kVstMaxProgNameLen   = 24,
+   kVstMaxParamStrLen   = 8,
+   kVstMaxVendorStrLen  = 64,
+   kVstMaxProductStrLen = 64,
+   kVstMaxEffectNameLen = 32
+};
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+#include <string.h>
+
+inline char* vst_strncpy( char* dst, const char* src, VstInt32 maxLen)
+{
+   char* result = strncpy( dst, src, maxLen);
+   dst[maxLen] = 0;
+   return result;
+}
+
+inline char* vst_strncat( char* dst, const char* src, VstInt32 maxLen)
+{
+   char* result = strncat( dst, src, maxLen);
+   dst[maxLen] = 0;
+   return result;
+}
+
+#endif // __aeffect__
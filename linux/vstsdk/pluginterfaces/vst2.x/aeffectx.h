@@ -0,0 +1,207 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        aeffectx.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   add effGetParameterProperties, VstParameterProperties
+//    17.10.2026  AWe   add effVendorSpecific
+//    17.10.2026  AWe   minimal stand-in for the VST 2.4 extended plugin
+//                      interface (events, pins, process levels).
+//                      Used for the headless Linux build, never shipped.
+//
+// --------------------------------------------------------------------------
+
+#ifndef __aeffectx__
+#define __aeffectx__
+
+#include "aeffect.h"
+
+// --------------------------------------------------------------------------
+// opcodes, values are the ones of the VST 2.4 SDK
+// --------------------------------------------------------------------------
+
+enum AudioMasterOpcodesX
+{
+   audioMasterGetTime                = 7,
+   audioMasterProcessEvents          = 8,
+   audioMasterIOChanged              = 13,
+   audioMasterGetSampleRate          = 16,
+   audioMasterGetBlockSize           = 17,
+   audioMasterGetCurrentProcessLevel = 23,
+   audioMasterGetVendorString        = 32,
+   audioMasterGetProductString       = 33,
+   audioMasterGetVendorVersion       = 34,
+   audioMasterCanDo                  = 37,
+   audioMasterUpdateDisplay          = 42,
+   audioMasterBeginEdit              = 43,
+   audioMasterEndEdit                = 44
+};
+
+enum AEffectXOpcodes
+{
+   effProcessEvents            = effSetChunk + 1,   // 25
+   effGetProgramNameIndexed    = 29,
+   effGetInputProperties       = 33,
+   effGetOutputProperties      = 34,
+   effGetEffectName            = 45,
+   effGetVendorString          = 47,
+   effGetProductString         = 48,
+   effGetVendorVersion         = 49,
+   effVendorSpecific           = 50,
+   effCanDo                    = 51,
+   effGetTailSize              = 52,
+   effGetParameterProperties   = 56,
+   effGetVstVersion            = 58,
+   effStartProcess             = 71,
+   effStopProcess              = 72,
+   effSetProcessPrecision      = 77,
+   effGetNumMidiInputChannels  = 78,
+   effGetNumMidiOutputChannels = 79
+};
+
+enum VstProcessLevels
+{
+   kVstProcessLevelUnknown = 0,
+   kVstProcessLevelUser,
+   kVstProcessLevelRealtime,
+   kVstProcessLevelPrefetch,
+   kVstProcessLevelOffline
+};
+
+enum VstProcessPrecision
+{
+   kVstProcessPrecision32 = 0,
+   kVstProcessPrecision64
+};
+
+// --------------------------------------------------------------------------
+// events
+// --------------------------------------------------------------------------
+
+struct VstEvent
+{
+   VstInt32 type;
+   VstInt32 byteSize;
+   VstInt32 deltaFrames;
+   VstInt32 flags;
+
+   char data[16];
+};
+
+enum VstEventTypes
+{
+   kVstMidiType  = 1,
+   kVstSysExType = 6
+};
+
+struct VstEvents
+{
+   VstInt32 numEvents;
+   VstIntPtr reserved;
+   VstEvent* events[2];
+};
+
+struct VstMidiEvent
+{
+   VstInt32 type;
+   VstInt32 byteSize;
+   VstInt32 deltaFrames;
+   VstInt32 flags;
+   VstInt32 noteLength;
+   VstInt32 noteOffset;
+   char midiData[4];
+   char detune;
+   char noteOffVelocity;
+   char reserved1;
+   char reserved2;
+};
+
+enum VstMidiEventFlags
+{
+   kVstMidiEventIsRealtime = 1 << 0
+};
+
+struct VstMidiSysexEvent
+{
+   VstInt32 type;
+   VstInt32 byteSize;
+   VstInt32 deltaFrames;
+   VstInt32 flags;
+   VstInt32 dumpBytes;
+   VstIntPtr resvd1;
+   char* sysexDump;
+   VstIntPtr resvd2;
+};
+
+// --------------------------------------------------------------------------
+// parameters
+// --------------------------------------------------------------------------
+
+enum VstStringConstantsX
+{
+   kVstMaxLabelLen      = 64,
+   kVstMaxShortLabelLen = 8,
+   kVstMaxCategLabelLen = 24
+};
+
+enum VstParameterFlags
+{
+   kVstParameterIsSwitch                = 1 << 0,
+   kVstParameterUsesIntegerMinMax       = 1 << 1,
+   kVstParameterUsesFloatStep           = 1 << 2,
+   kVstParameterUsesIntStep             = 1 << 3,
+   kVstParameterSupportsDisplayIndex    = 1 << 4,
+   kVstParameterSupportsDisplayCategory = 1 << 5,
+   kVstParameterCanRamp                 = 1 << 6
+};
+
+struct VstParameterProperties
+{
+   float stepFloat;
+   float smallStepFloat;
+   float largeStepFloat;
+   char label[ kVstMaxLabelLen];
+   VstInt32 flags;
+   VstInt32 minInteger;
+   VstInt32 maxInteger;
+   VstInt32 stepInteger;
+   VstInt32 largeStepInteger;
+   char shortLabel[ kVstMaxShortLabelLen];
+
+   VstInt16 displayIndex;
+   VstInt16 category;
+   VstInt16 numParametersInCategory;
+   VstInt16 reserved;
+   char categoryLabel[ kVstMaxCategLabelLen];
+
+   char future[16];
+};
+
+// --------------------------------------------------------------------------
+// pins
+// --------------------------------------------------------------------------
+
+enum VstPinPropertiesFlags
+{
+   kVstPinIsActive   = 1 << 0,
+   kVstPinIsStereo   = 1 << 1,
+   kVstPinUseSpeaker = 1 << 2
+};
+
+struct VstPinProperties
+{
+   char label[64];
+   VstInt32 flags;
+   VstInt32 arrangementType;
+   char shortLabel[8];
+
+   char future[48];
+};
+
+#endif // __aeffectx__
@@ -0,0 +1,374 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        audioeffect.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   effGetParameterProperties
+//    17.10.2026  AWe   effVendorSpecific
+//    17.10.2026  AWe   minimal stand-in for the VST 2.4 AudioEffect and
+//                      AudioEffectX classes and the plugin entry point.
+//                      Used for the headless Linux build, never shipped.
+//
+// --------------------------------------------------------------------------
+
+#include "audioeffectx.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// --------------------------------------------------------------------------
+// AudioEffect
+// --------------------------------------------------------------------------
+
+AudioEffect::AudioEffect( audioMasterCallback audioMaster, VstInt32 numPrograms, VstInt32 numParams)
+   : sampleRate( 44100.f)
+   , editor( 0)
+   , audioMaster( audioMaster)
+   , numPrograms( numPrograms)
+   , numParams( numParams)
+   , curProgram( 0)
+   , blockSize( 1024)
+{
+   memset( &cEffect, 0, sizeof( cEffect));
+
+   cEffect.magic                  = kEffectMagic;
+   cEffect.dispatcher             = dispatchEffectClass;
+   cEffect.setParameter           = setParameterClass;
+   cEffect.getParameter           = getParameterClass;
+   cEffect.numPrograms            = numPrograms;
+   cEffect.numParams              = numParams;
+   cEffect.numInputs              = 1;
+   cEffect.numOutputs             = 2;
+   cEffect.object                 = this;
+   cEffect.version                = 1;
+   cEffect.processReplacing       = processClassReplacing;
+   cEffect.processDoubleReplacing = processClassDoubleReplacing;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+AudioEffect::~AudioEffect()
+{
+   if( editor)
+      delete editor;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+VstIntPtr AudioEffect::dispatchEffectClass( AEffect* e, VstInt32 opcode, VstInt32 index, VstIntPtr value, void* ptr, float opt)
+{
+   AudioEffect* ae = (AudioEffect*)( e->object);
+
+   if( opcode == effClose)
+   {
+      ae->dispatcher( opcode, index, value, ptr, opt);
+      delete ae;
+      return 1;
+   }
+
+   return ae->dispatcher( opcode, index, value, ptr, opt);
+}
+
+float AudioEffect::getParameterClass( AEffect* e, VstInt32 index)
+{
+   return ((AudioEffect*)e->object)->getParameter( index);
+}
+
+void AudioEffect::setParameterClass( AEffect* e, VstInt32 index, float value)
+{
+   ((AudioEffect*)e->object)->setParameter( index, value);
+}
+
+void AudioEffect::processClassReplacing( AEffect* e, float** inputs, float** outputs, VstInt32 sampleFrames)
+{
+   ((AudioEffect*)e->object)->processReplacing( inputs, outputs, sampleFrames);
+}
+
+void AudioEffect::processClassDoubleReplacing( AEffect* e, double** inputs, double** outputs, VstInt32 sampleFrames)
+{
+   ((AudioEffect*)e->object)->processDoubleReplacing( inputs, outputs, sampleFrames);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+VstIntPtr AudioEffect::dispatcher( VstInt32 opcode, VstInt32 index, VstIntPtr value, void* ptr, float opt)
+{
+   VstIntPtr v = 0;
+
+   switch( opcode)
+   {
+      case effOpen:              open();                                        break;
+      case effClose:             close();                                       break;
+      case effSetProgram:        if( value < numPrograms) setProgram( (VstInt32)value); break;
+      case effGetProgram:        v = getProgram();                              break;
+      case effSetProgramName:    setProgramName( (char*)ptr);                   break;
+      case effGetProgramName:    getProgramName( (char*)ptr);                   break;
+      case effGetParamLabel:     getParameterLabel( index, (char*)ptr);         break;
+      case effGetParamDisplay:   getParameterDisplay( index, (char*)ptr);       break;
+      case effGetParamName:      getParameterName( index, (char*)ptr);          break;
+      case effSetSampleRate:     setSampleRate( opt);                           break;
+      case effSetBlockSize:      setBlockSize( (VstInt32)value);                break;
+      case effMainsChanged:      if( !value) suspend(); else resume();          break;
+      case effGetChunk:          v = getChunk( (void**)ptr, index ? true : false); break;
+      case effSetChunk:          v = setChunk( ptr, (VstInt32)value, index ? true : false); break;
+   }
+   return v;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void AudioEffect::setParameterAutomated( VstInt32 index, float value)
+{
+   setParameter( index, value);
+   if( audioMaster)
+      audioMaster( &cEffect, audioMasterAutomate, index, 0, 0, value);
+}
+
+void AudioEffect::canProcessReplacing( bool state)
+{
+   if( state)
+      cEffect.flags |= effFlagsCanReplacing;
+   else
+      cEffect.flags &= ~effFlagsCanReplacing;
+}
+
+void AudioEffect::canDoubleReplacing( bool state)
+{
+   if( state)
+      cEffect.flags |= effFlagsCanDoubleReplacing;
+   else
+      cEffect.flags &= ~effFlagsCanDoubleReplacing;
+}
+
+void AudioEffect::programsAreChunks( bool state)
+{
+   if( state)
+      cEffect.flags |= effFlagsProgramChunks;
+   else
+      cEffect.flags &= ~effFlagsProgramChunks;
+}
+
+void AudioEffect::setEditor( AEffEditor* editor)
+{
+   this->editor = editor;
+   if( editor)
+      cEffect.flags |= effFlagsHasEditor;
+   else
+      cEffect.flags &= ~effFlagsHasEditor;
+}
+
+VstInt32 AudioEffect::getMasterVersion()
+{
+   VstInt32 version = 1;
+   if( audioMaster)
+   {
+      version = (VstInt32)audioMaster( &cEffect, audioMasterVersion, 0, 0, 0, 0);
+      if( !version)
+         version = 1;
+   }
+   return version;
+}
+
+// --------------------------------------------------------------------------
+// Tools, same behaviour as the SDK versions
+// --------------------------------------------------------------------------
+
+void AudioEffect::dB2string( float value, char* text, VstInt32 maxLen)
+{
+   if( value <= 0)
+      vst_strncpy( text, "-oo", maxLen);
+   else
+      float2string( (float)( 20. * log10( value)), text, maxLen);
+}
+
+void AudioEffect::Hz2string( float samples, char* text, VstInt32 maxLen)
+{
+   float sampleRate = getSampleRate();
+   if( !samples)
+      float2string( 0, text, maxLen);
+   else
+      float2string( sampleRate / samples, text, maxLen);
+}
+
+void AudioEffect::ms2string( float samples, char* text, VstInt32 maxLen)
+{
+   float2string( (float)( samples * 1000. / getSampleRate()), text, maxLen);
+}
+
+void AudioEffect::float2string( float value, char* text, VstInt32 maxLen)
+{
+   char string[32];
+   snprintf( string, sizeof( string), "%g", value);
+   vst_strncpy( text, string, maxLen);
+}
+
+// the SDK version returns an empty string for zero, MeeblipVST relies on
+// that behaviour being reproduced here
+
+void AudioEffect::int2string( VstInt32 value, char* text, VstInt32 maxLen)
+{
+   if( value >= 100000000)
+   {
+      vst_strncpy( text, "Huge!", maxLen);
+      return;
+   }
+
+   char string[32];
+   VstInt32 pos = 0;
+   if( value < 0)
+   {
+      string[pos++] = '-';
+      value = -value;
+   }
+
+   bool state = false;
+   for( VstInt32 div = 100000000; div >= 1; div /= 10)
+   {
+      VstInt32 digit = value / div;
+      value -= digit * div;
+      if( state || digit > 0)
+      {
+         string[pos++] = (char)( '0' + digit);
+         state = true;
+      }
+   }
+   string[pos] = 0;
+   vst_strncpy( text, string, maxLen);
+}
+
+// --------------------------------------------------------------------------
+// AudioEffectX
+// --------------------------------------------------------------------------
+
+AudioEffectX::AudioEffectX( audioMasterCallback audioMaster, VstInt32 numPrograms, VstInt32 numParams)
+   : AudioEffect( audioMaster, numPrograms, numParams)
+{
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+VstIntPtr AudioEffectX::dispatcher( VstInt32 opcode, VstInt32 index, VstIntPtr value, void* ptr, float opt)
+{
+   VstIntPtr v = 0;
+
+   switch( opcode)
+   {
+      case effProcessEvents:            v = processEvents( (VstEvents*)ptr);                        break;
+      case effGetProgramNameIndexed:    v = getProgramNameIndexed( (VstInt32)value, index, (char*)ptr) ? 1 : 0; break;
+      case effGetInputProperties:       v = getInputProperties( index, (VstPinProperties*)ptr) ? 1 : 0;  break;
+      case effGetOutputProperties:      v = getOutputProperties( index, (VstPinProperties*)ptr) ? 1 : 0; break;
+      case effGetEffectName:            v = getEffectName( (char*)ptr) ? 1 : 0;                     break;
+      case effGetVendorString:          v = getVendorString( (char*)ptr) ? 1 : 0;                   break;
+      case effGetProductString:         v = getProductString( (char*)ptr) ? 1 : 0;                  break;
+      case effGetVendorVersion:         v = getVendorVersion();                                     break;
+      case effVendorSpecific:           v = vendorSpecific( index, value, ptr, opt);                break;
+      case effCanDo:                    v = canDo( (char*)ptr);                                     break;
+      case effGetTailSize:              v = getGetTailSize();                                       break;
+      case effGetParameterProperties:   v = getParameterProperties( index, (VstParameterProperties*)ptr) ? 1 : 0; break;
+      case effGetVstVersion:            v = getVstVersion();                                        break;
+      case effStartProcess:             v = startProcess();                                         break;
+      case effStopProcess:              v = stopProcess();                                          break;
+      case effSetProcessPrecision:      v = setProcessPrecision( (VstInt32)value) ? 1 : 0;          break;
+      case effGetNumMidiInputChannels:  v = getNumMidiInputChannels();                              break;
+      case effGetNumMidiOutputChannels: v = getNumMidiOutputChannels();                             break;
+      default:                          v = AudioEffect::dispatcher( opcode, index, value, ptr, opt); break;
+   }
+   return v;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+bool AudioEffectX::sendVstEventsToHost( VstEvents* events)
+{
+   if( audioMaster)
+      return audioMaster( &cEffect, audioMasterProcessEvents, 0, 0, events, 0) == 1;
+   return false;
+}
+
+VstInt32 AudioEffectX::getCurrentProcessLevel()
+{
+   if( audioMaster)
+      return (VstInt32)audioMaster( &cEffect, audioMasterGetCurrentProcessLevel, 0, 0, 0, 0);
+   return kVstProcessLevelUnknown;
+}
+
+bool AudioEffectX::updateDisplay()
+{
+   if( audioMaster)
+      return audioMaster( &cEffect, audioMasterUpdateDisplay, 0, 0, 0, 0) ? true : false;
+   return false;
+}
+
+bool AudioEffectX::ioChanged()
+{
+   if( audioMaster)
+      return audioMaster( &cEffect, audioMasterIOChanged, 0, 0, 0, 0) ? true : false;
+   return false;
+}
+
+bool AudioEffectX::beginEdit( VstInt32 index)
+{
+   if( audioMaster)
+      return audioMaster( &cEffect, audioMasterBeginEdit, index, 0, 0, 0) ? true : false;
+   return false;
+}
+
+bool AudioEffectX::endEdit( VstInt32 index)
+{
+   if( audioMaster)
+      return audioMaster( &cEffect, audioMasterEndEdit, index, 0, 0, 0) ? true : false;
+   return false;
+}
+
+void AudioEffectX::isSynth( bool state)
+{
+   if( state)
+      cEffect.flags |= effFlagsIsSynth;
+   else
+      cEffect.flags &= ~effFlagsIsSynth;
+}
+
+void AudioEffectX::noTail( bool state)
+{
+   if( state)
+      cEffect.flags |= effFlagsNoSoundInStop;
+   else
+      cEffect.flags &= ~effFlagsNoSoundInStop;
+}
+
+// --------------------------------------------------------------------------
+// plugin entry point, see ...\public.sdk\source\vst2.x\vstplugmain.cpp
+// --------------------------------------------------------------------------
+
+extern "C" AEffect* VSTPluginMain( audioMasterCallback audioMaster)
+{
+   // get VST version of the host
+   if( !audioMaster( 0, audioMasterVersion, 0, 0, 0, 0))
+      return 0;  // old version
+
+   // create the AudioEffect
+   AudioEffect* effect = createEffectInstance( audioMaster);
+   if( !effect)
+      return 0;
+
+   return effect->getAeffect();
+}
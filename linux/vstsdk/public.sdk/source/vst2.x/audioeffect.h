@@ -0,0 +1,136 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        audioeffect.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   minimal stand-in for the VST 2.4 AudioEffect class,
+//                      signatures follow ...\public.sdk\source\vst2.x\audioeffect.h
+//                      Used for the headless Linux build, never shipped.
+//
+// --------------------------------------------------------------------------
+
+#ifndef __audioeffect__
+#define __audioeffect__
+
+#include "pluginterfaces/vst2.x/aeffect.h"
+
+class AEffEditor;
+
+// --------------------------------------------------------------------------
+// AudioEffect
+// --------------------------------------------------------------------------
+
+class AudioEffect
+{
+public:
+   AudioEffect( audioMasterCallback audioMaster, VstInt32 numPrograms, VstInt32 numParams);
+   virtual ~AudioEffect();
+
+   virtual VstIntPtr dispatcher( VstInt32 opcode, VstInt32 index, VstIntPtr value, void* ptr, float opt);
+
+   // State Transitions
+   virtual void open() {}
+   virtual void close() {}
+   virtual void suspend() {}
+   virtual void resume() {}
+
+   // Processing
+   virtual void setSampleRate( float sampleRate)   { this->sampleRate = sampleRate; }
+   virtual void setBlockSize( VstInt32 blockSize)  { this->blockSize = blockSize; }
+
+   virtual void processReplacing( float** inputs, float** outputs, VstInt32 sampleFrames) = 0;
+   virtual void processDoubleReplacing( double** inputs, double** outputs, VstInt32 sampleFrames) {}
+
+   // Parameters
+   virtual void setParameter( VstInt32 index, float value) {}
+   virtual float getParameter( VstInt32 index) { return 0; }
+   virtual void setParameterAutomated( VstInt32 index, float value);
+
+   // Programs and Persistence
+   virtual VstInt32 getProgram() { return curProgram; }
+   virtual void setProgram( VstInt32 program) { curProgram = program; }
+   virtual void setProgramName( char* name) {}
+   virtual void getProgramName( char* name) { *name = 0; }
+   virtual void getParameterLabel( VstInt32 index, char* label) { *label = 0; }
+   virtual void getParameterDisplay( VstInt32 index, char* text) { *text = 0; }
+   virtual void getParameterName( VstInt32 index, char* text) { *text = 0; }
+
+   virtual VstInt32 getChunk( void** data, bool isPreset = false) { return 0; }
+   virtual VstInt32 setChunk( void* data, VstInt32 byteSize, bool isPreset = false) { return 0; }
+
+   // Internal Setup
+   virtual void setUniqueID( VstInt32 iD)         { cEffect.uniqueID = iD; }
+   virtual void setNumInputs( VstInt32 inputs)    { cEffect.numInputs = inputs; }
+   virtual void setNumOutputs( VstInt32 outputs)  { cEffect.numOutputs = outputs; }
+
+   virtual void canProcessReplacing( bool state = true);
+   virtual void canDoubleReplacing( bool state = true);
+   virtual void programsAreChunks( bool state = true);
+   virtual void setInitialDelay( VstInt32 delay)  { cEffect.initialDelay = delay; }
+
+   // Editor
+   virtual AEffEditor* getEditor() { return editor; }
+   virtual void setEditor( AEffEditor* editor);
+
+   // Inquiry
+   virtual float getSampleRate()   { return sampleRate; }
+   virtual VstInt32 getBlockSize() { return blockSize; }
+
+   // Host Communication
+   virtual VstInt32 getMasterVersion();
+   virtual VstInt32 getCurrentUniqueId() { return 0; }
+   virtual void masterIdle() {}
+
+   // Tools
+   virtual void dB2string( float value, char* text, VstInt32 maxLen);
+   virtual void Hz2string( float samples, char* text, VstInt32 maxLen);
+   virtual void ms2string( float samples, char* text, VstInt32 maxLen);
+   virtual void float2string( float value, char* text, VstInt32 maxLen);
+   virtual void int2string( VstInt32 value, char* text, VstInt32 maxLen);
+
+   AEffect* getAeffect() { return &cEffect; }
+
+protected:
+   float sampleRate;
+   AEffEditor* editor;
+   audioMasterCallback audioMaster;
+   VstInt32 numPrograms;
+   VstInt32 numParams;
+   VstInt32 curProgram;
+   VstInt32 blockSize;
+   AEffect cEffect;
+
+   static VstIntPtr dispatchEffectClass( AEffect* e, VstInt32 opcode, VstInt32 index, VstIntPtr value, void* ptr, float opt);
+   static float getParameterClass( AEffect* e, VstInt32 index);
+   static void setParameterClass( AEffect* e, VstInt32 index, float value);
+   static void processClassReplacing( AEffect* e, float** inputs, float** outputs, VstInt32 sampleFrames);
+   static void processClassDoubleReplacing( AEffect* e, double** inputs, double** outputs, VstInt32 sampleFrames);
+};
+
+// --------------------------------------------------------------------------
+// AEffEditor
+// --------------------------------------------------------------------------
+
+class AEffEditor
+{
+public:
+   AEffEditor( AudioEffect* effect = 0) : effect( effect) {}
+   virtual ~AEffEditor() {}
+
+protected:
+   AudioEffect* effect;
+};
+
+// --------------------------------------------------------------------------
+// plugin entry, implemented by the plugin
+// --------------------------------------------------------------------------
+
+extern AudioEffect* createEffectInstance( audioMasterCallback audioMaster);
+
+#endif // __audioeffect__
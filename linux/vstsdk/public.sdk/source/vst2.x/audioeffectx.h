@@ -0,0 +1,81 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        audioeffectx.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   add getParameterProperties()
+//    17.10.2026  AWe   add vendorSpecific()
+//    17.10.2026  AWe   minimal stand-in for the VST 2.4 AudioEffectX class,
+//                      signatures follow ...\public.sdk\source\vst2.x\audioeffectx.h
+//                      Used for the headless Linux build, never shipped.
+//
+// --------------------------------------------------------------------------
+
+#ifndef __audioeffectx__
+#define __audioeffectx__
+
+#include "audioeffect.h"
+#include "pluginterfaces/vst2.x/aeffectx.h"
+
+// --------------------------------------------------------------------------
+// AudioEffectX
+// --------------------------------------------------------------------------
+
+class AudioEffectX : public AudioEffect
+{
+public:
+   AudioEffectX( audioMasterCallback audioMaster, VstInt32 numPrograms, VstInt32 numParams);
+   virtual ~AudioEffectX() {}
+
+   virtual VstIntPtr dispatcher( VstInt32 opcode, VstInt32 index, VstIntPtr value, void* ptr, float opt);
+
+   // Events
+   virtual VstInt32 processEvents( VstEvents* events) { return 0; }
+   virtual bool sendVstEventsToHost( VstEvents* events);
+
+   // Parameters and Programs
+   virtual bool getProgramNameIndexed( VstInt32 category, VstInt32 index, char* text) { return false; }
+   virtual bool getParameterProperties( VstInt32 index, VstParameterProperties* p) { return false; }
+
+   // Connections and Configuration
+   virtual bool getInputProperties( VstInt32 index, VstPinProperties* properties)  { return false; }
+   virtual bool getOutputProperties( VstInt32 index, VstPinProperties* properties) { return false; }
+
+   // Offline / Others
+   virtual VstInt32 getGetTailSize() { return 0; }
+
+   // Host Properties
+   virtual bool getEffectName( char* name)     { return false; }
+   virtual bool getVendorString( char* text)   { return false; }
+   virtual bool getProductString( char* text)  { return false; }
+   virtual VstInt32 getVendorVersion()         { return 0; }
+   virtual VstIntPtr vendorSpecific( VstInt32 lArg, VstIntPtr lArg2, void* ptrArg, float floatArg) { return 0; }
+   virtual VstInt32 canDo( char* text)         { return 0; }
+   virtual VstInt32 getVstVersion()            { return kVstVersion; }
+
+   // Processing
+   virtual VstInt32 startProcess() { return 0; }
+   virtual VstInt32 stopProcess()  { return 0; }
+   virtual bool setProcessPrecision( VstInt32 precision) { return false; }
+   virtual VstInt32 getNumMidiInputChannels()  { return 0; }
+   virtual VstInt32 getNumMidiOutputChannels() { return 0; }
+
+   // Host Communication
+   virtual VstInt32 getCurrentProcessLevel();
+   virtual bool updateDisplay();
+   virtual bool ioChanged();
+   virtual bool beginEdit( VstInt32 index);
+   virtual bool endEdit( VstInt32 index);
+
+   // Internal Setup
+   virtual void isSynth( bool state = true);
+   virtual void noTail( bool state = true);
+};
+
+#endif // __audioeffectx__
@@ -0,0 +1,38 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        aeffguieditor.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   minimal stand-in for the vstgui4 plugin binding, only
+//                      the types shared with the layout table are declared.
+//                      Used for the headless Linux build, never shipped.
+//
+// --------------------------------------------------------------------------
+
+#ifndef __aeffguieditor__
+#define __aeffguieditor__
+
+#include "public.sdk/source/vst2.x/audioeffectx.h"
+
+typedef const char* UTF8StringPtr;
+
+// --------------------------------------------------------------------------
+// AEffGUIEditor
+// --------------------------------------------------------------------------
+
+class AEffGUIEditor : public AEffEditor
+{
+public:
+   AEffGUIEditor( void* effect) : AEffEditor( (AudioEffect*)effect) {}
+   virtual ~AEffGUIEditor() {}
+
+   virtual void setParameter( VstInt32 index, float value) {}
+};
+
+#endif // __aeffguieditor__
@@ -9,6 +9,63 @@
 // --------------------------------------------------------------------------
 // Changelog
 //
+//    17.10.2026  AWe   getParameterName() and getParameterDisplay() copy at most
+//                      kVstMaxParamStrLen bytes incl. the terminating zero,
+//                      getParameterProperties() serves the full name
+//    17.10.2026  AWe   pass thru the bytes the sysex receiver held back for a
+//                      message which is no dump
+//    17.10.2026  AWe   events within the first minSubBlock frames of a sub-block
+//                      are applied at its start, not at its end
+//    17.10.2026  AWe   remove getGetTailSize(), the tail size is no silence flag
+//    17.10.2026  AWe   compare, morph and randomize of the bank by
+//                      effVendorSpecific, the chunk is read by
+//                      readChunkHeader() and readChunkPrograms()
+//    17.10.2026  AWe   the CCs and the sysex messages share midiLink, sysex
+//                      dumps are requested and sent by effVendorSpecific
+//    17.10.2026  AWe   the midi program change loads the program at its
+//                      deltaFrames, the CCs to the hardware follow at that time
+//    17.10.2026  AWe   midi learn: the next CC after startMidiLearn() is
+//                      assigned to the parameter
+//    17.10.2026  AWe   the programs are kept in MeeblipVST_ProgramBank, the
+//                      midi values of the parameters in one table
+//    17.10.2026  AWe   sysex patch dumps: the dumps of the hardware are stored
+//                      in the bank, requests and dumps to the hardware are
+//                      paced to the midi link. processEvents() copies the
+//                      sysex payloads into an arena, the queues no longer
+//                      keep the host's pointers
+//    17.10.2026  AWe   setProgram() and midi program change load the program,
+//                      the changed parameters are sent to the hardware and
+//                      the editor is refreshed in its idle()
+//    17.10.2026  AWe   programs are chunks: getChunk() / setChunk() save and
+//                      restore the bank in one binary chunk, the engine, the
+//                      hardware and the editor are updated once
+//    17.10.2026  AWe   render threads of the engine, started in resume()
+//    17.10.2026  AWe   oversampling of the voices, the factor is applied in
+//                      resume() and the latency reported with setInitialDelay()
+//    17.10.2026  AWe   extra parameter kEngineMode selects the firmware emulation
+//    17.10.2026  AWe   silent instances skip processBlock(): no voice active, no
+//                      events and digital silence at the inputs, see
+//                      checkSilence()
+//    17.10.2026  AWe   getParameterDisplay() and getParameterName() serve the
+//                      precomputed strings of MeeblipVST_Display
+//    17.10.2026  AWe   branch free knob value scaling from the compile time
+//                      tables of the layout
+//    17.10.2026  AWe   trace points in the real-time paths, tracing is started
+//                      with the environment variable MEEBLIP_TRACE=<file>
+//                      debug output of the per call paths moved to level 0
+//    17.10.2026  AWe   no editor if NO_EDITOR is defined (headless build)
+//    17.10.2026  AWe   incoming CCs are mapped to parameters by ccMap
+//    17.10.2026  AWe   send only the latest value of a CC, paced to the byte
+//                      rate of DIN midi
+//    17.10.2026  AWe   parameter changes of other threads go through lock-free
+//                      queues to the audio thread, applied at their time
+//    17.10.2026  AWe   midi event queues are preallocated ring buffers, count
+//                      overflows, guard processReplacing against allocations
+//    17.10.2026  AWe   apply midi events at their deltaFrames, render the
+//                      block in sub-blocks between the events
+//    17.10.2026  AWe   add polyphony, voice mode and steal mode parameters
+//    17.10.2026  AWe   render the meeblip voice in software with MeeblipVST_Engine,
+//                      feed note on/off and parameter changes to the engine
 //    29.01.2014  AWe   set initial values for gui elements from layout structure
 //    23.01.2014  AWe   in getParameterDisplay() correct calculation of stepcount interval
 //    11.09.2013  AWe   adapted to use vstsdk2.4 from VST3 SDK and vstgui4
@@ -33,8 +90,12 @@
 #include "aweVSTtypes.h"
 
 #include "vstgui/plugin-bindings/aeffguieditor.h"
+#if !defined( NO_EDITOR)
+#include "MeeblipVST_EditorView.h"
+#endif
 
 #define MIDI_CONTROLCHANGE   0xB0
+#define MIDI_ALL_NOTES_OFF   123
 
 // --------------------------------------------------------------------------
 // Debug support
@@ -44,6 +105,11 @@
 #define VERBOSITY_MIN   1
 
 #include "aweDBG.h"
+#include "aweThread.h"
+#include "aweTrace.h"
+
+#include <stdlib.h>
+#include <string.h>
 
 #if defined(WIN32) && defined( _DEBUG) && !defined(  VST3_PLUGIN)
 #include <windows.h>
@@ -55,17 +121,6 @@ long rd = printf( "------------------------------------------------\n" );
 long re = printf( "Meeblip v0.1 VST2.x( DLL) %s %s\n\n", __DATE__, __TIME__  );
 #endif
 
-// --------------------------------------------------------------------------
-// MeeblipVSTProgram
-// --------------------------------------------------------------------------
-
-MeeblipVSTProgram::MeeblipVSTProgram()
-{
-   // Default Program Values
-
-   vst_strncpy( name, "-init-", kVstMaxProgNameLen);
-}
-
 // --------------------------------------------------------------------------
 //
 // --------------------------------------------------------------------------
@@ -86,26 +141,38 @@ MeeblipVST::MeeblipVST( audioMasterCallback audioMaster)
 {
    DBG( 1, "\nMeeblipVST::MeeblipVST" );
 
-   // initialize programs
-   programs = new MeeblipVSTProgram[kNumPrograms];
-   if( programs)
-      setProgram( 0);
+   MeeblipVST_Display::init();
+
+   chunk = new unsigned char[ kBankChunkSize];
+
+   // the programs start with the default values of the layout
+   curProgram = 0;
 
    // initialize parameters
-   MeeblipVSTProgram *ap = &programs[ curProgram];
    DBG( 2, "      curProgram %d", curProgram);
 
+   programs.getParameters( curProgram, parameters);
    for( VstInt32 i = 0; i < kNumGuiParameters; i++)
    {
-      float value = KnobValue2float( getLayoutItem( i)->defaultValue, i);
-
-      parameters[i] = value;
-      ap->parameters[i] = value;
-      DBG( 2, "      set parameter %d %g %d", i, value, getLayoutItem( i)->defaultValue );
+      DBG( 2, "      set parameter %d %g %d", i, parameters[i], getLayoutItem( i)->defaultValue );
    }
 
    fMidiInChannel  = 0.0f;
    fMidiOutChannel = 0.0f;
+   minSubBlock     = MIN_SUBBLOCK_FRAMES;
+   blockFrames     = 0;
+   midiEnable      = true;
+   silent          = false;
+   learnParameter  = -1;
+
+   // mono, like the hardware
+   setParameter( kPolyphony, 7.0f / (kMaxVoices - 1));
+   setParameter( kVoiceMode, float( kVoiceModeMono) / (kNumVoiceModes - 1));
+   setParameter( kStealMode, float( kStealOldest) / (kNumStealModes - 1));
+   setParameter( kEngineMode, float( kEngineModern) / (kNumEngineModes - 1));
+   setParameter( kOversampling, 0.0f);
+   setParameter( kOfflineOversampling, 0.0f);
+   setParameter( kRenderThreads, 0.0f);
 
    if( audioMaster)
    {
@@ -114,13 +181,20 @@ MeeblipVST::MeeblipVST( audioMasterCallback audioMaster)
 
       canProcessReplacing();  // supports replacing output
       canDoubleReplacing ();  // supports double precision processing
+      programsAreChunks();    // the host saves the bank with getChunk()
 
       isSynth();
       setUniqueID( CCONST('a', 'w', 'M', 'b'));// Axel's Meeblip
    }
 
+#if !defined( NO_EDITOR)
    extern AEffGUIEditor* createEditor( AudioEffectX*);
    setEditor( createEditor( this));
+#endif
+
+   // trace the real-time paths of this session
+   const char* tracePath = getenv( "MEEBLIP_TRACE");
+   tracing = tracePath && aweTrace::start( tracePath);
 
    //   initProcess();  // initialize the synthesizer
    suspend();
@@ -137,8 +211,18 @@ MeeblipVST::~MeeblipVST()
 {
    DBG( 1, "\nMeeblipVST::~MeeblipVST" );
 
-   if( programs)
-      delete[] programs;
+   delete[] chunk;
+
+   delete[] _midiEventsIn;
+   delete[] _midiSysexEventsIn;
+   delete[] _midiEventsOut;
+   delete[] _midiSysexEventsOut;
+   delete[] _vstMidiEventsToHost;
+   delete[] _vstSysexEventsToHost;
+   delete _vstEventsToHost;
+
+   if( tracing)
+      aweTrace::stop();
 }
 
 // --------------------------------------------------------------------------
@@ -149,11 +233,23 @@ void MeeblipVST::setProgram( VstInt32 program)
 {
    DBG( 1, "\nMeeblipVST::setProgram %d", program );
 
+   loadProgram( program, 0);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST::loadProgram( VstInt32 program, VstInt32 deltaFrames)
+{
    if( program < 0 || program >= kNumPrograms)
       return;
 
-   MeeblipVSTProgram *ap = &programs[program];
+   float values[ kNumGuiParameters];
+   programs.getParameters( program, values);
    curProgram = program;
+
+   loadParameters( values, false, true, deltaFrames);
 }
 
 // --------------------------------------------------------------------------
@@ -164,7 +260,7 @@ void MeeblipVST::setProgramName( char* name)
 {
    DBG( 1, "\nMeeblipVST::setProgramName %s", name );
 
-   vst_strncpy( programs[ curProgram].name, name, kVstMaxProgNameLen);
+   programs.setName( curProgram, name);
 }
 
 // --------------------------------------------------------------------------
@@ -175,7 +271,7 @@ void MeeblipVST::getProgramName( char* name)
 {
    DBG( 1, "\nMeeblipVST::getProgramName" );
 
-   vst_strncpy( name, programs[curProgram].name, kVstMaxProgNameLen);
+   vst_strncpy( name, programs.getName( curProgram), kVstMaxProgNameLen);
 
    DBG( 2, "      %s", name);
 }
@@ -190,40 +286,30 @@ void MeeblipVST::getParameterDisplay( VstInt32 index, char* text)
 
    if( index < kNumGuiParameters)
    {
-      VstInt32 stepCount = getLayoutItem( index)->stepCount;
       float value = parameters[ index];
 
-      if( stepCount == 1)
-      {
-         if( value < 0.5f )
-            vst_strncpy( text, "Off", kVstMaxParamStrLen);
-         else
-            vst_strncpy( text, "On", kVstMaxParamStrLen);
-      }
-      else
-      {
-         VstInt32 intVal = float2KnobValue( value, index);
-
-         // there is a bug in the int2string function:
-         //    if intVal is zero, the returning string is empty
-         if( intVal)
-            int2string( intVal, text, kVstMaxParamStrLen);
-         else
-            vst_strncpy( text, "0", kVstMaxParamStrLen);
-      }
-      DBG( 2, "     %g --> %s step %d", value, text, stepCount );
+      vst_strncpy( text, MeeblipVST_Display::getDisplay( index, float2KnobValue( value, index)), kVstMaxParamStrLen - 1);
+      DBG( 2, "     %g --> %s", value, text );
    }
    else if( index < kNumGuiParameters + kNumExtraParameters)
    {
-      float value;
+      VstInt32 value = 0;
+
       switch( index)
       {
-         case kMidiInChannel:  value = fMidiInChannel;  break;
-         case kMidiOutChannel: value = fMidiOutChannel; break;
+         case kMidiInChannel:       value = FLOAT_TO_CHANNEL015( fMidiInChannel);         break;
+         case kMidiOutChannel:      value = FLOAT_TO_CHANNEL015( fMidiOutChannel);        break;
+         case kPolyphony:           value = FLOAT_TO_POLYPHONY( fPolyphony);              break;
+         case kVoiceMode:           value = FLOAT_TO_VOICEMODE( fVoiceMode);              break;
+         case kStealMode:           value = FLOAT_TO_STEALMODE( fStealMode);              break;
+         case kEngineMode:          value = FLOAT_TO_ENGINEMODE( fEngineMode);            break;
+         case kOversampling:        value = FLOAT_TO_OVERSAMPLING( fOversampling);        break;
+         case kOfflineOversampling: value = FLOAT_TO_OVERSAMPLING( fOfflineOversampling); break;
+         case kRenderThreads:       value = FLOAT_TO_RENDERTHREADS( fRenderThreads);      break;
       }
-      int32 intVal = (int32)( value * 15 + 0.5f);
-      int2string( intVal+1, text, kVstMaxParamStrLen);
-      DBG( 2, "     %g --> %s step %d", value, text, 15 );
+
+      vst_strncpy( text, MeeblipVST_Display::getDisplay( index, value), kVstMaxParamStrLen - 1);
+      DBG( 2, "     %g --> %s", getParameter( index), text );
    }
    else
    {
@@ -239,24 +325,40 @@ void MeeblipVST::getParameterName( VstInt32 index, char* label)
 {
    DBG( 1, "\nMeeblipVST::getParameterName %d", index );
 
-   if( index < kNumGuiParameters)
-   {
-      const char* parameterName = getLayoutItem( index)->parameterName;
-      VstInt32 parameterNameLen = strlen( parameterName);
-      VstInt32 len = parameterNameLen > kVstMaxParamStrLen ? kVstMaxParamStrLen : parameterNameLen;
+   // the short names fit into the buffer of kVstMaxParamStrLen, the full
+   // names are served by getParameterProperties()
+   if( index < kNumGuiParameters + kNumExtraParameters)
+      vst_strncpy( label, MeeblipVST_Display::getName( index), kVstMaxParamStrLen - 1);
 
-      vst_strncpy( label, parameterName, parameterNameLen);
-   }
-   else if( index < kNumGuiParameters + kNumExtraParameters)
+   DBG( 2, "      label: %s", label);
+}
+
+bool MeeblipVST::getParameterProperties( VstInt32 index, VstParameterProperties* p)
+{
+   DBG( 1, "\nMeeblipVST::getParameterProperties %d", index );
+
+   if( index < 0 || index >= kNumGuiParameters + kNumExtraParameters)
+      return false;
+
+   memset( p, 0, sizeof( VstParameterProperties));
+   vst_strncpy( p->label, MeeblipVST_Display::getLongName( index), kVstMaxLabelLen - 1);
+   vst_strncpy( p->shortLabel, MeeblipVST_Display::getName( index), kVstMaxShortLabelLen - 1);
+
+   if( index < kNumGuiParameters)
    {
-      switch( index)
-      {
-         case kMidiInChannel:   vst_strncpy( label, "Midi In",  kVstMaxParamStrLen);   break;
-         case kMidiOutChannel:  vst_strncpy( label, "Midi Out", kVstMaxParamStrLen);   break;
-      }
+      const MeeblipVST_LayoutItem* layoutItem = getLayoutItem( index);
+
+      p->flags       = kVstParameterUsesIntegerMinMax | kVstParameterUsesIntStep;
+      p->minInteger  = layoutItem->minValue;
+      p->maxInteger  = layoutItem->maxValue;
+      p->stepInteger = 1;
+      p->largeStepInteger = layoutItem->stepCount == 1 ? 1 : 8;
+      if( layoutItem->stepCount == 1)
+         p->flags |= kVstParameterIsSwitch;
    }
 
-   DBG( 2, "      label: %s", label);
+   DBG( 2, "      label: %s (%s)", p->label, p->shortLabel);
+   return true;
 }
 
 // --------------------------------------------------------------------------
@@ -264,30 +366,90 @@ void MeeblipVST::getParameterName( VstInt32 index, char* label)
 // --------------------------------------------------------------------------
 
 void MeeblipVST::setParameter( VstInt32 index, float value)
+{
+   updateParameter( index, value, midiEnable);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// called by the host, the gui and the midi input. The value is stored right
+// away, the engine and the midi output belong to the audio thread, other
+// threads hand the change over through the parameter queue
+
+void MeeblipVST::updateParameter( VstInt32 index, float value, bool sendCC)
 {
    DBG( 1, "\nMeeblipVST::setParameter %d %g", index, value );
 
    if( index < kNumGuiParameters)
    {
-      MeeblipVSTProgram *ap = &programs[ curProgram];
-      DBG( 0, "     %08x %d %d %d", (int)ap, curProgram, index, ap->parameters[index]);
+      DBG( 0, "     %d %d %d", curProgram, index, programs.getValue( curProgram, index));
 
+      // the current parameter keeps the exact value, the program its midi
+      // value
       parameters[index] = value;
-      ap->parameters[index] = value;
+      programs.setParameter( curProgram, index, value);
 
-      if( midiEnable )
-      {
-         sendMidiCC( index, FLOAT_TO_MIDI( value) );
-      }
-
-      ( (AEffGUIEditor*)editor)->setParameter( index, value);
+      if( editor)
+         ( (AEffGUIEditor*)editor)->setParameter( index, value);
    }
    else if( index < kNumGuiParameters + kNumExtraParameters)
+      storeExtraParameter( index, value);
+   else
+      return;
+
+   if( paramQueue.isAudioThread())
+      applyParameter( index, value, sendCC, 0);
+   else
+      paramQueue.push( index, value, sendCC);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the value only, the engine gets it by applyParameter()
+
+void MeeblipVST::storeExtraParameter( VstInt32 index, float value)
+{
+   switch( index)
+   {
+      case kMidiInChannel:       fMidiInChannel       = value; break;
+      case kMidiOutChannel:      fMidiOutChannel      = value; break;
+      case kPolyphony:           fPolyphony           = value; break;
+      case kVoiceMode:           fVoiceMode           = value; break;
+      case kStealMode:           fStealMode           = value; break;
+      case kEngineMode:          fEngineMode          = value; break;
+      case kOversampling:        fOversampling        = value; break;
+      case kOfflineOversampling: fOfflineOversampling = value; break;
+      case kRenderThreads:       fRenderThreads       = value; break;
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// audio thread only
+
+void MeeblipVST::applyParameter( VstInt32 index, float value, bool sendCC, VstInt32 deltaFrames)
+{
+   if( index < kNumGuiParameters)
+   {
+      engine.setKnobValue( index, float2KnobValue( value, index));
+
+      if( sendCC)
+         sendMidiCC( index, FLOAT_TO_MIDI( value), deltaFrames);
+   }
+   else
    {
       switch( index)
       {
-         case kMidiInChannel:   fMidiInChannel  = value; break;
-         case kMidiOutChannel:  fMidiOutChannel = value; break;
+         case kPolyphony:  engine.setPolyphony( FLOAT_TO_POLYPHONY( value));  break;
+         case kVoiceMode:  engine.setVoiceMode( FLOAT_TO_VOICEMODE( value));  break;
+         case kStealMode:  engine.setStealMode( FLOAT_TO_STEALMODE( value));  break;
+         case kEngineMode: engine.setEngineMode( FLOAT_TO_ENGINEMODE( value)); break;
       }
    }
 }
@@ -298,26 +460,33 @@ void MeeblipVST::setParameter( VstInt32 index, float value)
 
 float MeeblipVST::getParameter( VstInt32 index)
 {
-   DBG( 1, "\nMeeblipVST::getParameter %d", index );
+   DBG( 0, "\nMeeblipVST::getParameter %d", index );
 
    if( index < kNumGuiParameters)
    {
-      DBG( 1, " %g", parameters[index] );
+      DBG( 0, " %g", parameters[index] );
       return parameters[index];
    }
    else if( index < kNumGuiParameters + kNumExtraParameters)
    {
-      float value;
+      float value = 0.f;
       switch( index)
       {
-         case kMidiInChannel:   value = fMidiInChannel;  break;
-         case kMidiOutChannel:  value = fMidiOutChannel; break;
+         case kMidiInChannel:       value = fMidiInChannel;       break;
+         case kMidiOutChannel:      value = fMidiOutChannel;      break;
+         case kPolyphony:           value = fPolyphony;           break;
+         case kVoiceMode:           value = fVoiceMode;           break;
+         case kStealMode:           value = fStealMode;           break;
+         case kEngineMode:          value = fEngineMode;          break;
+         case kOversampling:        value = fOversampling;        break;
+         case kOfflineOversampling: value = fOfflineOversampling; break;
+         case kRenderThreads:       value = fRenderThreads;       break;
       }
-      DBG( 1, " %g", value );
+      DBG( 0, " %g", value );
       return value;
    }
 
-   DBG( 1, " invalid" );
+   DBG( 0, " invalid" );
    return 0.f;
 }
 
@@ -331,7 +500,7 @@ bool MeeblipVST::getProgramNameIndexed( VstInt32 category, VstInt32 index, char*
 
    if( index < kNumPrograms)
    {
-      vst_strncpy( text, programs[index].name, kVstMaxProgNameLen);
+      vst_strncpy( text, programs.getName( index), kVstMaxProgNameLen);
       DBG( 2, "      %s", text );
       return true;
    }
@@ -342,6 +511,312 @@ bool MeeblipVST::getProgramNameIndexed( VstInt32 category, VstInt32 index, char*
 //
 // --------------------------------------------------------------------------
 
+// The format is described in MeeblipVST_Chunk.h. A preset holds the current
+// program, a bank all of them. Both carry the extra parameters, only a bank
+// restores them. The data stays valid until the next call.
+
+VstInt32 MeeblipVST::getChunk( void** data, bool isPreset)
+{
+   DBG( 1, "\nMeeblipVST::getChunk %s", isPreset ? "preset" : "bank" );
+
+   VstInt32 first = isPreset ? curProgram : 0;
+   VstInt32 count = isPreset ? 1 : kNumPrograms;
+
+   MeeblipVST_ChunkWriter writer( chunk);
+   writer.putInt32( kChunkMagic);
+   writer.putInt32( kChunkVersion);
+   writer.putInt32( kChunkHeaderSize);
+   writer.putInt32( count);
+   writer.putInt32( curProgram);
+   writer.putInt32( kNumGuiParameters);
+   writer.putInt32( kNumExtraParameters);
+   writer.putInt32( kProgramChunkSize);
+
+   for( VstInt32 i = 0; i < kNumExtraParameters; i++)
+      writer.putFloat( getParameter( kNumGuiParameters + i));
+
+   for( VstInt32 p = first; p < first + count; p++)
+   {
+      writer.putName( programs.getName( p), kVstMaxProgNameLen);
+      for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+         writer.putFloat( programs.getParameter( p, i));
+      writer.putFloat( programs.getMidiInChannel( p));
+      writer.putFloat( programs.getMidiOutChannel( p));
+   }
+
+   DBG( 2, "      %d programs, %d bytes", count, writer.getSize() );
+
+   *data = chunk;
+   return writer.getSize();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// parameters in the range 0..1, a NaN becomes 0
+static float chunkParameter( float value)
+{
+   if( !( value >= 0.0f))
+      return 0.0f;
+   return value < 1.0f ? value : 1.0f;
+}
+
+// the header fields of a chunk, false if it is not a MeeblipVST chunk or
+// the programs it announces are truncated
+
+static bool readChunkHeader( MeeblipVST_ChunkReader& reader, VstInt32 byteSize, VstInt32* header)
+{
+   for( VstInt32 i = 0; i < kChunkHeaderFields; i++)
+   {
+      if( !reader.getInt32( header[i]))
+      {
+         DBG( 1, "      truncated header" );
+         return false;
+      }
+   }
+
+   VstInt32 headerSize    = header[2];
+   VstInt32 numPrograms   = header[3];
+   VstInt32 numParameters = header[5];
+   VstInt32 numExtra      = header[6];
+   VstInt32 programSize   = header[7];
+
+   if( header[0] != kChunkMagic || header[1] < 1
+    || numParameters < 0 || numParameters > 0xffff || numExtra < 0 || numExtra > 0xffff
+    || headerSize < 4 * ( kChunkHeaderFields + numExtra)
+    || programSize < kVstMaxProgNameLen + 4 * ( numParameters + 2)
+    || numPrograms < 1 || numPrograms > ( byteSize - headerSize) / programSize)
+   {
+      DBG( 1, "      not a MeeblipVST chunk or truncated" );
+      return false;
+   }
+
+   DBG( 2, "      version %d, %d programs, %d parameters", header[1], numPrograms, numParameters );
+   return true;
+}
+
+// count programs of the chunk to the programs first.. of bank
+
+static void readChunkPrograms( MeeblipVST_ChunkReader& reader, const VstInt32* header, VstInt32 first, VstInt32 count, MeeblipVST_ProgramBank& bank)
+{
+   VstInt32 headerSize    = header[2];
+   VstInt32 numParameters = header[5];
+   VstInt32 programSize   = header[7];
+
+   for( VstInt32 p = 0; p < count; p++)
+   {
+      VstInt32 dest = first + p;
+      char name[ kVstMaxProgNameLen + 1];
+
+      reader.seek( headerSize + p * programSize);
+      if( reader.getName( name, kVstMaxProgNameLen))
+         bank.setName( dest, name);
+
+      for( VstInt32 i = 0; i < numParameters; i++)
+      {
+         float value;
+         if( reader.getFloat( value) && i < kNumGuiParameters)
+            bank.setParameter( dest, i, chunkParameter( value));
+      }
+
+      float value;
+      if( reader.getFloat( value))
+         bank.setMidiInChannel( dest, chunkParameter( value));
+      if( reader.getFloat( value))
+         bank.setMidiOutChannel( dest, chunkParameter( value));
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// The chunk is checked before anything is changed. The programs are copied
+// without setParameter(), the engine and the hardware get the parameters
+// of the current program at once in the next block, see loadParameters()
+
+VstInt32 MeeblipVST::setChunk( void* data, VstInt32 byteSize, bool isPreset)
+{
+   DBG( 1, "\nMeeblipVST::setChunk %s %d bytes", isPreset ? "preset" : "bank", byteSize );
+
+   MeeblipVST_ChunkReader reader( data, byteSize);
+   VstInt32 header[ kChunkHeaderFields];
+   if( !readChunkHeader( reader, byteSize, header))
+      return 0;
+
+   VstInt32 numPrograms = header[3];
+   VstInt32 program     = header[4];
+   VstInt32 numExtra    = header[6];
+
+   // a preset goes to the current program, a bank replaces the programs it
+   // holds
+   VstInt32 first = isPreset ? curProgram : 0;
+   VstInt32 count = isPreset ? 1 : ( numPrograms < kNumPrograms ? numPrograms : kNumPrograms);
+
+   readChunkPrograms( reader, header, first, count, programs);
+
+   if( !isPreset)
+   {
+      if( program >= 0 && program < kNumPrograms)
+         curProgram = program;
+
+      reader.seek( 4 * kChunkHeaderFields);
+      for( VstInt32 i = 0; i < numExtra && i < kNumExtraParameters; i++)
+      {
+         float value;
+         reader.getFloat( value);
+         storeExtraParameter( kNumGuiParameters + i, chunkParameter( value));
+      }
+   }
+
+   float values[ kNumGuiParameters];
+   programs.getParameters( curProgram, values);
+
+   loadParameters( values, !isPreset);
+   return 1;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// a copy of the bank with the programs of a bank chunk, NULL if data is no
+// bank chunk. Not for the audio thread
+
+MeeblipVST_ProgramBank* MeeblipVST::readBankChunk( const void* data, VstInt32 byteSize)
+{
+   MeeblipVST_ChunkReader reader( data, byteSize);
+   VstInt32 header[ kChunkHeaderFields];
+   if( data == NULL || !readChunkHeader( reader, byteSize, header))
+      return NULL;
+
+   VstInt32 numPrograms = header[3];
+   MeeblipVST_ProgramBank* bank = new MeeblipVST_ProgramBank( programs);
+   readChunkPrograms( reader, header, 0, numPrograms < kNumPrograms ? numPrograms : kNumPrograms, *bank);
+   return bank;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+VstInt32 MeeblipVST::compareBank( const void* data, VstInt32 byteSize)
+{
+   DBG( 1, "\nMeeblipVST::compareBank %d bytes", byteSize );
+
+   MeeblipVST_ProgramBank* other = readBankChunk( data, byteSize);
+   if( other == NULL)
+      return -1;
+
+   VstInt32 count = programs.compare( *other);
+   delete other;
+   return count;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+bool MeeblipVST::morphBank( const void* data, VstInt32 byteSize, float amount)
+{
+   DBG( 1, "\nMeeblipVST::morphBank %d bytes %g", byteSize, amount );
+
+   MeeblipVST_ProgramBank* other = readBankChunk( data, byteSize);
+   if( other == NULL)
+      return false;
+
+   programs.morph( programs, *other, amount);
+   delete other;
+
+   loadProgram( curProgram, 0);
+   return true;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST::randomizeBank( unsigned int seed, float amount)
+{
+   DBG( 1, "\nMeeblipVST::randomizeBank %u %g", seed, amount );
+
+   programs.randomize( 0, kNumGuiParameters - 1, amount, seed);
+   loadProgram( curProgram, 0);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// The values become the current parameters. Only the parameters which
+// differ go to the engine, and only those whose midi value differs are sent
+// to the hardware, paced by the CC output. extra sends the extra parameters
+// as well, they were stored before. All changes get the same time in the
+// parameter queue, so they follow the changes made before and the engine
+// gets them at the same sample. A program change on the audio thread
+// applies them right away.
+
+void MeeblipVST::loadParameters( const float* values, bool extra, bool midiOut, VstInt32 deltaFrames)
+{
+   DBG( 1, "\nMeeblipVST::loadParameters" );
+
+   bool audioThread = paramQueue.isAudioThread();
+   double time = aweGetTime();
+
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+   {
+      if( values[i] == parameters[i])
+         continue;
+
+      bool sendCC = midiOut && midiEnable && FLOAT_TO_MIDI( values[i]) != FLOAT_TO_MIDI( parameters[i]);
+      parameters[i] = values[i];
+
+      if( audioThread)
+         applyParameter( i, values[i], sendCC, deltaFrames);
+      else
+         paramQueue.push( i, values[i], sendCC, time);
+   }
+
+   for( VstInt32 i = kNumGuiParameters; extra && i < kNumParameters; i++)
+   {
+      if( audioThread)
+         applyParameter( i, getParameter( i), false, deltaFrames);
+      else
+         paramQueue.push( i, getParameter( i), false, time);
+   }
+
+   refreshEditor();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// The editor updates all controls in one go in its next idle(), on the gui
+// thread, and asks the host to read the parameters and program names again.
+// Without editor the host is asked here, not from the audio thread
+
+void MeeblipVST::refreshEditor()
+{
+   DBG( 1, "\nMeeblipVST::refreshEditor" );
+
+#if !defined( NO_EDITOR)
+   if( editor)
+   {
+      ( (MeeblipVST_EditorView*)editor)->refresh();
+      return;
+   }
+#endif
+
+   if( !paramQueue.isAudioThread())
+      updateDisplay();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
 bool MeeblipVST::getEffectName( char* name)
 {
    DBG( 1, "\nMeeblipVST::getEffectName" );
@@ -422,6 +897,44 @@ VstInt32 MeeblipVST::canDo( char* text)
    return result;
 }
 
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the commands of a host or a test tool which has no editor, see PLUG_VENDOR_*
+
+VstIntPtr MeeblipVST::vendorSpecific( VstInt32 lArg, VstIntPtr lArg2, void* ptrArg, float floatArg)
+{
+   DBG( 1, "\nMeeblipVST::vendorSpecific %08x %d", lArg, (int)lArg2 );
+
+   switch( lArg)
+   {
+      case PLUG_VENDOR_LEARN:       startMidiLearn( (VstInt32)lArg2);             return 1;
+      case PLUG_VENDOR_REQUEST:     requestSysexDump( (VstInt32)lArg2);           return 1;
+      case PLUG_VENDOR_SEND:        sendSysexDump( (VstInt32)lArg2);              return 1;
+      case PLUG_VENDOR_RANDOMIZE:   randomizeBank( (unsigned int)lArg2, floatArg); return 1;
+
+      case PLUG_VENDOR_COMPARE:     return compareBank( ptrArg, (VstInt32)lArg2);
+      case PLUG_VENDOR_MORPH:       return morphBank( ptrArg, (VstInt32)lArg2, floatArg) ? 1 : 0;
+   }
+
+   return AudioEffectX::vendorSpecific( lArg, lArg2, ptrArg, floatArg);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST::startMidiLearn( VstInt32 parameter)
+{
+   DBG( 1, "\nMeeblipVST::startMidiLearn %d", parameter );
+
+   if( parameter >= kNumGuiParameters)
+      return;
+
+   aweAtomicStore( &learnParameter, parameter < 0 ? -1 : parameter);
+}
+
 // --------------------------------------------------------------------------
 // *
 // --------------------------------------------------------------------------
@@ -437,13 +950,31 @@ bool MeeblipVST::init()
       _vstMidiEventsToHost        = new VstMidiEvent[MAX_EVENTS_PER_TIMESLICE];        // array with midi data for the host
       _vstSysexEventsToHost       = new VstMidiSysexEvent[MAX_EVENTS_PER_TIMESLICE];   // dto. for sysex
 
-      _midiEventsIn = new VstMidiEventVec[PLUG_MIDI_INPUTS];
-      _midiSysexEventsIn = new VstSysexEventVec[PLUG_MIDI_INPUTS];
+      // all queues get their memory here, the audio thread never allocates
+      _midiEventsIn = new VstMidiEventQueue[PLUG_MIDI_INPUTS];
+      _midiSysexEventsIn = new VstSysexEventQueue[PLUG_MIDI_INPUTS];
+      for( int i = 0; i < PLUG_MIDI_INPUTS; i++ )
+      {
+         _midiEventsIn[i].allocate( MIDI_EVENT_QUEUE_SIZE);
+         _midiSysexEventsIn[i].allocate( SYSEX_EVENT_QUEUE_SIZE);
+      }
       _cleanMidiInBuffers();
 
-      _midiEventsOut = new VstMidiEventVec[PLUG_MIDI_OUTPUTS];         // stores the midi cc message data
-      _midiSysexEventsOut = new VstSysexEventVec[PLUG_MIDI_OUTPUTS];   // dto. for sysex
+      _midiEventsOut = new VstMidiEventQueue[PLUG_MIDI_OUTPUTS];         // stores the midi cc message data
+      _midiSysexEventsOut = new VstSysexEventQueue[PLUG_MIDI_OUTPUTS];   // dto. for sysex
+      for( int i = 0; i < PLUG_MIDI_OUTPUTS; i++ )
+      {
+         _midiEventsOut[i].allocate( MIDI_EVENT_QUEUE_SIZE);
+         _midiSysexEventsOut[i].allocate( SYSEX_EVENT_QUEUE_SIZE);
+      }
+      sysexIn.allocate( SYSEX_ARENA_SIZE);
+      sysexOut[0].allocate( SYSEX_ARENA_SIZE);
+      sysexOut[1].allocate( SYSEX_ARENA_SIZE);
+      sysexOutArena = 0;
       _cleanMidiOutBuffers();
+      reportedOverflows = 0;
+
+      paramQueue.allocate();
    }
    catch( ...)
    {
@@ -466,6 +997,7 @@ void MeeblipVST::_cleanMidiInBuffers()
       _midiEventsIn[i].clear();
       _midiSysexEventsIn[i].clear();
    }
+   sysexIn.reset();
 }
 
 // --------------------------------------------------------------------------
@@ -481,23 +1013,51 @@ void MeeblipVST::_cleanMidiOutBuffers()
       _midiEventsOut[i].clear();
       _midiSysexEventsOut[i].clear();
    }
+
+   // the host may still read the payloads sent with this block
+   sysexOutArena ^= 1;
+   sysexOut[ sysexOutArena].reset();
 }
 
 // --------------------------------------------------------------------------
 // *
 // --------------------------------------------------------------------------
 
-// copy sysex messages from midi input to midi output (pass thru)
+// copy a sysex message from midi input to midi output (pass thru), the
+// payload goes to the output arena, the input arena is reset after the block
 
-void MeeblipVST::copySysex()
+void MeeblipVST::copySysex( const VstMidiSysexEvent& event)
 {
    DBG( 0, "\nMeeblipVST::copySysex" );
 
-   VstSysexEventVec::iterator it;
-   for( it=_midiSysexEventsIn->begin(); it<_midiSysexEventsIn->end(); it++)
+   if( _midiSysexEventsOut[0].full())
    {
-      _midiSysexEventsOut->push_back(*it);
+      _midiSysexEventsOut[0].push( event);    // counts the overflow
+      return;
    }
+
+   VstMidiSysexEvent copy = event;
+   copy.sysexDump = sysexOut[ sysexOutArena].copy( event.sysexDump, event.dumpBytes);
+   if( copy.sysexDump)
+      _midiSysexEventsOut[0].push( copy);
+}
+
+// --------------------------------------------------------------------------
+// *
+// --------------------------------------------------------------------------
+
+VstInt32 MeeblipVST::getMidiOverflows()
+{
+   VstInt32 overflows = 0;
+
+   for( int i = 0; i < PLUG_MIDI_INPUTS; i++ )
+      overflows += _midiEventsIn[i].getOverflows() + _midiSysexEventsIn[i].getOverflows();
+
+   for( int i = 0; i < PLUG_MIDI_OUTPUTS; i++ )
+      overflows += _midiEventsOut[i].getOverflows() + _midiSysexEventsOut[i].getOverflows();
+
+   overflows += sysexIn.getOverflows() + sysexOut[0].getOverflows() + sysexOut[1].getOverflows();
+   return overflows;
 }
 
 // --------------------------------------------------------------------------
@@ -540,6 +1100,54 @@ bool MeeblipVST::getOutputProperties( VstInt32 index, VstPinProperties* properti
 // *
 // --------------------------------------------------------------------------
 
+void MeeblipVST::setSampleRate( float sampleRate)
+{
+   DBG( 1, "\nMeeblipVST::setSampleRate %g", sampleRate );
+
+   AudioEffectX::setSampleRate( sampleRate);
+   engine.setSampleRate( sampleRate);
+   midiLink.setSampleRate( sampleRate);
+}
+
+// --------------------------------------------------------------------------
+// *
+// --------------------------------------------------------------------------
+
+// The oversampling factor changes the buffers and the latency, it is only
+// applied here. A host which renders offline reports it by the process
+// level, the offline factor may be higher than the real-time one.
+// The render threads start here as well, not more than there are cores.
+
+void MeeblipVST::resume()
+{
+   DBG( 1, "\nMeeblipVST::resume" );
+
+   bool offline = getCurrentProcessLevel() == kVstProcessLevelOffline;
+   VstInt32 factor = 1 << FLOAT_TO_OVERSAMPLING( offline ? fOfflineOversampling : fOversampling);
+
+   if( factor != engine.getOversampling())
+   {
+      engine.setOversampling( factor);
+
+      VstInt32 latency = engine.getLatency();
+      if( latency != cEffect.initialDelay)
+      {
+         setInitialDelay( latency);
+         ioChanged();
+      }
+   }
+
+   VstInt32 threads = FLOAT_TO_RENDERTHREADS( fRenderThreads);
+   engine.setRenderThreads( threads < aweNumProcessors() ? threads : aweNumProcessors());
+
+   engine.reset();
+   AudioEffectX::resume();
+}
+
+// --------------------------------------------------------------------------
+// *
+// --------------------------------------------------------------------------
+
 void MeeblipVST::preProcess(void)
 {
    DBG( 0, "\nMeeblipVST::preProcess" );
@@ -558,8 +1166,22 @@ void MeeblipVST::postProcess(void)
 {
    DBG( 0, "\nMeeblipVST::postProcess" );
 
+   AWE_TRACE_SCOPE( "postProcess");
+
    if( PLUG_MIDI_OUTPUTS)
    {
+      // the CCs and sysex messages which fit into this block
+      ccOutput.process( blockFrames, midiLink, _midiEventsOut[0]);
+      sortMidiEvents( _midiEventsOut[0]);
+      sendSysex( blockFrames);
+      sortMidiEvents( _midiSysexEventsOut[0]);
+      midiLink.endBlock( blockFrames);
+
+      AWE_TRACE_COUNTER( "midi out", _midiEventsOut[0].size());
+      AWE_TRACE_COUNTER( "cc pending", ccOutput.getNumPending());
+
+      DBG( 2, "      CC out: %d sent, %d coalesced, %d unchanged, %d deferred", ccOutput.getSent(), ccOutput.getCoalesced(), ccOutput.getUnchanged(), ccOutput.getDeferred() );
+
       VstInt32 left = (VstInt32)_midiEventsOut[0].size();
       VstInt32 count = 0;
       while( left > 0)
@@ -622,7 +1244,7 @@ void MeeblipVST::postProcess(void)
          }
 
          _vstEventsToHost->reserved  = 0;
-         if( _midiSysexEventsOut[0].size() > 0)
+         if( _vstEventsToHost->numEvents > 0)
             sendVstEventsToHost((VstEvents*)_vstEventsToHost);
 
          left -= _vstEventsToHost->numEvents;
@@ -632,6 +1254,14 @@ void MeeblipVST::postProcess(void)
       _cleanMidiOutBuffers();
 }
    _cleanMidiInBuffers();
+
+   VstInt32 overflows = getMidiOverflows();
+   if( overflows != reportedOverflows)
+   {
+      DBG( 1, "      midi queue overflow, %d events dropped", overflows );
+      AWE_TRACE_INSTANT( "midi overflow", overflows);
+      reportedOverflows = overflows;
+   }
 }
 
 // --------------------------------------------------------------------------
@@ -649,19 +1279,24 @@ VstInt32 MeeblipVST::processEvents( VstEvents* ev)
       {
          if( (ev->events[i])->type == kVstMidiType)
          {
-            DBG( 1, "\n\nMeeblipVST::processEvents (midi)" );
+            DBG( 0, "\n\nMeeblipVST::processEvents (midi)" );
 
             VstMidiEvent* event = (VstMidiEvent*)ev->events[i];
-            _midiEventsIn[0].push_back(*event);
+            _midiEventsIn[0].push(*event);
          }
          else if( (ev->events[i])->type == kVstSysExType)
          {
-            DBG( 1, "\n\nMeeblipVST::processEvents (sysex)" );
-
-            VstMidiSysexEvent * event = (VstMidiSysexEvent*)ev->events[i];
-            _midiSysexEventsIn[0].push_back(*event);
+            DBG( 0, "\n\nMeeblipVST::processEvents (sysex)" );
+
+            // the host's dump is only valid during this call
+            VstMidiSysexEvent event = *(VstMidiSysexEvent*)ev->events[i];
+            if( _midiSysexEventsIn[0].full())
+               _midiSysexEventsIn[0].push( event);    // counts the overflow
+            else if( ( event.sysexDump = sysexIn.copy( event.sysexDump, event.dumpBytes)) != NULL)
+               _midiSysexEventsIn[0].push( event);
          }
       }
+      AWE_TRACE_COUNTER( "midi queue", _midiEventsIn[0].size());
    }
    return 1;
 }
@@ -670,29 +1305,141 @@ VstInt32 MeeblipVST::processEvents( VstEvents* ev)
 // *
 // --------------------------------------------------------------------------
 
-void MeeblipVST::processReplacing( float** inputs, float** outputs, VstInt32 sampleFrames)
+// The events are applied in the order of their deltaFrames, the engine
+// renders the frames between two events in one piece. So there is no check
+// for events within the render loops and a note or CC lands on its sample
+// at every block size. Sub-blocks are at least minSubBlock frames long, events
+// falling into the first minSubBlock frames of a sub-block are applied at
+// its start, the sub-block ends at the next event after them.
+
+template <typename FloatType>
+void MeeblipVST::processBlock( FloatType** inputs, FloatType** outputs, VstInt32 sampleFrames)
 {
-   DBG( 0, "\nMeeblipVST::processReplacing" );
+   blockFrames = sampleFrames;
 
-   //takes care of VstTimeInfo and such
-   preProcess();
+   VstMidiEventQueue& events = _midiEventsIn[0];
+   VstInt32 numEvents = (VstInt32)events.size();
+   VstInt32 next = 0;
+
+   // parameter changes of the gui and automation threads
+   paramQueue.setAudioThread();
+   paramQueue.beginBlock( sampleRate, sampleFrames);
+
+   VstInt32 numChanges = paramQueue.getNumPending();
+   VstInt32 nextChange = 0;
+
+   // nothing to do for a silent instance, the next event wakes it up in
+   // the block it arrives
+   if( numEvents == 0 && numChanges == 0 && _midiSysexEventsIn[0].size() == 0
+    && !engine.isActive() && checkSilence( inputs, sampleFrames))
+   {
+      memset( outputs[0], 0, sampleFrames * sizeof( FloatType));
+      memset( outputs[1], 0, sampleFrames * sizeof( FloatType));
+      silent = true;
+      return;
+   }
+   silent = false;
 
    //host should have called processEvents before process
-   processMidiEvents( _midiEventsIn, _midiEventsOut, sampleFrames);
    processMidiSysexEvents( _midiSysexEventsIn, _midiSysexEventsOut, sampleFrames);
 
-   float* in1  =  inputs[0];
-   float* in2  =  inputs[1];
-
-   float* out1 = outputs[0];
-   float* out2 = outputs[1];
+   FloatType* in1  = inputs[0];
+   FloatType* in2  = inputs[1];
+   FloatType* out1 = outputs[0];
+   FloatType* out2 = outputs[1];
 
-   while( --sampleFrames >= 0)
+   VstInt32 frames = sampleFrames;
+   while( --frames >= 0)
    {
       (*out1++) = (*in1++);
       (*out2++) = (*in2++);
    }
 
+#if defined( _DEBUG)
+   if( numEvents)
+      DBG( 0, "\nMeeblipVST::processBlock %d events", numEvents );
+#endif
+   AWE_TRACE_COUNTER( "midi in", numEvents);
+   AWE_TRACE_COUNTER( "param changes", numChanges);
+
+   sortMidiEvents( events);
+
+   // add the software voice
+   VstInt32 pos = 0;
+   while( pos < sampleFrames)
+   {
+      VstInt32 end = pos + minSubBlock;
+      if( end > sampleFrames)
+         end = sampleFrames;
+
+      // changes of other threads happened before the events of this block
+      while( nextChange < numChanges && paramQueue.getPending( nextChange).deltaFrames < end)
+         applyParameterChange( paramQueue.getPending( nextChange++), pos);
+
+      while( next < numEvents && events[ next].deltaFrames < end)
+         processMidiEvent( events[ next++]);
+
+      // the remaining events are at or behind end
+      VstInt32 limit = sampleFrames;
+      if( next < numEvents && events[ next].deltaFrames < limit)
+         limit = events[ next].deltaFrames;
+      if( nextChange < numChanges && paramQueue.getPending( nextChange).deltaFrames < limit)
+         limit = paramQueue.getPending( nextChange).deltaFrames;
+      if( end < limit)
+         end = limit;
+
+      {
+         AWE_TRACE_SCOPE( "render");
+         engine.process( outputs[0] + pos, outputs[1] + pos, end - pos);
+      }
+      pos = end;
+   }
+
+   // events behind the end of the block
+   while( nextChange < numChanges)
+      applyParameterChange( paramQueue.getPending( nextChange++), 0);
+
+   while( next < numEvents)
+      processMidiEvent( events[ next++]);
+}
+
+// --------------------------------------------------------------------------
+// *
+// --------------------------------------------------------------------------
+
+// true if both inputs are digital silence, stops at the first sample which
+// is not zero
+
+template <typename FloatType>
+bool MeeblipVST::checkSilence( FloatType** inputs, VstInt32 sampleFrames)
+{
+   const FloatType* in1 = inputs[0];
+   const FloatType* in2 = inputs[1];
+
+   for( VstInt32 i = 0; i < sampleFrames; i++)
+   {
+      if( in1[i] != 0 || in2[i] != 0)
+         return false;
+   }
+   return true;
+}
+
+// --------------------------------------------------------------------------
+// *
+// --------------------------------------------------------------------------
+
+void MeeblipVST::processReplacing( float** inputs, float** outputs, VstInt32 sampleFrames)
+{
+   DBG( 0, "\nMeeblipVST::processReplacing" );
+
+   aweAllocGuard allocGuard;     // traps heap allocations in debug builds
+   AWE_TRACE_SCOPE( "processReplacing");
+
+   //takes care of VstTimeInfo and such
+   preProcess();
+
+   processBlock( inputs, outputs, sampleFrames);
+
    //sending out MIDI events to Host to conclude wrapper
    postProcess();
 }
@@ -705,24 +1452,13 @@ void MeeblipVST::processDoubleReplacing( double** inputs, double** outputs, VstI
 {
    DBG( 0, "\nMeeblipVST::processDoubleReplacing" );
 
+   aweAllocGuard allocGuard;     // traps heap allocations in debug builds
+   AWE_TRACE_SCOPE( "processDoubleReplacing");
+
    //takes care of VstTimeInfo and such
    preProcess();
 
-   //host should have called processEvents before process
-   processMidiEvents(_midiEventsIn, _midiEventsOut, sampleFrames);
-   processMidiSysexEvents( _midiSysexEventsIn, _midiSysexEventsOut, sampleFrames);
-
-
-   double* in1  = inputs[0];
-   double* in2  = inputs[1];
-   double* out1 = outputs[0];
-   double* out2 = outputs[1];
-
-   while( --sampleFrames >= 0)
-   {
-      (*out1++) = (*in1++);
-      (*out2++) = (*in2++);
-   }
+   processBlock( inputs, outputs, sampleFrames);
 
    //sending out MIDI events to Host to conclude wrapper
    postProcess();
@@ -732,21 +1468,15 @@ void MeeblipVST::processDoubleReplacing( double** inputs, double** outputs, VstI
 //
 // --------------------------------------------------------------------------
 
-tresult MeeblipVST::sendMidiCC( ParamID paramId, int32 midiValue)
+tresult MeeblipVST::sendMidiCC( ParamID paramId, int32 midiValue, VstInt32 deltaFrames)
 {
    int midiChannel= FLOAT_TO_CHANNEL015( fMidiOutChannel); //outgoing midi channel
 
    CtrlNumber midiControllerNumber = getLayoutItem( paramId)->CCindex;
    DBG( 2, "      Midi out %d - %d", midiControllerNumber, midiValue );
 
-   VstMidiEvent event = { 0 };
-
-   event.deltaFrames = 0;
-   event.midiData[0] = MIDI_CONTROLCHANGE + midiChannel;
-   event.midiData[1] = (char)midiControllerNumber;
-   event.midiData[2] = (char)midiValue;
-
-   _midiEventsOut[0].push_back( event);
+   // sent in postProcess()
+   ccOutput.add( midiChannel, midiControllerNumber, midiValue, deltaFrames);
 
    return kResultOk;
 }
@@ -755,53 +1485,53 @@ tresult MeeblipVST::sendMidiCC( ParamID paramId, int32 midiValue)
 //
 // --------------------------------------------------------------------------
 
-void MeeblipVST::processMidiEvents( VstMidiEventVec *inputs, VstMidiEventVec *outputs, VstInt32 sampleFrames)
+void MeeblipVST::processMidiEvent( const VstMidiEvent& event)
 {
-#if defined( _DEBUG)
-   if( inputs[0].size() )
-      DBG( 1, "\nMeeblipVST::processMidiEvents" );
-#endif
+   short midiStatus  =  event.midiData[0] & 0xf0;         // scraping  channel
+   short midiChannel = (event.midiData[0] & 0x0f) + 1;    // isolating channel (1-16)
+   short midiData1   =  event.midiData[1] & 0x7f;
+   short midiData2   =  event.midiData[2] & 0x7f;
 
-   // process incoming events
-   for( unsigned int i = 0; i < inputs[0].size(); i++)
+   if( midiStatus == 0x80)
+   {
+      DBG( 2, "      Note off %d %d", midiData1, midiData2 );
+      engine.noteOff( midiData1);
+   }
+   else if( midiStatus == 0x90)
+   {
+      DBG( 2, "      Note on  %d %d", midiData1, midiData2 );
+      engine.noteOn( midiData1, midiData2);
+   }
+   else if( midiStatus == 0xc0)
+   {
+      DBG( 2, "      Program change %d", midiData1 );
+      loadProgram( midiData1, event.deltaFrames);
+   }
+   else if( midiStatus == 0xb0)
    {
-      VstMidiEvent event = inputs[0][i];
+      unsigned char cc = (unsigned char)midiData1;
+      unsigned char intValue = (unsigned char)midiData2;
 
-      short midiStatus  =  event.midiData[0] & 0xf0;         // scraping  channel
-      short midiChannel = (event.midiData[0] & 0x0f) + 1;    // isolating channel (1-16)
-      short midiData1   =  event.midiData[1] & 0x7f;
-      short midiData2   =  event.midiData[2] & 0x7f;
+      // process midi control commands
+      DBG( 2, "      control command %d %d", cc, intValue );
 
-      if( midiStatus == 0x80)
+      if( cc == MIDI_ALL_NOTES_OFF)
       {
-         DBG( 2, "      Note off %d %d", midiData1, midiData2 );
+         engine.allNotesOff();
+         return;
       }
-      else if( midiStatus == 0x90)
-      {
-         DBG( 2, "      Note on  %d %d", midiData1, midiData2 );
-      }
-      else if( midiStatus == 0xb0)
-      {
-         unsigned char cc = (unsigned char)midiData1;
-         unsigned char intValue = (unsigned char)midiData2;
 
-         // process midi control commands
-         DBG( 2, "      control command %d %d", cc, intValue );
+      // midi learn, the first CC after startMidiLearn() takes the parameter
+      VstInt32 learn = aweAtomicLoad( &learnParameter);
+      if( learn >= 0 && aweAtomicCompareExchange( &learnParameter, learn, -1))
+         ccMap.learn( midiChannel - 1, cc, learn);
 
-         ParamID paramId;
-         tresult rc = mapCCToTag( cc, paramId);
-         DBG( 2, "      set param %s  %d %g", rc == kResultTrue? "ok" : "fail", paramId, MIDI_TO_FLOAT( intValue) );
+      VstInt32 paramId = ccMap.getParameter( midiChannel - 1, cc);
+      DBG( 2, "      set param %s  %d %g", paramId != MeeblipVST_CCMap::kNone ? "ok" : "fail", paramId, MIDI_TO_FLOAT( intValue) );
 
-         if( rc == kResultTrue)
-         {
-            bool midiEnableStatus = midiEnable;
-            midiEnable = false;
-            DBG( 2, "      Midi %sable", midiEnable ? "en" : "dis" );
-            setParameter( paramId, MIDI_TO_FLOAT( intValue)); // setup parameter, gui element
-            midiEnable = midiEnableStatus;
-            DBG( 2, "      Midi %sable", midiEnable ? "en" : "dis" );
-         }
-      }
+      // setup parameter, gui element, no echo to the midi output
+      if( paramId != MeeblipVST_CCMap::kNone)
+         updateParameter( paramId, MIDI_TO_FLOAT( intValue), false);
    }
 }
 
@@ -809,58 +1539,124 @@ void MeeblipVST::processMidiEvents( VstMidiEventVec *inputs, VstMidiEventVec *ou
 //
 // --------------------------------------------------------------------------
 
-void MeeblipVST::processMidiSysexEvents( VstSysexEventVec *inputs, VstSysexEventVec *outputs, VstInt32 sampleFrames)
+// The dumps of the meeblip are stored in the bank, all other messages are
+// passed thru. The messages to the hardware are added in postProcess()
+
+void MeeblipVST::processMidiSysexEvents( VstSysexEventQueue *inputs, VstSysexEventQueue *outputs, VstInt32 sampleFrames)
 {
    DBG( 0, "\nMeeblipVST::processMidiSysexEvents" );
 
-   // process incoming events
+   for( unsigned int i = 0; i < inputs[0].size(); i++)
+   {
+      const VstMidiSysexEvent& event = inputs[0][i];
 
-   // pass thru sysex events
-   copySysex();
+      MeeblipVST_SysexDump dump;
+      VstInt32 pos = 0;
 
-   // process outgoing sysex events
+      sysexReceiver.beginEvent();
+      while( sysexReceiver.receive( (const unsigned char*)event.sysexDump, event.dumpBytes, pos, dump))
+         receiveSysexDump( dump);
+
+      // the start of a message held back by an earlier event
+      const unsigned char* held;
+      VstInt32 heldBytes = sysexReceiver.getReleased( held);
+      if( heldBytes > 0)
+      {
+         VstMidiSysexEvent copy = event;
+         copy.dumpBytes = heldBytes;
+         copy.sysexDump = (char*)held;
+         copySysex( copy);
+      }
+
+      if( !sysexReceiver.ownsEvent())
+         copySysex( event);
+   }
 }
 
 // --------------------------------------------------------------------------
 //
 // --------------------------------------------------------------------------
 
-VstInt32 MeeblipVST::float2KnobValue( float value, VstInt32 index)
+// on the audio thread: the current program is loaded right away, without
+// CCs, the hardware has the values already
+
+void MeeblipVST::receiveSysexDump( const MeeblipVST_SysexDump& dump)
 {
-   VstInt32 intVal;
-   VstInt32 minValue  = getLayoutItem( index)->minValue;
-   VstInt32 maxValue  = getLayoutItem( index)->maxValue;
-   VstInt32 stepCount = getLayoutItem( index)->stepCount;
+   DBG( 1, "\nMeeblipVST::receiveSysexDump %d %s", dump.program, dump.name );
 
-   if( value < 1.0f/(2*stepCount))
-      intVal = minValue;
-   else if( value >= 1.0f - 1.0f/(2*stepCount))
-      intVal = maxValue;
-   else
+   if( dump.program >= kNumPrograms)
+      return;
+
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+      programs.setValue( dump.program, i, dump.values[i]);
+   programs.setName( dump.program, dump.name);
+
+   if( dump.program == curProgram)
    {
-      VstInt32 n = VstInt32( (value - 1.0f/(2*stepCount)) * stepCount) + 1;
-      VstInt32 interval = (maxValue - minValue)/stepCount;
-      intVal = minValue + n * interval;
+      float values[ kNumGuiParameters];
+      programs.getParameters( curProgram, values);
+      loadParameters( values, false, false);
    }
-
-   return intVal;
+   else
+      refreshEditor();
 }
 
 // --------------------------------------------------------------------------
 //
 // --------------------------------------------------------------------------
 
-float MeeblipVST::KnobValue2float( VstInt32 intVal, VstInt32 index)
+// the requests and dumps which start within this block
+
+void MeeblipVST::sendSysex( VstInt32 sampleFrames)
 {
-   float value;
+   MeeblipVST_SysexArena& arena = sysexOut[ sysexOutArena];
+   VstInt32 command, program, deltaFrames;
+
+   while( !_midiSysexEventsOut[0].full() && arena.getFree() >= kSysexMaxMessage
+       && sysexSender.next( sampleFrames, midiLink, command, program, deltaFrames))
+   {
+      unsigned char* data = arena.alloc( sysexMessageSize( command));
+
+      if( command == kSysexProgramDump && program < kNumPrograms)
+      {
+         MeeblipVST_SysexDump dump;
+         dump.program = program;
+         for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+            dump.values[i] = programs.getValue( program, i);
+         vst_strncpy( dump.name, programs.getName( program), kVstMaxProgNameLen);
+
+         sysexEncodeDump( data, dump);
+      }
+      else
+         sysexEncodeRequest( data, command, program);
+
+      VstMidiSysexEvent event;
+      memset( &event, 0, sizeof( event));
+      event.type        = kVstSysExType;
+      event.byteSize    = sizeof( VstMidiSysexEvent);
+      event.deltaFrames = deltaFrames;
+      event.dumpBytes   = sysexMessageSize( command);
+      event.sysexDump   = (char*)data;
+      _midiSysexEventsOut[0].push( event);
+   }
+}
 
-   VstInt32 minValue  = getLayoutItem( index)->minValue;
-   VstInt32 maxValue  = getLayoutItem( index)->maxValue;
-   VstInt32 stepCount = getLayoutItem( index)->stepCount;
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
 
-   value = float(intVal - minValue)/float( stepCount);
+VstInt32 MeeblipVST::float2KnobValue( float value, VstInt32 index)
+{
+   return paramToKnobValue( value, index);
+}
 
-   return value;
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+float MeeblipVST::KnobValue2float( VstInt32 intVal, VstInt32 index)
+{
+   return knobValueToParam( intVal, index);
 }
 
 // --------------------------------------------------------------------------
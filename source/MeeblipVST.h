@@ -9,6 +9,36 @@
 // --------------------------------------------------------------------------
 // Changelog
 //
+//    17.10.2026  AWe   add getParameterProperties()
+//    17.10.2026  AWe   remove getGetTailSize()
+//    17.10.2026  AWe   compareBank(), morphBank() and randomizeBank(), also as
+//                      effVendorSpecific commands
+//    17.10.2026  AWe   CCs and sysex messages paced by one MeeblipVST_MidiLink,
+//                      sysex dumps requested and sent by effVendorSpecific
+//    17.10.2026  AWe   a midi program change loads the program at its deltaFrames
+//    17.10.2026  AWe   midi learn with startMidiLearn() and effVendorSpecific
+//    17.10.2026  AWe   the programs are a MeeblipVST_ProgramBank, a table of
+//                      7 bit values instead of an array of MeeblipVSTProgram
+//    17.10.2026  AWe   sysex patch dumps, the sysex payloads are copied into
+//                      preallocated arenas
+//    17.10.2026  AWe   setProgram() loads the program, only the changed
+//                      parameters go to the engine and the hardware
+//    17.10.2026  AWe   getChunk() / setChunk() with the bank as binary chunk
+//    17.10.2026  AWe   add the render threads parameter
+//    17.10.2026  AWe   add the oversampling parameters
+//    17.10.2026  AWe   add the ENGINE parameter, modern or firmware emulation
+//    17.10.2026  AWe   add checkSilence() and getGetTailSize()
+//    17.10.2026  AWe   include MeeblipVST_Display.h
+//    17.10.2026  AWe   add tracing
+//    17.10.2026  AWe   add ccMap for the incoming CCs and midi learn
+//    17.10.2026  AWe   CC output coalesced and paced by MeeblipVST_CCOutput
+//    17.10.2026  AWe   parameter changes of other threads go through
+//                      MeeblipVST_ParamQueue to the audio thread
+//    17.10.2026  AWe   midi event queues are preallocated ring buffers
+//    17.10.2026  AWe   render in sub-blocks between midi events, sortMidiEvents()
+//                      sorts the queue instead of a copy
+//    17.10.2026  AWe   add polyphony, voice mode and steal mode parameters
+//    17.10.2026  AWe   render the meeblip voice in software with MeeblipVST_Engine
 //    29.01.2014  AWe   set initial values for gui elements from layout structure
 //    11.09.2013  AWe   adapted to use vstsdk2.4 from VST3 SDK and vstqui4
 //    21.08.2013  AWe   add support for midi in/out
@@ -24,12 +54,19 @@
 #define __MeeblipVST__
 
 #include "MeeblipVST_Layout.h"
+#include "MeeblipVST_Display.h"
+#include "MeeblipVST_Engine.h"
+#include "MeeblipVST_ParamQueue.h"
+#include "MeeblipVST_CCOutput.h"
+#include "MeeblipVST_Chunk.h"
+#include "MeeblipVST_Sysex.h"
+#include "MeeblipVST_ProgramBank.h"
 
 #include "public.sdk/source/vst2.x/audioeffectx.h"
 #include "aweVSTtypes.h"
-
-#include <algorithm>
-#include <vector>
+#include "aweRingBuffer.h"
+#include "aweAllocGuard.h"
+#include "aweAtomic.h"
 
 // --------------------------------------------------------------------------
 //
@@ -44,6 +81,12 @@ inline int roundToInt(const FloatType x)
 #define MIDI_TO_FLOAT(i)            ( (float)(i)     * (1.0f/127))
 #define FLOAT_TO_MIDI(i)            ( roundToInt((i) * 127.0f))
 #define FLOAT_TO_CHANNEL015(i)      ( roundToInt((i) * 15.0f))
+#define FLOAT_TO_POLYPHONY(i)       ( roundToInt((i) * (kMaxVoices - 1)) + 1)
+#define FLOAT_TO_VOICEMODE(i)       ( roundToInt((i) * (kNumVoiceModes - 1)))
+#define FLOAT_TO_STEALMODE(i)       ( roundToInt((i) * (kNumStealModes - 1)))
+#define FLOAT_TO_ENGINEMODE(i)      ( roundToInt((i) * (kNumEngineModes - 1)))
+#define FLOAT_TO_OVERSAMPLING(i)    ( roundToInt((i) * (kNumOversampleFactors - 1)))
+#define FLOAT_TO_RENDERTHREADS(i)   ( roundToInt((i) * (kMaxRenderThreads - 1)) + 1)
 
 // --------------------------------------------------------------------------
 //
@@ -51,28 +94,13 @@ inline int roundToInt(const FloatType x)
 
 enum
 {
-   // Global
-   kNumPrograms = 128,
-   kNumOutputs = 2
-};
-
-// --------------------------------------------------------------------------
-// MeeblipVSTProgram
-// --------------------------------------------------------------------------
-
-class MeeblipVSTProgram
-{
-friend class MeeblipVST;	// allow MeeblipVST access to name variable
-public:
-   MeeblipVSTProgram();
-   ~MeeblipVSTProgram() {}
-
-private:
-   float parameters[ kNumGuiParameters];
-   float fMidiInChannel;
-   float fMidiOutChannel;
+   // Global, kNumPrograms see MeeblipVST_ProgramBank.h
+   kNumOutputs = 2,
 
-   char name[kVstMaxProgNameLen+1];
+   // see MeeblipVST_Chunk.h
+   kProgramChunkSize = kVstMaxProgNameLen + 4 * ( kNumGuiParameters + 2),
+   kChunkHeaderSize  = 4 * ( kChunkHeaderFields + kNumExtraParameters),
+   kBankChunkSize    = kChunkHeaderSize + kNumPrograms * kProgramChunkSize
 };
 
 // --------------------------------------------------------------------------
@@ -83,11 +111,30 @@ private:
 #define PLUG_MIDI_INPUTS   1
 #define PLUG_MIDI_OUTPUTS  1
 
-typedef std::vector<VstMidiEvent> VstMidiEventVec;
-typedef std::vector<VstMidiSysexEvent> VstSysexEventVec;
+// effVendorSpecific commands, index is the command
+#define PLUG_VENDOR_LEARN     CCONST( 'M', 'B', 'l', 'n')   // value: parameter, < 0 cancels
+#define PLUG_VENDOR_REQUEST   CCONST( 'M', 'B', 'r', 'q')   // value: program, < 0 the bank
+#define PLUG_VENDOR_SEND      CCONST( 'M', 'B', 's', 'd')   // value: program, < 0 the bank
+#define PLUG_VENDOR_COMPARE   CCONST( 'M', 'B', 'c', 'm')   // ptr, value: bank chunk and its size
+#define PLUG_VENDOR_MORPH     CCONST( 'M', 'B', 'm', 'o')   // ptr, value: bank chunk, opt: amount
+#define PLUG_VENDOR_RANDOMIZE CCONST( 'M', 'B', 'r', 'n')   // value: seed, opt: amount
+
+typedef aweRingBuffer<VstMidiEvent> VstMidiEventQueue;
+typedef aweRingBuffer<VstMidiSysexEvent> VstSysexEventQueue;
 
 #define MAX_EVENTS_PER_TIMESLICE 256
 
+// capacity of the midi event queues, allocated in init()
+#define MIDI_EVENT_QUEUE_SIZE    1024
+#define SYSEX_EVENT_QUEUE_SIZE   64
+
+// bytes of the sysex payloads per block, allocated in init()
+#define SYSEX_ARENA_SIZE         32768
+
+// events closer than this to the start of a sub-block are applied at its
+// start, 1 means every event lands on its exact sample
+#define MIN_SUBBLOCK_FRAMES      1
+
 struct MyVstEvents
 {
     VstInt32 numEvents;
@@ -113,17 +160,25 @@ public:
    virtual void preProcess();
    virtual void postProcess();
 
+   virtual void setSampleRate( float sampleRate);
+   virtual void resume();
+
    // Program
    virtual void setProgram( VstInt32 program);
    virtual void setProgramName( char* name);
    virtual void getProgramName( char* name);
    virtual bool getProgramNameIndexed( VstInt32 category, VstInt32 index, char* text);
 
+   // the bank or the current program as one binary chunk
+   virtual VstInt32 getChunk( void** data, bool isPreset = false);
+   virtual VstInt32 setChunk( void* data, VstInt32 byteSize, bool isPreset = false);
+
    // Parameters
    virtual void setParameter( VstInt32 index, float value);
    virtual float getParameter( VstInt32 index);
    virtual void getParameterDisplay( VstInt32 index, char* text);
    virtual void getParameterName( VstInt32 index, char* text);
+   virtual bool getParameterProperties( VstInt32 index, VstParameterProperties* p);
 
    virtual bool getInputProperties (VstInt32 index, VstPinProperties* properties);
    virtual bool getOutputProperties (VstInt32 index, VstPinProperties* properties);
@@ -133,9 +188,28 @@ public:
    virtual bool getProductString( char* text);
    virtual VstInt32 getVendorVersion();
    virtual VstInt32 canDo( char* text);
+   virtual VstIntPtr vendorSpecific( VstInt32 lArg, VstIntPtr lArg2, void* ptrArg, float floatArg);
+
+   // the bank, after a change of the current program setProgram() loads it
+   MeeblipVST_ProgramBank& getPrograms()     { return programs; }
+
+   // the whole bank, not on the audio thread. A bank chunk is the data of
+   // getChunk(), the current program is loaded again after a change
+
+   // the number of programs which differ from the chunk, -1 if it is no
+   // bank chunk. A host can show that the bank was changed since it was
+   // saved
+   VstInt32 compareBank( const void* data, VstInt32 byteSize);
+
+   // the bank between its values( amount 0) and those of the chunk( 1)
+   bool morphBank( const void* data, VstInt32 byteSize, float amount);
+
+   // random offsets of up to +-amount * 64 to all gui parameters of all
+   // programs, the same seed gives the same bank
+   void randomizeBank( unsigned int seed, float amount);
 
 private:
-   MeeblipVSTProgram* programs;
+   MeeblipVST_ProgramBank programs;
 
    VstInt32 float2KnobValue( float value, VstInt32 index);
    float KnobValue2float( VstInt32 intVal, VstInt32 index);
@@ -144,17 +218,85 @@ protected:
    float parameters[ kNumGuiParameters];
    char programName[ kVstMaxProgNameLen + 1];
 
+   MeeblipVST_Engine engine;     // software meeblip voice
+
+   void updateParameter( VstInt32 index, float value, bool sendCC);
+   void storeExtraParameter( VstInt32 index, float value);
+   void applyParameter( VstInt32 index, float value, bool sendCC, VstInt32 deltaFrames);
+   void applyParameterChange( const MeeblipVST_ParamChange& change, VstInt32 deltaFrames)
+   {
+      applyParameter( change.index, change.value, (change.flags & kParamSendCC) != 0, deltaFrames);
+   }
+
+   MeeblipVST_ParamQueue paramQueue;
+
+   // setProgram(), setChunk() and the sysex dumps load a parameter set,
+   // the changed parameters reach the engine at the same sample. midiOut
+   // false: no CCs to the hardware. deltaFrames is the sample in the
+   // current block, used on the audio thread
+   void loadParameters( const float* values, bool extra, bool midiOut = true, VstInt32 deltaFrames = 0);
+
+   // setProgram() and the midi program change at its deltaFrames
+   void loadProgram( VstInt32 program, VstInt32 deltaFrames);
+
+   MeeblipVST_ProgramBank* readBankChunk( const void* data, VstInt32 byteSize);
+   void refreshEditor();
+
+   unsigned char* chunk;         // kBankChunkSize, returned by getChunk()
+
 // --------------------------------------------------------------------------
 // midi support
 // --------------------------------------------------------------------------
 
 public:
-   tresult sendMidiCC( ParamID paramId, int32 midiValue);
+   tresult sendMidiCC( ParamID paramId, int32 midiValue, VstInt32 deltaFrames = 0);
+
+   void setMinSubBlock( VstInt32 frames) { minSubBlock = frames > 1 ? frames : 1; }
+
+   // byte rate of the CCs and sysex messages to the hardware, 0: no limit
+   void setMidiOutRate( float bytesPerSecond) { midiLink.setBytesPerSecond( bytesPerSecond); }
+   MeeblipVST_CCOutput& getCCOutput()         { return ccOutput; }
+
+   // incoming CC to parameter assignment, for midi learn
+   MeeblipVST_CCMap& getCCMap()               { return ccMap; }
+
+   // any thread. The next CC received is assigned to parameter, < 0
+   // cancels
+   void startMidiLearn( VstInt32 parameter);
+   VstInt32 getMidiLearn()                    { return aweAtomicLoad( &learnParameter); }
+
+   // sysex transfers with the hardware, any thread, or effVendorSpecific
+   // PLUG_VENDOR_REQUEST / PLUG_VENDOR_SEND. program < 0 is the whole
+   // bank. The dumps the hardware sends back are stored in the bank
+   void requestSysexDump( VstInt32 program = -1)  { sysexSender.request( program); }
+   void sendSysexDump( VstInt32 program = -1)     { sysexSender.send( program); }
+   MeeblipVST_SysexSender& getSysexSender()       { return sysexSender; }
+   MeeblipVST_SysexReceiver& getSysexReceiver()   { return sysexReceiver; }
 
 protected:
    bool midiEnable;
    float fMidiInChannel;
    float fMidiOutChannel;
+   VstInt32 minSubBlock;
+   VstInt32 blockFrames;         // size of the current block, for postProcess()
+
+   MeeblipVST_MidiLink midiLink; // the CCs and sysex messages share the cable
+   MeeblipVST_CCOutput ccOutput;
+   MeeblipVST_CCMap ccMap;
+   volatile int32 learnParameter;   // -1: no midi learn
+
+// --------------------------------------------------------------------------
+// voice pool of the software engine
+// --------------------------------------------------------------------------
+
+protected:
+   float fPolyphony;
+   float fVoiceMode;
+   float fStealMode;
+   float fEngineMode;
+   float fOversampling;          // used at resume()
+   float fOfflineOversampling;
+   float fRenderThreads;         // used at resume()
 
 // ------------------------------------
 //
@@ -182,33 +324,69 @@ public:
 
 protected:
    bool init();
-   virtual void processMidiEvents(VstMidiEventVec *inputs, VstMidiEventVec *outputs, VstInt32 sampleFrames);
-   virtual void processMidiSysexEvents( VstSysexEventVec *inputs, VstSysexEventVec *outputs, VstInt32 sampleFrames);
+   virtual void processMidiEvent( const VstMidiEvent& event);
+   virtual void processMidiSysexEvents( VstSysexEventQueue *inputs, VstSysexEventQueue *outputs, VstInt32 sampleFrames);
+
+   void copySysex( const VstMidiSysexEvent& event);
+   void receiveSysexDump( const MeeblipVST_SysexDump& dump);
+   void sendSysex( VstInt32 sampleFrames);
 
-   void copySysex();
+   template <typename FloatType>
+   void processBlock( FloatType** inputs, FloatType** outputs, VstInt32 sampleFrames);
 
-   VstMidiEventVec *_midiEventsIn;
-   VstSysexEventVec *_midiSysexEventsIn;
+   template <typename FloatType>
+   bool checkSilence( FloatType** inputs, VstInt32 sampleFrames);
+
+   bool silent;                  // the last block was skipped, see processBlock()
+
+   VstMidiEventQueue *_midiEventsIn;
+   VstSysexEventQueue *_midiSysexEventsIn;
    void _cleanMidiInBuffers();
 
-   VstMidiEventVec *_midiEventsOut;
-   VstSysexEventVec *_midiSysexEventsOut;
+   VstMidiEventQueue *_midiEventsOut;
+   VstSysexEventQueue *_midiSysexEventsOut;
    void _cleanMidiOutBuffers();
 
+   // the payloads of the sysex queues. The output alternates between two
+   // arenas, the events sent to the host stay valid during the next block
+   MeeblipVST_SysexArena sysexIn;
+   MeeblipVST_SysexArena sysexOut[ 2];
+   VstInt32 sysexOutArena;
+
+   MeeblipVST_SysexReceiver sysexReceiver;
+   MeeblipVST_SysexSender sysexSender;
+
+   // events dropped because a queue was full
+   VstInt32 getMidiOverflows();
+   VstInt32 reportedOverflows;
+
+   bool tracing;                 // this instance started aweTrace
+
    MyVstEvents  *_vstEventsToHost;
    VstMidiEvent *_vstMidiEventsToHost;
    VstMidiSysexEvent *_vstSysexEventsToHost;
 
    int numinputs, numoutputs, bottomOctave;
 
-   static bool midiSort(VstMidiEvent first, VstMidiEvent second)
+   template <typename Event>
+   static bool midiSort(const Event& first, const Event& second)
    {
       return first.deltaFrames < second.deltaFrames;
    }
 
-   static void sortMidiEvents(VstMidiEventVec _vec)
+   // insertion sort, stable and without allocation. The host mostly
+   // delivers the events sorted already
+   template <typename Event>
+   static void sortMidiEvents(aweRingBuffer<Event>& _vec)
    {
-      std::stable_sort( _vec.begin(), _vec.end(), midiSort );
+      for( unsigned int i = 1; i < _vec.size(); i++)
+      {
+         Event event = _vec[i];
+         unsigned int j = i;
+         for( ; j > 0 && midiSort( event, _vec[j-1]); j--)
+            _vec[j] = _vec[j-1];
+         _vec[j] = event;
+      }
    }
 
 };
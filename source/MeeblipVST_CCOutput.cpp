@@ -0,0 +1,135 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_CCOutput.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   paced by the shared MeeblipVST_MidiLink
+//    17.10.2026  AWe   the event is cleared with memset()
+//    17.10.2026  AWe   coalesce and pace the CC messages to the hardware
+//
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST_CCOutput.h"
+
+#include <string.h>
+
+// --------------------------------------------------------------------------
+// Debug support
+// --------------------------------------------------------------------------
+
+#define VERBOSITY       99
+#define VERBOSITY_MIN   1
+
+#include "aweDBG.h"
+
+#define MIDI_CONTROLCHANGE   0xB0
+
+// --------------------------------------------------------------------------
+//  MeeblipVST_CCOutput Implementation
+// --------------------------------------------------------------------------
+
+MeeblipVST_CCOutput::MeeblipVST_CCOutput()
+   : numPending( 0)
+   , coalesced( 0)
+   , unchanged( 0)
+   , deferred( 0)
+   , sent( 0)
+{
+   memset( pendingValue, -1, sizeof( pendingValue));
+   memset( pendingDelta, 0, sizeof( pendingDelta));
+   forget();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_CCOutput::forget()
+{
+   memset( lastSent, -1, sizeof( lastSent));
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_CCOutput::add( VstInt32 channel, VstInt32 controller, VstInt32 value, VstInt32 deltaFrames)
+{
+   channel &= 0x0f;
+   controller &= 0x7f;
+   value &= 0x7f;
+
+   if( pendingValue[ channel][ controller] >= 0)
+      coalesced++;
+   else
+      pending[ numPending++] = (short)(channel * kNumControllers + controller);
+
+   pendingValue[ channel][ controller] = (signed char)value;
+   pendingDelta[ channel][ controller] = deltaFrames;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// Every message occupies the link for its kCCMessageBytes. A message is
+// sent at its deltaFrames or, if the link is still busy, when it becomes
+// free. So the events leave in ascending order of deltaFrames.
+
+void MeeblipVST_CCOutput::process( VstInt32 sampleFrames, MeeblipVST_MidiLink& link, aweRingBuffer<VstMidiEvent>& output)
+{
+   VstInt32 i = 0;
+
+   for( ; i < numPending; i++)
+   {
+      VstInt32 channel    = pending[i] / kNumControllers;
+      VstInt32 controller = pending[i] % kNumControllers;
+      signed char value   = pendingValue[ channel][ controller];
+
+      if( value == lastSent[ channel][ controller])
+      {
+         unchanged++;
+         pendingValue[ channel][ controller] = -1;
+         continue;
+      }
+
+      double frame = link.getFreeFrame( pendingDelta[ channel][ controller]);
+
+      if( frame >= sampleFrames || output.full())
+         break;
+
+      VstMidiEvent event;
+      memset( &event, 0, sizeof( event));
+      event.type        = kVstMidiType;
+      event.byteSize    = sizeof( VstMidiEvent);
+      event.deltaFrames = (VstInt32)frame;
+      event.midiData[0] = (char)(MIDI_CONTROLCHANGE + channel);
+      event.midiData[1] = (char)controller;
+      event.midiData[2] = (char)value;
+      output.push( event);
+
+      lastSent[ channel][ controller] = value;
+      pendingValue[ channel][ controller] = -1;
+      link.occupy( frame, kCCMessageBytes);
+      sent++;
+   }
+
+   // the rest waits for the next block, at its start
+   VstInt32 n = 0;
+   for( ; i < numPending; i++)
+   {
+      VstInt32 channel    = pending[i] / kNumControllers;
+      VstInt32 controller = pending[i] % kNumControllers;
+
+      pendingDelta[ channel][ controller] = 0;
+      pending[ n++] = pending[i];
+      deferred++;
+   }
+   numPending = n;
+}
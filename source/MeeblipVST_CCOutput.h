@@ -0,0 +1,88 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_CCOutput.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   the link is a MeeblipVST_MidiLink, shared with the sysex
+//                      sender
+//    17.10.2026  AWe   coalesce and pace the CC messages to the hardware
+//
+// --------------------------------------------------------------------------
+
+#ifndef __MeeblipVST_CCOutput__
+#define __MeeblipVST_CCOutput__
+
+#include "MeeblipVST_MidiLink.h"
+#include "aweRingBuffer.h"
+#include "pluginterfaces/vst2.x/aeffectx.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+enum
+{
+   kNumMidiChannels    = 16,
+   kNumControllers     = 128,
+   kCCMessageBytes     = 3
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_CCOutput
+// --------------------------------------------------------------------------
+
+// Collects the CC messages for the hardware and sends them in postProcess():
+//
+// - per controller only the latest value is kept until it is sent
+// - a value equal to the last one sent to this controller is dropped
+// - the messages are spread over the block so that the byte rate of the
+//   link stays below its budget( DIN MIDI by default). The link is shared
+//   with the sysex messages. What does not fit into the block is sent in
+//   the next block, the order of the controllers is kept
+//
+// Everything is preallocated, add() and process() run on the audio thread.
+
+class MeeblipVST_CCOutput
+{
+public:
+   MeeblipVST_CCOutput();
+
+   // forget the values sent before, e.g. after the hardware was reconnected
+   void forget();
+
+   void add( VstInt32 channel, VstInt32 controller, VstInt32 value, VstInt32 deltaFrames);
+
+   // move the messages which fit on the link within the next sampleFrames
+   // to output. The caller ends the block of the link
+   void process( VstInt32 sampleFrames, MeeblipVST_MidiLink& link, aweRingBuffer<VstMidiEvent>& output);
+
+   VstInt32 getNumPending()      { return numPending; }
+
+   // suppression counters since the start
+   VstInt32 getCoalesced()       { return coalesced; }      // replaced by a newer value
+   VstInt32 getUnchanged()       { return unchanged; }      // value was already sent
+   VstInt32 getDeferred()        { return deferred; }       // moved to a later block
+   VstInt32 getSent()            { return sent; }
+
+protected:
+   signed char lastSent[ kNumMidiChannels][ kNumControllers];       // -1: unknown
+   signed char pendingValue[ kNumMidiChannels][ kNumControllers];   // -1: nothing pending
+   VstInt32 pendingDelta[ kNumMidiChannels][ kNumControllers];
+
+   // pending controllers in the order of their first change, channel * 128 + cc
+   short pending[ kNumMidiChannels * kNumControllers];
+   VstInt32 numPending;
+
+   VstInt32 coalesced;
+   VstInt32 unchanged;
+   VstInt32 deferred;
+   VstInt32 sent;
+};
+
+#endif // __MeeblipVST_CCOutput__
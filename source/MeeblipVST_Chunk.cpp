@@ -0,0 +1,140 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Chunk.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   putBytes()
+//    17.10.2026  AWe   versioned binary chunk of the program bank for
+//                      getChunk() / setChunk()
+//
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST_Chunk.h"
+
+#include <string.h>
+
+// --------------------------------------------------------------------------
+// Debug support
+// --------------------------------------------------------------------------
+
+#define VERBOSITY       99
+#define VERBOSITY_MIN   1
+
+#include "aweDBG.h"
+
+// --------------------------------------------------------------------------
+//  MeeblipVST_ChunkWriter Implementation
+// --------------------------------------------------------------------------
+
+void MeeblipVST_ChunkWriter::putInt32( VstInt32 value)
+{
+   uint32 bits = (uint32)value;
+
+   pos[0] = (unsigned char)( bits);
+   pos[1] = (unsigned char)( bits >> 8);
+   pos[2] = (unsigned char)( bits >> 16);
+   pos[3] = (unsigned char)( bits >> 24);
+   pos += 4;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_ChunkWriter::putFloat( float value)
+{
+   VstInt32 bits;
+   memcpy( &bits, &value, sizeof( bits));
+   putInt32( bits);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// size bytes, the name is cut or padded with zeros
+
+void MeeblipVST_ChunkWriter::putName( const char* name, VstInt32 size)
+{
+   VstInt32 length = (VstInt32)strlen( name);
+   if( length > size)
+      length = size;
+
+   memcpy( pos, name, length);
+   memset( pos + length, 0, size - length);
+   pos += size;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_ChunkWriter::putBytes( const void* bytes, VstInt32 size)
+{
+   memcpy( pos, bytes, size);
+   pos += size;
+}
+
+// --------------------------------------------------------------------------
+//  MeeblipVST_ChunkReader Implementation
+// --------------------------------------------------------------------------
+
+bool MeeblipVST_ChunkReader::getInt32( VstInt32& value)
+{
+   if( end - pos < 4)
+      return false;
+
+   value = (VstInt32)( (uint32)pos[0] | ( (uint32)pos[1] << 8) | ( (uint32)pos[2] << 16) | ( (uint32)pos[3] << 24));
+   pos += 4;
+   return true;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+bool MeeblipVST_ChunkReader::getFloat( float& value)
+{
+   VstInt32 bits;
+   if( !getInt32( bits))
+      return false;
+
+   memcpy( &value, &bits, sizeof( value));
+   return true;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// name gets size + 1 bytes, always terminated
+
+bool MeeblipVST_ChunkReader::getName( char* name, VstInt32 size)
+{
+   if( end - pos < size)
+      return false;
+
+   memcpy( name, pos, size);
+   name[ size] = 0;
+   pos += size;
+   return true;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+bool MeeblipVST_ChunkReader::seek( VstInt32 offset)
+{
+   if( offset < 0 || offset > end - data)
+      return false;
+
+   pos = data + offset;
+   return true;
+}
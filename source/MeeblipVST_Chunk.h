@@ -0,0 +1,111 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Chunk.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   putBytes(), the writer is used for the patch library too
+//    17.10.2026  AWe   versioned binary chunk of the program bank for
+//                      getChunk() / setChunk()
+//
+// --------------------------------------------------------------------------
+
+#ifndef __MeeblipVST_Chunk__
+#define __MeeblipVST_Chunk__
+
+#include "aweVSTtypes.h"
+#include "pluginterfaces/vst2.x/aeffect.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// The chunk is the bank or a single program( isPreset), all values little
+// endian:
+//
+//    header
+//       int32    magic          'MBch'
+//       int32    version        kChunkVersion
+//       int32    headerSize     bytes up to the first program
+//       int32    numPrograms    kNumPrograms, 1 for a preset
+//       int32    curProgram
+//       int32    numParameters  kNumGuiParameters
+//       int32    numExtra       kNumExtraParameters
+//       int32    programSize    bytes of one program
+//       float    extra[ numExtra]           midi channels, voices, engine
+//    program[ numPrograms]
+//       char     name[ kVstMaxProgNameLen]  zero padded
+//       float    parameters[ numParameters]
+//       float    midiInChannel
+//       float    midiOutChannel
+//
+// A newer version only appends to the header, to the extra parameters or
+// to a program. The sizes and counts in the header let an older plugin
+// skip what it doesn't know, a missing value keeps its current one.
+
+enum
+{
+   kChunkMagic          = CCONST( 'M', 'B', 'c', 'h'),
+   kChunkVersion        = 1,
+   kChunkHeaderFields   = 8
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_ChunkWriter
+// --------------------------------------------------------------------------
+
+class MeeblipVST_ChunkWriter
+{
+public:
+   MeeblipVST_ChunkWriter( unsigned char* data) : data( data), pos( data) {}
+
+   void putInt32( VstInt32 value);
+   void putFloat( float value);
+   void putName( const char* name, VstInt32 size);
+   void putBytes( const void* bytes, VstInt32 size);
+
+   VstInt32 getSize()               { return (VstInt32)( pos - data); }
+
+protected:
+   unsigned char* data;
+   unsigned char* pos;
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_ChunkReader
+// --------------------------------------------------------------------------
+
+// reads behind the end of the data return false and leave the value as it
+// is
+
+class MeeblipVST_ChunkReader
+{
+public:
+   MeeblipVST_ChunkReader( const void* data, VstInt32 size)
+      : data( (const unsigned char*)data)
+      , pos( (const unsigned char*)data)
+      , end( (const unsigned char*)data + ( size > 0 ? size : 0))
+   {}
+
+   bool getInt32( VstInt32& value);
+   bool getFloat( float& value);
+   bool getName( char* name, VstInt32 size);
+
+   VstInt32 getOffset()             { return (VstInt32)( pos - data); }
+   VstInt32 getLeft()               { return (VstInt32)( end - pos); }
+
+   // to an offset from the start, false if it is outside of the data
+   bool seek( VstInt32 offset);
+
+protected:
+   const unsigned char* data;
+   const unsigned char* pos;
+   const unsigned char* end;
+};
+
+#endif // __MeeblipVST_Chunk__
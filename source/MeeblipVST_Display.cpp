@@ -0,0 +1,207 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Display.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   names and display strings of at most 7 characters, engine
+//                      mode "Fixed", steal modes "Quiet" and "Same", the full
+//                      names in longNames[]
+//    17.10.2026  AWe   engine mode "Fixed Point" instead of "Firmware"
+//    17.10.2026  AWe   OSC_DETUNE in cents, append() copies at most strlen( src)
+//    17.10.2026  AWe   add the number of render threads
+//    17.10.2026  AWe   add the oversampling factors
+//    17.10.2026  AWe   add the engine mode to the extra parameters
+//    17.10.2026  AWe   precomputed display strings and names of all
+//                      parameters, shared by all instances
+//
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST_Display.h"
+
+#include <string.h>
+
+// --------------------------------------------------------------------------
+// Debug support
+// --------------------------------------------------------------------------
+
+#define VERBOSITY       99
+#define VERBOSITY_MIN   1
+
+#include "aweDBG.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+char MeeblipVST_Display::strings[ kNumDisplayStrings][ kDisplayStrLen];
+char MeeblipVST_Display::names[ kNumGuiParameters + kNumExtraParameters][ kVstMaxParamStrLen];
+const char* MeeblipVST_Display::longNames[ kNumGuiParameters + kNumExtraParameters];
+int32 MeeblipVST_Display::base[ kNumGuiParameters + kNumExtraParameters];
+
+static const char* units[ kNumGuiParameters] =
+{
+#define MEEBLIP_PARAM_UNIT( id, name, shortName, kind, cc, dflt, x, y, unit, smooth, ms)   unit,
+   MEEBLIP_GUI_PARAMETERS( MEEBLIP_PARAM_UNIT)
+#undef MEEBLIP_PARAM_UNIT
+};
+
+// all strings below have at most kVstMaxParamStrLen - 1 characters, except
+// the full names
+static const char* extraNames[ kNumExtraParameters] = { "Midi In Channel", "Midi Out Channel", "Voices", "Voice Mode", "Steal Mode", "Engine",
+                                                        "Oversampling", "Offline Oversampling", "Render Threads" };
+static const char* extraShortNames[ kNumExtraParameters] = { "Midi In", "MidiOut", "Voices", "Mode", "Steal", "Engine", "Ovrsmpl", "OfflnOS", "Threads" };
+static const char* voiceModeNames[ kNumVoiceModes] = { "Poly", "Mono", "Legato" };
+static const char* stealModeNames[ kNumStealModes] = { "Oldest", "Quiet", "Same" };
+static const char* engineModeNames[ kNumEngineModes] = { "Modern", "Fixed" };
+static const char* oversampleNames[ kNumOversampleFactors] = { "1x", "2x", "4x", "8x" };
+
+// the table is built while the plugin is loaded, before any instance exists
+static struct DisplayInit
+{
+   DisplayInit()  { MeeblipVST_Display::init(); }
+} displayInit;
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// append src, the result is always terminated
+static void append( char* text, const char* src, VstInt32 size)
+{
+   VstInt32 len = (VstInt32)strlen( text);
+   VstInt32 count = (VstInt32)strlen( src);
+
+   if( count > size - 1 - len)
+      count = size - 1 - len;
+   if( count > 0)
+      memcpy( text + len, src, count);
+   text[ len + ( count > 0 ? count : 0)] = 0;
+}
+
+// decimal, independent from the locale
+static void formatInt( char* text, VstInt32 value, const char* unit, VstInt32 size)
+{
+   char digits[ 12];
+   VstInt32 n = 0;
+   VstInt32 len = 0;
+   VstInt32 magnitude = value < 0 ? -value : value;
+
+   do
+   {
+      digits[ n++] = (char)( '0' + magnitude % 10);
+      magnitude /= 10;
+   } while( magnitude);
+
+   if( value < 0)
+      text[ len++] = '-';
+   while( n)
+      text[ len++] = digits[ --n];
+   text[ len] = 0;
+
+   append( text, unit, size);
+}
+
+// --------------------------------------------------------------------------
+//  MeeblipVST_Display Implementation
+// --------------------------------------------------------------------------
+
+void MeeblipVST_Display::init()
+{
+   static bool initialized = false;
+   if( initialized)
+      return;
+
+   VstInt32 next = 0;
+
+   for( VstInt32 index = 0; index < kNumGuiParameters; index++)
+   {
+      const MeeblipVST_LayoutItem* layoutItem = getLayoutItem( index);
+
+      base[ index] = next - layoutItem->minValue;
+
+      for( VstInt32 value = layoutItem->minValue; value <= layoutItem->maxValue; value++, next++)
+      {
+         strings[ next][ 0] = 0;
+         if( layoutItem->stepCount == 1)
+         {
+            append( strings[ next], value ? "On" : "Off", kDisplayStrLen);
+            append( strings[ next], units[ index], kDisplayStrLen);
+         }
+         else if( index == kOscDetune)
+         {
+            // the engine detunes by value / 64 semitones, shown in cents
+            VstInt32 cents = ( value * 100 + ( value < 0 ? -32 : 32)) / 64;
+            formatInt( strings[ next], cents, units[ index], kDisplayStrLen);
+         }
+         else
+            formatInt( strings[ next], value, units[ index], kDisplayStrLen);
+      }
+
+      names[ index][ 0] = 0;
+      append( names[ index], layoutItem->shortName, kVstMaxParamStrLen);
+      longNames[ index] = layoutItem->parameterName;
+   }
+
+   // midi channels are shown as 1..16
+   for( VstInt32 index = kMidiInChannel; index <= kMidiOutChannel; index++)
+   {
+      base[ index] = next;
+      for( VstInt32 channel = 0; channel < 16; channel++, next++)
+         formatInt( strings[ next], channel + 1, "", kDisplayStrLen);
+   }
+
+   base[ kPolyphony] = next - 1;
+   for( VstInt32 voices = 1; voices <= kMaxVoices; voices++, next++)
+      formatInt( strings[ next], voices, "", kDisplayStrLen);
+
+   base[ kVoiceMode] = next;
+   for( VstInt32 mode = 0; mode < kNumVoiceModes; mode++, next++)
+   {
+      strings[ next][ 0] = 0;
+      append( strings[ next], voiceModeNames[ mode], kDisplayStrLen);
+   }
+
+   base[ kStealMode] = next;
+   for( VstInt32 mode = 0; mode < kNumStealModes; mode++, next++)
+   {
+      strings[ next][ 0] = 0;
+      append( strings[ next], stealModeNames[ mode], kDisplayStrLen);
+   }
+
+   base[ kEngineMode] = next;
+   for( VstInt32 mode = 0; mode < kNumEngineModes; mode++, next++)
+   {
+      strings[ next][ 0] = 0;
+      append( strings[ next], engineModeNames[ mode], kDisplayStrLen);
+   }
+
+   for( VstInt32 index = kOversampling; index <= kOfflineOversampling; index++)
+   {
+      base[ index] = next;
+      for( VstInt32 factor = 0; factor < kNumOversampleFactors; factor++, next++)
+      {
+         strings[ next][ 0] = 0;
+         append( strings[ next], oversampleNames[ factor], kDisplayStrLen);
+      }
+   }
+
+   base[ kRenderThreads] = next - 1;
+   for( VstInt32 threads = 1; threads <= kMaxRenderThreads; threads++, next++)
+      formatInt( strings[ next], threads, "", kDisplayStrLen);
+
+   for( VstInt32 i = 0; i < kNumExtraParameters; i++)
+   {
+      names[ kNumGuiParameters + i][ 0] = 0;
+      append( names[ kNumGuiParameters + i], extraShortNames[ i], kVstMaxParamStrLen);
+      longNames[ kNumGuiParameters + i] = extraNames[ i];
+   }
+
+   DBG( 2, "MeeblipVST_Display::init %d strings", next);
+   initialized = true;
+}
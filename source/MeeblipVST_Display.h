@@ -0,0 +1,99 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Display.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   short names and display strings fit into
+//                      kVstMaxParamStrLen, the full names are kept for
+//                      getParameterProperties()
+//    17.10.2026  AWe   include MeeblipVST_FixedPoint.h
+//    17.10.2026  AWe   add the number of render threads
+//    17.10.2026  AWe   add the oversampling factors
+//    17.10.2026  AWe   add the engine mode to the extra parameters
+//    17.10.2026  AWe   precomputed display strings and names of all
+//                      parameters, shared by all instances
+//
+// --------------------------------------------------------------------------
+
+#ifndef __MeeblipVST_Display__
+#define __MeeblipVST_Display__
+
+#include "MeeblipVST_Engine.h"
+#include "MeeblipVST_FixedPoint.h"
+#include "MeeblipVST_Layout.h"
+#include "MeeblipVST_Oversampler.h"
+#include "MeeblipVST_Voices.h"
+#include "aweVSTtypes.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// number of display strings of the gui parameters, one per knob value
+#define MEEBLIP_COUNT_STRINGS( id, name, shortName, kind, cc, dflt, x, y, unit, smooth, ms) \
+   + ( MEEBLIP_MAX_##kind - MEEBLIP_MIN_##kind + 1)
+
+enum
+{
+   kNumGuiStrings   = 0 MEEBLIP_GUI_PARAMETERS( MEEBLIP_COUNT_STRINGS),
+   kNumExtraStrings = 16 + 16 + kMaxVoices + kNumVoiceModes + kNumStealModes + kNumEngineModes
+                    + 2 * kNumOversampleFactors + kMaxRenderThreads,
+   kNumDisplayStrings = kNumGuiStrings + kNumExtraStrings,
+
+   kDisplayStrLen   = kVstMaxParamStrLen   // incl. terminating zero
+};
+
+#undef MEEBLIP_COUNT_STRINGS
+
+// --------------------------------------------------------------------------
+// MeeblipVST_Display
+// --------------------------------------------------------------------------
+
+// All strings the host asks for are generated once, when the plugin is
+// loaded, into one flat table. The names and the display strings fit into
+// the kVstMaxParamStrLen buffers of the host, the full names are served
+// separately. A lookup is an index calculation, no formatting and no locale
+// dependency. The value is
+//    gui parameters    the knob value, minValue..maxValue
+//    midi channels     0..15
+//    polyphony         1..kMaxVoices
+//    voice/steal/engine mode  the mode
+//    oversampling      0..3 for 1x..8x
+//    render threads    1..kMaxRenderThreads
+
+class MeeblipVST_Display
+{
+public:
+   static const char* getDisplay( VstInt32 index, VstInt32 value)
+   {
+      return strings[ base[ index] + value];
+   }
+
+   // at most kVstMaxParamStrLen - 1 characters
+   static const char* getName( VstInt32 index)
+   {
+      return names[ index];
+   }
+
+   // the full name, for getParameterProperties()
+   static const char* getLongName( VstInt32 index)
+   {
+      return longNames[ index];
+   }
+
+   static void init();
+
+private:
+   static char strings[ kNumDisplayStrings][ kDisplayStrLen];
+   static char names[ kNumGuiParameters + kNumExtraParameters][ kVstMaxParamStrLen];
+   static const char* longNames[ kNumGuiParameters + kNumExtraParameters];
+   static int32 base[ kNumGuiParameters + kNumExtraParameters];   // index of value 0 in strings[]
+};
+
+#endif // __MeeblipVST_Display__
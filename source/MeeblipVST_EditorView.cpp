@@ -9,6 +9,7 @@
 // --------------------------------------------------------------------------
 // Changelog
 //
+//    17.10.2026  AWe   idle() updates all controls after a program change
 //    29.01.2014  AWe   set initial values for gui elements from layout structure
 //    23.01.2014  AWe   in setParameter() correct calculation of stepcount interval
 //    11.09.2013  AWe   adapted to use vstsdk2.4 from VST3 SDK and vstqui4
@@ -52,6 +53,7 @@ AEffGUIEditor* createEditor( AudioEffectX* effect)
 
 MeeblipVST_EditorView::MeeblipVST_EditorView( void* ptr)
    : AEffGUIEditor( ptr)
+   , refreshPending( 0)
 {
    DBG( 1, "\nMeeblipVST_EditorView::MeeblipVST_EditorView" );
 }
@@ -87,7 +89,7 @@ bool MeeblipVST_EditorView::open( void* parent)
 
    for( ParamID paramId = 0; paramId < kNumGuiParameters; paramId++)
    {
-      MeeblipVST_LayoutItem *layoutItem = &MeeblipVST_Layout[ paramId];
+      const MeeblipVST_LayoutItem *layoutItem = &MeeblipVST_Layout[ paramId];
       DBG2( 3, " ParamId %d", paramId );
 
       GuiItemId guiItem = layoutItem->guiItem;
@@ -194,6 +196,28 @@ void MeeblipVST_EditorView::setParameter( VstInt32 index, float value)
 //
 // --------------------------------------------------------------------------
 
+// a program change sets all controls at once, on the gui thread, then the
+// host reads the parameters and the program name again
+
+void MeeblipVST_EditorView::idle()
+{
+   if( aweAtomicExchange( &refreshPending, 0))
+   {
+      DBG( 1, "\nMeeblipVST_EditorView::idle refresh" );
+
+      for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+         setParameter( i, effect->getParameter( i));
+
+      ( (AudioEffectX*)effect)->updateDisplay();
+   }
+
+   AEffGUIEditor::idle();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
 void  MeeblipVST_EditorView::placeElement( ParamID paramId, CFrame* frame, GuiItemId guiItemId, int32 x, int32 y)
 {
    DBG( 1, "\nMeeblipVST_EditorView::placeElement %d", paramId );
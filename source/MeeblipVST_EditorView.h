@@ -9,6 +9,7 @@
 // --------------------------------------------------------------------------
 // Changelog
 //
+//    17.10.2026  AWe   add refresh(), all controls are updated in idle()
 //    11.09.2013  AWe   adapted to use vstsdk2.4 from VST3 SDK and vstqui4
 //    19.08.2013  AWe   distinguish gui and non-gui parameters and controls
 //    01.08.2013  AWe   add changes from meeblip VST3 projoct( v0.4)
@@ -23,6 +24,7 @@
 
 #include "vstgui/plugin-bindings/aeffguieditor.h"
 #include "aweVSTtypes.h"
+#include "aweAtomic.h"
 
 #include "MeeblipVST_Layout.h"
 
@@ -39,6 +41,10 @@ public:
    bool open( void* ptr);
    void close();
    void setParameter( VstInt32 index, float value);
+   void idle();
+
+   // any thread, the controls take the values of the plugin in the next idle()
+   void refresh()                { aweAtomicStore( &refreshPending, 1); }
 
    // from CControlListener
    void valueChanged( CControl* pControl);
@@ -50,6 +56,8 @@ protected:
 
    CControl* guiControls[ kNumGuiParameters];
 
+   volatile int32 refreshPending;
+
    void placeElement( ParamID paramId, CFrame* frame, GuiItemId guiItemId, int32 x, int32 y);
 };
 
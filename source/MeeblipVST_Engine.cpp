@@ -0,0 +1,1129 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Engine.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   firmware symbols renamed to fixed point
+//    17.10.2026  AWe   the firmware mode is the fixed point mode, it is not an
+//                      emulation of the hardware. Members initialized in
+//                      the order of their declaration
+//    17.10.2026  AWe   a change of the voice mode releases all voices
+//    17.10.2026  AWe   render, decimation and mix in the sample type of the
+//                      host, processDoubleReplacing renders in double
+//    17.10.2026  AWe   render the lane groups in parallel with aweWorkerPool
+//    17.10.2026  AWe   optional 2x/4x/8x oversampling of the voices
+//    17.10.2026  AWe   firmware engine mode, fixed point voice like the AVR
+//    17.10.2026  AWe   oscillators read the shared band limited wavetables
+//    17.10.2026  AWe   CUTOFF, RESONANCE, PULSE_KNOB and VCFENVMOD are smoothed
+//                      at the control rate, the filter coefficients ramp in
+//                      between
+//    17.10.2026  AWe   render the voices with a SIMD kernel in lane groups
+//    17.10.2026  AWe   render up to kMaxVoices voices from MeeblipVST_VoicePool
+//    17.10.2026  AWe   software synthesis engine for the meeblip SE V2 voice
+//
+// References
+//    meeblip SE V2 user manual
+//    Andrew Simper, "Linear Trapezoidal Integrated State Variable Filter"
+//    Valimaki, Huovilainen, "Antialiasing Oscillators in Subtractive Synthesis"
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST_Engine.h"
+
+#include <math.h>
+#include <string.h>
+
+// --------------------------------------------------------------------------
+// Debug support
+// --------------------------------------------------------------------------
+
+#define VERBOSITY       99
+#define VERBOSITY_MIN   1
+
+#include "aweDBG.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static const float kPi             = 3.14159265358979f;
+static const float kMinCutoff      = 30.0f;   // Hz, cutoff knob at zero
+static const float kCutoffOctaves  = 9.2f;    // range of the cutoff knob
+static const float kLfoPitchRange  = 2.0f;    // semitones at full lfo level
+static const float kLfoFilterRange = 3.0f;    // octaves at full lfo level
+static const float kAttackTarget   = 1.5f;    // overshoot, attack ends at 1.0
+static const float kIdleLevel      = 1.0e-4f; // -80 dB, envelope is done
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the envelope times of the fixed point mode from the knob byte
+static float byteToTime( VstInt32 byte, float minTime, float maxTime)
+{
+   return minTime * powf( maxTime / minTime, byte / 255.0f);
+}
+
+// linear attack from zero to full scale in seconds
+static VstInt32 fixedAttack( float seconds, float controlRate)
+{
+   VstInt32 step = (VstInt32)( kFixedEnvMax / (seconds * controlRate) + 0.5f);
+   return step > 1 ? step : 1;
+}
+
+// exponential decay to -60 dB in seconds, 16 bit fraction of the level
+static VstInt32 fixedDecay( float seconds, float controlRate)
+{
+   VstInt32 k = (VstInt32)( 65536.0f * (1.0f - expf( -logf( 1000.0f) / (seconds * controlRate))) + 0.5f);
+   return k < 1 ? 1 : k > 0xffff ? 0xffff : k;
+}
+
+// 16 bit phase increment, the accumulator wraps at 65536
+static int16 pitchToIncrement( float pitch, float sampleRate)
+{
+   float inc = 65536.0f * 440.0f * powf( 2.0f, (pitch - 69.0f) / 12.0f) / sampleRate;
+   VstInt32 n = (VstInt32)( inc + 0.5f);
+   return (int16)( n < 1 ? 1 : n > 0x7fff ? 0x7fff : n);
+}
+
+// one control period of a fixed point envelope, linear attack and exponential
+// decay. The decay takes at least one step so the level reaches zero
+static VstInt32 stepEnvelope( VstInt32 level, VstInt32 stage, VstInt32 attack, VstInt32 decay)
+{
+   switch( stage)
+   {
+      case kEnvAttack:
+         level += attack;
+         return level < kFixedEnvMax ? level : kFixedEnvMax;
+
+      case kEnvHold:
+         return kFixedEnvMax;
+
+      case kEnvDecay:
+         level -= (VstInt32)( ( (uint32)level * (uint32)decay) >> 16) + 1;
+         return level > 0 ? level : 0;
+   }
+   return 0;
+}
+
+// the fixed point kernel of the same type, scalar if there is none
+static const MeeblipVST_FixedPointKernel* fixedPointKernelFor( VstInt32 type)
+{
+   const MeeblipVST_FixedPointKernel* k = getFixedPointKernel( type);
+   return k ? k : getFixedPointKernel( kKernelScalar);
+}
+
+// --------------------------------------------------------------------------
+//  MeeblipVST_Engine Implementation
+// --------------------------------------------------------------------------
+
+MeeblipVST_Engine::MeeblipVST_Engine()
+   : sampleRate( 44100.0f)
+   , baseRate( 44100.0f)
+   , pulseWidth( 0.5f)
+   , cutoff( 0.0f)
+   , envMod( 0.0f)
+   , damping( 2.0f)
+   , random( 0x1234567)
+   , kernel( getBestKernel())
+   , engineMode( kEngineModern)
+   , fixedPointKernel( fixedPointKernelFor( getBestKernel()->type))
+   , wavetables( NULL)
+   , numSegments( 0)
+   , renderFrames( 0)
+   , renderTarget( NULL)
+   , numTasks( 0)
+   , taskStride( kMaxRenderFrames)
+   , taskMix( NULL)
+{
+   DBG( 1, "\nMeeblipVST_Engine::MeeblipVST_Engine" );
+
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+      knob[i] = getLayoutItem( i)->defaultValue;
+
+   smoother.setOutput( kPulseKnob, &pulseWidth);
+   smoother.setOutput( kCutoff,    &cutoff);
+   smoother.setOutput( kVcfEnvMod, &envMod);
+   smoother.setOutput( kResonance, &damping);
+
+   setSampleRate( sampleRate);
+   reset();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+MeeblipVST_Engine::~MeeblipVST_Engine()
+{
+   pool.stop();
+   MeeblipVST_Wavetables::release( wavetables);
+   delete[] taskMix;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_Engine::setSampleRate( float sampleRate)
+{
+   DBG( 1, "\nMeeblipVST_Engine::setSampleRate %g", sampleRate );
+
+   baseRate = sampleRate;
+   sampleRate *= getOversampling();
+   this->sampleRate = sampleRate;
+
+   // the tables of the old rate stay as long as other instances use them
+   if( wavetables == NULL || wavetables->getSampleRate() != sampleRate)
+   {
+      const MeeblipVST_Wavetables* old = wavetables;
+      wavetables = MeeblipVST_Wavetables::acquire( sampleRate);
+      MeeblipVST_Wavetables::release( old);
+   }
+
+   smoother.setControlRate( sampleRate / kControlRate);
+
+   // all derived values depend on the sample rate
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+      setKnobValue( i, knob[i]);
+   smoother.finish();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the voices move to the new rate, all derived values and the wavetables
+// follow through setSampleRate()
+
+void MeeblipVST_Engine::setOversampling( VstInt32 factor)
+{
+   DBG( 1, "\nMeeblipVST_Engine::setOversampling %d", factor );
+
+   floatPath.oversampler.setFactor( factor, kMaxRenderFrames);
+   doublePath.oversampler.setFactor( factor, kMaxRenderFrames);
+   factor = getOversampling();
+
+   delete[] floatPath.oversample;
+   delete[] doublePath.oversample;
+   floatPath.oversample = NULL;
+   doublePath.oversample = NULL;
+   if( factor > 1)
+   {
+      floatPath.oversample = new float[ kMaxRenderFrames * factor];
+      doublePath.oversample = new double[ kMaxRenderFrames * factor];
+   }
+
+   allocateTaskBuffers();
+   setSampleRate( baseRate);
+   reset();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_Engine::setRenderThreads( VstInt32 threads)
+{
+   if( threads < 1)
+      threads = 1;
+   else if( threads > kMaxRenderThreads)
+      threads = kMaxRenderThreads;
+
+   if( threads == getRenderThreads())
+      return;
+
+   DBG( 1, "\nMeeblipVST_Engine::setRenderThreads %d", threads );
+
+   pool.start( threads - 1);
+   allocateTaskBuffers();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// every task renders into its own buffer, so the workers never write the
+// same cache lines
+
+void MeeblipVST_Engine::allocateTaskBuffers()
+{
+   delete[] floatPath.tasks;
+   delete[] doublePath.tasks;
+   delete[] taskMix;
+   floatPath.tasks = NULL;
+   doublePath.tasks = NULL;
+   taskMix = NULL;
+
+   taskStride = kMaxRenderFrames * getOversampling();
+   if( pool.getNumWorkers() > 0)
+   {
+      floatPath.tasks = new float[ kMaxVoices * taskStride];
+      doublePath.tasks = new double[ kMaxVoices * taskStride];
+      taskMix = new int32[ kMaxVoices * taskStride];
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_Engine::reset()
+{
+   DBG( 1, "\nMeeblipVST_Engine::reset" );
+
+   voices.reset();
+   smoother.finish();
+   floatPath.oversampler.reset();
+   doublePath.oversampler.reset();
+
+   // the silent lanes of a fixed point lane group render zero
+   memset( &fixed, 0, sizeof( fixed));
+
+   pwmPhase = 0.0f;
+   width    = pulseWidth;
+   lfoPhase = 0.0f;
+   lfoValue = 0.0f;
+   lfoOut   = 0.0f;
+
+   controlCount = 0;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+bool MeeblipVST_Engine::setKernel( VstInt32 type)
+{
+   const MeeblipVST_Kernel* k = ::getKernel( type);
+   if( k == NULL)
+      return false;
+
+   DBG( 1, "\nMeeblipVST_Engine::setKernel %s", k->name );
+
+   kernel = k;
+   fixedPointKernel = fixedPointKernelFor( type);
+   return true;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the voices of one mode can't continue in the other, all voices stop
+
+void MeeblipVST_Engine::setEngineMode( VstInt32 mode)
+{
+   if( mode < 0 || mode >= kNumEngineModes || mode == engineMode)
+      return;
+
+   DBG( 1, "\nMeeblipVST_Engine::setEngineMode %d", mode );
+
+   engineMode = mode;
+   reset();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// exponential segment with time constant seconds/ratio, one step per sample
+// for the amp envelope and one step per control period for everything else
+
+float MeeblipVST_Engine::timeToCoef( float seconds, float ratio)
+{
+   return expf( -ratio / seconds);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+float MeeblipVST_Engine::knobToTime( VstInt32 knobValue, float minTime, float maxTime)
+{
+   return minTime * powf( maxTime / minTime, knobValue / 127.0f);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_Engine::setKnobValue( VstInt32 index, VstInt32 knobValue)
+{
+   if( index >= kNumGuiParameters)
+      return;
+
+   knob[ index] = knobValue;
+
+   float controlRate = sampleRate / kControlRate;
+   VstInt32 byte = knobToByte( index, knobValue);
+
+   switch( index)
+   {
+      case kOscDetune:
+         detune = knobValue / 64.0f;
+         fixedDetune = (byte - 128) / 128.0f;
+         break;
+
+      case kPulseKnob:
+         // the pulse knob sets the pulse width, or the sweep rate if pwm sweep is on
+         smoother.setTarget( kPulseKnob, 0.5f + 0.45f * (knobValue - 64) / 64.0f);
+         pwmRate = 0.05f * powf( 200.0f, knobValue / 127.0f) / controlRate;
+         fixedWidth = (int16)( 0x8000 + (byte - 128) * 115);
+         break;
+
+      case kPortamento:
+         if( knobValue == 0)
+            glideCoef = 1.0f;
+         else
+            glideCoef = 1.0f - timeToCoef( knobToTime( knobValue, 0.005f, 2.0f), 1.0f / controlRate);
+         break;
+
+      case kLfoFreq:
+         lfoIncrement = 0.05f * powf( 400.0f, knobValue / 127.0f) / controlRate;
+         break;
+
+      case kLfoLevel:
+         lfoDepth = knobValue / 127.0f;
+         break;
+
+      case kCutoff:
+         smoother.setTarget( kCutoff, kCutoffOctaves * knobValue / 127.0f);
+         fixedCutoff = kCutoffOctaves * byte / 255.0f;
+         break;
+
+      case kVcfEnvMod:
+         smoother.setTarget( kVcfEnvMod, kCutoffOctaves * knobValue / 64.0f);
+         fixedEnvMod = kCutoffOctaves * (byte - 128) / 128.0f;
+         break;
+
+      case kResonance:
+         smoother.setTarget( kResonance, 2.0f - 1.95f * knobValue / 127.0f);
+         fixedDamping = (int16)( 0x7fff - byte * 125);
+         break;
+
+      case kAmpAttack:
+         ampAttackCoef = timeToCoef( knobToTime( knobValue, 0.001f, 5.0f), logf( 3.0f) / sampleRate);
+         fixedAmpAttack = fixedAttack( byteToTime( byte, 0.001f, 5.0f), controlRate);
+         break;
+
+      case kAmpDecay:
+         ampDecayCoef = timeToCoef( knobToTime( knobValue, 0.005f, 10.0f), logf( 1000.0f) / sampleRate);
+         fixedAmpDecay = fixedDecay( byteToTime( byte, 0.005f, 10.0f), controlRate);
+         break;
+
+      case kDcfAttack:
+         filterAttackCoef = timeToCoef( knobToTime( knobValue, 0.001f, 5.0f), logf( 3.0f) / controlRate);
+         fixedFilterAttack = fixedAttack( byteToTime( byte, 0.001f, 5.0f), controlRate);
+         break;
+
+      case kDcfDecay:
+         filterDecayCoef = timeToCoef( knobToTime( knobValue, 0.005f, 10.0f), logf( 1000.0f) / controlRate);
+         fixedFilterDecay = fixedDecay( byteToTime( byte, 0.005f, 10.0f), controlRate);
+         break;
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_Engine::noteOn( VstInt32 note, VstInt32 velocity)
+{
+   DBG( 2, "      engine note on  %d %d", note, velocity );
+
+   if( velocity == 0)
+   {
+      noteOff( note);
+      return;
+   }
+
+   bool retrigger;
+   VstInt32 v = voices.noteOn( note, retrigger);
+
+   startVoice( v, retrigger);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_Engine::noteOff( VstInt32 note)
+{
+   DBG( 2, "      engine note off %d", note );
+
+   VstInt32 takeOver;
+   bool retrigger;
+   VstInt32 v = voices.noteOff( note, takeOver, retrigger);
+
+   if( v >= 0)
+      releaseVoice( v);
+   else if( takeOver >= 0)
+      startVoice( takeOver, retrigger);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_Engine::allNotesOff()
+{
+   DBG( 2, "      engine all notes off" );
+
+   voices.allNotesOff();
+
+   for( VstInt32 i = 0; i < voices.getNumActive(); i++)
+      releaseVoice( voices.getActiveVoice( i));
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// mono and legato only know voice 0, the gated voices of poly mode would
+// never get their note off. All voices are released, they decay with the
+// decay knobs and are freed when silent
+
+void MeeblipVST_Engine::setVoiceMode( VstInt32 mode)
+{
+   if( mode < 0 || mode >= kNumVoiceModes || mode == voices.getVoiceMode())
+      return;
+
+   DBG( 1, "\nMeeblipVST_Engine::setVoiceMode %d", mode );
+
+   allNotesOff();
+   voices.setVoiceMode( mode);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// In poly mode every voice starts at its own pitch, in mono and legato mode
+// a sounding voice glides to the new note with the PORTAMENTO time
+
+void MeeblipVST_Engine::startVoice( VstInt32 v, bool retrigger)
+{
+   MeeblipVST_VoiceState& s = voices.state;
+   bool sounding = s.ampStage[v] != kEnvIdle;
+
+   if( s.ampStage[v] == kEnvIdle || voices.getVoiceMode() == kVoiceModePoly)
+   {
+      s.pitch[v] = s.targetPitch[v];
+      if( s.ampStage[v] == kEnvIdle)
+      {
+         // a silent voice may have run along in its lane group, start it
+         // from a defined state so every kernel renders the same voice
+         s.phaseA[v] = 0.0f;
+         s.phaseB[v] = 0.0f;
+         s.random[v] = (0x1234567 + 0x9e3779b9 * s.age[v]) | 1;
+         s.ic1eq[v]  = 0.0f;
+         s.ic2eq[v]  = 0.0f;
+         s.ampLevel[v] = 0.0f;
+
+         fixed.phaseA[v] = 0;
+         fixed.phaseB[v] = 0;
+         fixed.random[v] = (int16)( (s.random[v] >> 16) | 1);
+         fixed.low[v]  = 0;
+         fixed.band[v] = 0;
+         fixed.ampEnv[v]    = 0;
+         fixed.filterEnv[v] = 0;
+      }
+   }
+
+   if( retrigger)
+   {
+      s.ampStage[v]     = kEnvAttack;
+      s.ampTarget[v]    = kAttackTarget;
+      s.ampCoef[v]      = ampAttackCoef;
+      s.filterStage[v]  = kEnvAttack;
+      s.filterTarget[v] = kAttackTarget;
+      s.filterCoef[v]   = filterAttackCoef;
+   }
+
+   // the voice may start within a control period, a silent voice starts
+   // with its filter coefficients, a sounding one ramps to them
+   if( engineMode == kEngineFixedPoint)
+      updateFixedVoice( v, lfoOut);
+   else
+      updateVoice( v, currentControl(), sounding);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// with SUSTAIN off the envelopes decay after the attack, with SUSTAIN on
+// they hold the maximum until the note is released. In both cases the decay
+// knob sets the time of the release
+
+void MeeblipVST_Engine::releaseVoice( VstInt32 v)
+{
+   MeeblipVST_VoiceState& s = voices.state;
+
+   if( s.ampStage[v] == kEnvAttack || s.ampStage[v] == kEnvHold)
+   {
+      s.ampStage[v]  = kEnvDecay;
+      s.ampTarget[v] = 0.0f;
+      s.ampCoef[v]   = ampDecayCoef;
+   }
+
+   if( s.filterStage[v] == kEnvAttack || s.filterStage[v] == kEnvHold)
+   {
+      s.filterStage[v]  = kEnvDecay;
+      s.filterTarget[v] = 0.0f;
+      s.filterCoef[v]   = filterDecayCoef;
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the values of the next control period which all voices share, on the
+// audio thread before the voices are rendered
+
+void MeeblipVST_Engine::updateControl()
+{
+   smoother.process();
+
+   // lfo
+   float lfo = 0.0f;
+   if( knob[ kLfoEnable])
+   {
+      lfoPhase += lfoIncrement;
+      if( lfoPhase >= 1.0f)
+      {
+         lfoPhase -= 1.0f;
+         if( knob[ kLfoRandom])
+         {
+            // xorshift32
+            random ^= random << 13;
+            random ^= random >> 17;
+            random ^= random << 5;
+            lfoValue = (int)random * (1.0f / 2147483648.0f);
+         }
+      }
+
+      if( knob[ kLfoRandom])
+         lfo = lfoValue;                              // sample and hold
+      else if( knob[ kLfoWave])
+         lfo = lfoPhase < 0.5f ? 1.0f : -1.0f;        // square
+      else
+         lfo = 4.0f * fabsf( lfoPhase - 0.5f) - 1.0f; // triangle
+
+      lfo *= lfoDepth;
+   }
+   lfoOut = lfo;
+
+   // pulse width
+   if( knob[ kPwmSweep])
+   {
+      pwmPhase += pwmRate;
+      if( pwmPhase >= 1.0f)
+         pwmPhase -= 1.0f;
+      width = 0.5f + 0.45f * (4.0f * fabsf( pwmPhase - 0.5f) - 1.0f);
+   }
+   else
+      width = pulseWidth;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the control rate part of a voice: glide, envelope stages and the filter
+// envelope, then the per sample values of the kernel. It touches the state
+// of voice v only
+
+void MeeblipVST_Engine::updateVoiceControl( VstInt32 v, const MeeblipVST_ControlFrame& c)
+{
+   MeeblipVST_VoiceState& s = voices.state;
+
+   // portamento
+   s.pitch[v] += (s.targetPitch[v] - s.pitch[v]) * glideCoef;
+
+   // envelope stages
+   if( s.ampStage[v] == kEnvAttack && s.ampLevel[v] >= 1.0f)
+   {
+      s.ampLevel[v] = 1.0f;
+      if( s.gate[v] && knob[ kSustain])
+      {
+         s.ampStage[v]  = kEnvHold;
+         s.ampTarget[v] = 1.0f;
+      }
+      else
+      {
+         s.ampStage[v]  = kEnvDecay;
+         s.ampTarget[v] = 0.0f;
+         s.ampCoef[v]   = ampDecayCoef;
+      }
+   }
+
+   if( s.filterStage[v] == kEnvAttack && s.filterLevel[v] >= 1.0f)
+   {
+      s.filterLevel[v] = 1.0f;
+      if( s.gate[v] && knob[ kSustain])
+      {
+         s.filterStage[v]  = kEnvHold;
+         s.filterTarget[v] = 1.0f;
+      }
+      else
+      {
+         s.filterStage[v]  = kEnvDecay;
+         s.filterTarget[v] = 0.0f;
+         s.filterCoef[v]   = filterDecayCoef;
+      }
+   }
+
+   if( engineMode == kEngineFixedPoint)
+   {
+      // the stages above see the levels of the integer envelopes
+      fixed.ampEnv[v]    = stepEnvelope( fixed.ampEnv[v], s.ampStage[v], fixedAmpAttack, fixedAmpDecay);
+      fixed.filterEnv[v] = stepEnvelope( fixed.filterEnv[v], s.filterStage[v], fixedFilterAttack, fixedFilterDecay);
+      s.ampLevel[v]    = fixed.ampEnv[v] * (1.0f / kFixedEnvMax);
+      s.filterLevel[v] = fixed.filterEnv[v] * (1.0f / kFixedEnvMax);
+
+      updateFixedVoice( v, c.lfo);
+      return;
+   }
+
+   // the filter envelope runs at the control rate
+   float level = s.filterTarget[v] + (s.filterLevel[v] - s.filterTarget[v]) * s.filterCoef[v];
+   s.filterLevel[v] = level < 1.0f ? level : 1.0f;
+
+   updateVoice( v, c, true);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// oscillator increments and filter coefficients of a voice. With ramp the
+// coefficients move from their current values to the new ones during the
+// next control period, else they are set right away
+
+void MeeblipVST_Engine::updateVoice( VstInt32 v, const MeeblipVST_ControlFrame& c, bool ramp)
+{
+   MeeblipVST_VoiceState& s = voices.state;
+
+   // oscillators
+   float pitchA = s.pitch[v];
+   if( knob[ kLfoDest])
+      pitchA += c.lfo * kLfoPitchRange;
+
+   float pitchB = pitchA + detune;
+   if( knob[ kOscBOct])
+      pitchB -= 12.0f;
+
+   s.incA[v] = 440.0f * powf( 2.0f, (pitchA - 69.0f) / 12.0f) / sampleRate;
+   s.incB[v] = 440.0f * powf( 2.0f, (pitchB - 69.0f) / 12.0f) / sampleRate;
+
+   // FM raises the frequency of oscillator A up to twice its own
+   s.tableA[v] = wavetables->getOffset( knob[ kOscFm] ? 2.0f * s.incA[v] : s.incA[v]);
+   s.tableB[v] = wavetables->getOffset( s.incB[v]);
+
+   // filter
+   float octaves = c.cutoff + c.envMod * s.filterLevel[v];
+   if( !knob[ kLfoDest])
+      octaves += c.lfo * kLfoFilterRange;
+
+   float fc = kMinCutoff * powf( 2.0f, octaves);
+   if( fc > 0.45f * sampleRate)
+      fc = 0.45f * sampleRate;
+   else if( fc < 10.0f)
+      fc = 10.0f;
+
+   float g = tanf( kPi * fc / sampleRate);
+   float a1 = 1.0f / (1.0f + g * (g + c.damping));
+   float a2 = g * a1;
+   float a3 = g * a2;
+
+   if( ramp)
+   {
+      const float scale = 1.0f / kControlRate;
+      s.da1[v] = (a1 - s.a1[v]) * scale;
+      s.da2[v] = (a2 - s.a2[v]) * scale;
+      s.da3[v] = (a3 - s.a3[v]) * scale;
+   }
+   else
+   {
+      s.a1[v] = a1;
+      s.a2[v] = a2;
+      s.a3[v] = a3;
+      s.da1[v] = 0.0f;
+      s.da2[v] = 0.0f;
+      s.da3[v] = 0.0f;
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the control values of a voice in the resolution of the fixed point voice
+
+void MeeblipVST_Engine::updateFixedVoice( VstInt32 v, float lfo)
+{
+   MeeblipVST_VoiceState& s = voices.state;
+
+   // oscillators
+   float pitchA = s.pitch[v];
+   if( knob[ kLfoDest])
+      pitchA += lfo * kLfoPitchRange;
+
+   float pitchB = pitchA + fixedDetune;
+   if( knob[ kOscBOct])
+      pitchB -= 12.0f;
+
+   fixed.incA[v] = pitchToIncrement( pitchA, sampleRate);
+   fixed.incB[v] = pitchToIncrement( pitchB, sampleRate);
+
+   // filter, the chamberlin coefficient 2 sin( pi fc / fs) saturates at 1.0
+   float octaves = fixedCutoff + fixedEnvMod * s.filterLevel[v];
+   if( !knob[ kLfoDest])
+      octaves += lfo * kLfoFilterRange;
+
+   float fc = kMinCutoff * powf( 2.0f, octaves);
+   float f = fc < sampleRate / 6.0f ? 2.0f * sinf( kPi * fc / sampleRate) : 1.0f;
+   VstInt32 cutoff = (VstInt32)( f * 32768.0f + 0.5f);
+   fixed.cutoff[v] = (int16)( cutoff < 0x7fff ? cutoff : 0x7fff);
+
+   // 8 bit vca
+   fixed.amp[v] = (int16)( (fixed.ampEnv[v] >> 8) << 7);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+template <typename FloatType>
+void MeeblipVST_Engine::render( FloatType* buffer, VstInt32 sampleFrames)
+{
+   prepareRender( sampleFrames);
+
+   renderTarget = buffer;
+   renderFrames = sampleFrames;
+
+   if( engineMode == kEngineFixedPoint)
+   {
+      for( VstInt32 i = 0; i < sampleFrames; i++)
+         fixedPointMix[i] = 0;
+
+      if( !pool.run( renderTaskProc<FloatType>, mixTaskProc<FloatType>, this, numTasks))
+      {
+         for( VstInt32 t = 0; t < numTasks; t++)
+            renderFixedTask( t, fixedPointMix);
+      }
+
+      for( VstInt32 i = 0; i < sampleFrames; i++)
+         buffer[i] = FloatType( fixedPointMix[i]) * FloatType( kFixedOutputScale);
+   }
+   else
+   {
+      for( VstInt32 i = 0; i < sampleFrames; i++)
+         buffer[i] = FloatType( 0);
+
+      // the tasks add to the buffer in the order of the lane groups, like
+      // the mix of the workers
+      if( !pool.run( renderTaskProc<FloatType>, mixTaskProc<FloatType>, this, numTasks))
+      {
+         for( VstInt32 t = 0; t < numTasks; t++)
+            renderTask( t, buffer);
+      }
+   }
+
+   freeSilentVoices();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// The shared control values of all control periods of the render call and
+// the tasks. The switches are the same for the whole call. The ANTI_ALIAS
+// switch doesn't apply to the fixed point voice, the oscillators are always 8 bit
+
+void MeeblipVST_Engine::prepareRender( VstInt32 sampleFrames)
+{
+   MeeblipVST_KernelParams& p = kernelParams;
+   p.wavetable  = wavetables->getSaw();
+   p.oscBEnable = knob[ kOscBEnable] != 0;
+   p.oscBSquare = knob[ kOscBWave] != 0;
+   p.oscAPulse  = knob[ kOscAWave] != 0;
+   p.oscANoise  = knob[ kOscANoise] != 0;
+   p.antiAlias  = knob[ kAntiAlias] != 0;
+   p.fm         = knob[ kOscFm] != 0;
+   p.distortion = knob[ kDistortion] != 0;
+   p.highPass   = knob[ kFilterMode] != 0;
+
+   MeeblipVST_FixedPointParams& fp = fixedPointParams;
+   fp.oscBEnable = p.oscBEnable;
+   fp.oscBSquare = p.oscBSquare;
+   fp.oscAPulse  = p.oscAPulse;
+   fp.oscANoise  = p.oscANoise;
+   fp.fm         = p.fm;
+   fp.distortion = p.distortion;
+   fp.highPass   = p.highPass;
+   fp.damping    = fixedDamping;
+
+   // a call may start or end within a control period
+   numSegments = 0;
+   for( VstInt32 offset = 0; offset < sampleFrames; )
+   {
+      MeeblipVST_ControlSegment& segment = segments[ numSegments++];
+
+      segment.update = controlCount == 0;
+      if( segment.update)
+      {
+         updateControl();
+         controlCount = kControlRate;
+      }
+
+      segment.offset  = offset;
+      segment.frames  = sampleFrames - offset < controlCount ? sampleFrames - offset : controlCount;
+      segment.control = currentControl();
+
+      controlCount -= segment.frames;
+      offset += segment.frames;
+   }
+
+   // one task per lane group with an active voice, in the order of the
+   // groups. The scalar kernel has one voice per group, in the order of
+   // the active voices
+   const VstInt32 lanes = engineMode == kEngineFixedPoint ? fixedPointKernel->lanes : kernel->lanes;
+   const VstInt32 numActive = voices.getNumActive();
+
+   numTasks = 0;
+   if( lanes == 1)
+   {
+      for( VstInt32 i = 0; i < numActive; i++)
+      {
+         taskFirst[i]  = voices.getActiveVoice( i);
+         taskBegin[i]  = i;
+         taskVoices[i] = taskFirst[i];
+      }
+      numTasks = numActive;
+   }
+   else
+   {
+      // one bit for each lane group with an active voice
+      uint32 groups = 0;
+      for( VstInt32 i = 0; i < numActive; i++)
+         groups |= 1 << (voices.getActiveVoice( i) / lanes);
+
+      VstInt32 n = 0;
+      for( VstInt32 g = 0; groups != 0; g++, groups >>= 1)
+      {
+         if( (groups & 1) == 0)
+            continue;
+
+         taskFirst[ numTasks] = g * lanes;
+         taskBegin[ numTasks] = n;
+         for( VstInt32 i = 0; i < numActive; i++)
+         {
+            VstInt32 v = voices.getActiveVoice( i);
+            if( v / lanes == g)
+               taskVoices[ n++] = v;
+         }
+         numTasks++;
+      }
+   }
+   taskBegin[ numTasks] = numActive;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// one lane group through all segments of the render call, adds to buffer.
+// May run on a worker thread, it reads the engine and writes the state of
+// its own voices only
+
+template <typename FloatType>
+void MeeblipVST_Engine::renderTask( VstInt32 task, FloatType* buffer)
+{
+   MeeblipVST_KernelParams p = kernelParams;
+
+   for( VstInt32 k = 0; k < numSegments; k++)
+   {
+      const MeeblipVST_ControlSegment& segment = segments[k];
+
+      if( segment.update)
+      {
+         for( VstInt32 i = taskBegin[ task]; i < taskBegin[ task + 1]; i++)
+            updateVoiceControl( taskVoices[i], segment.control);
+      }
+      p.width   = segment.control.width;
+      p.damping = segment.control.damping;
+
+      renderLanes( p, task, buffer + segment.offset, segment.frames);
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the float path runs the selected kernel over the lane group, the double
+// path renders the voices of the group one by one with the scalar kernel.
+// Like the lanes of a SIMD kernel the voices are summed before they are
+// added to the buffer, the serial render and the workers round alike
+
+void MeeblipVST_Engine::renderLanes( const MeeblipVST_KernelParams& p, VstInt32 task, float* buffer, VstInt32 sampleFrames)
+{
+   kernel->render( voices.state, p, taskFirst[ task], buffer, sampleFrames);
+}
+
+void MeeblipVST_Engine::renderLanes( const MeeblipVST_KernelParams& p, VstInt32 task, double* buffer, VstInt32 sampleFrames)
+{
+   double sum[ kControlRate];
+
+   for( VstInt32 offset = 0; offset < sampleFrames; offset += kControlRate)
+   {
+      VstInt32 frames = sampleFrames - offset < kControlRate ? sampleFrames - offset : kControlRate;
+
+      for( VstInt32 i = 0; i < frames; i++)
+         sum[i] = 0.0;
+      for( VstInt32 i = taskBegin[ task]; i < taskBegin[ task + 1]; i++)
+         renderVoiceDouble( voices.state, p, taskVoices[i], sum, frames);
+      for( VstInt32 i = 0; i < frames; i++)
+         buffer[ offset + i] += sum[i];
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_Engine::renderFixedTask( VstInt32 task, int32* mix)
+{
+   MeeblipVST_FixedPointParams p = fixedPointParams;
+
+   for( VstInt32 k = 0; k < numSegments; k++)
+   {
+      const MeeblipVST_ControlSegment& segment = segments[k];
+
+      if( segment.update)
+      {
+         for( VstInt32 i = taskBegin[ task]; i < taskBegin[ task + 1]; i++)
+            updateVoiceControl( taskVoices[i], segment.control);
+      }
+      p.width = knob[ kPwmSweep] ? (int16)(VstInt32)( segment.control.width * 65536.0f) : fixedWidth;
+
+      fixedPointKernel->render( fixed, p, taskFirst[ task], mix + segment.offset, segment.frames);
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// aweWorkerPool callbacks, a task renders into its own buffer on any
+// thread, the audio thread adds the buffers in the order of the tasks
+
+template <typename FloatType>
+void MeeblipVST_Engine::renderTaskProc( void* context, int task)
+{
+   MeeblipVST_Engine* engine = (MeeblipVST_Engine*)context;
+   const VstInt32 frames = engine->renderFrames;
+
+   if( engine->engineMode == kEngineFixedPoint)
+   {
+      int32* mix = engine->taskMix + task * engine->taskStride;
+      for( VstInt32 i = 0; i < frames; i++)
+         mix[i] = 0;
+      engine->renderFixedTask( task, mix);
+   }
+   else
+   {
+      FloatType* buffer = engine->getPath( (FloatType*)NULL).tasks + task * engine->taskStride;
+      for( VstInt32 i = 0; i < frames; i++)
+         buffer[i] = FloatType( 0);
+      engine->renderTask( task, buffer);
+   }
+}
+
+template <typename FloatType>
+void MeeblipVST_Engine::mixTaskProc( void* context, int task)
+{
+   MeeblipVST_Engine* engine = (MeeblipVST_Engine*)context;
+   const VstInt32 frames = engine->renderFrames;
+
+   if( engine->engineMode == kEngineFixedPoint)
+   {
+      const int32* mix = engine->taskMix + task * engine->taskStride;
+      for( VstInt32 i = 0; i < frames; i++)
+         engine->fixedPointMix[i] += mix[i];
+   }
+   else
+   {
+      FloatType* target = (FloatType*)engine->renderTarget;
+      const FloatType* buffer = engine->getPath( target).tasks + task * engine->taskStride;
+      for( VstInt32 i = 0; i < frames; i++)
+         target[i] += buffer[i];
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+MeeblipVST_ControlFrame MeeblipVST_Engine::currentControl()
+{
+   MeeblipVST_ControlFrame c;
+   c.lfo     = lfoOut;
+   c.width   = width;
+   c.cutoff  = cutoff;
+   c.envMod  = envMod;
+   c.damping = damping;
+   return c;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// hand back the voices which are done, clear their filters so no
+// denormals are left behind
+
+void MeeblipVST_Engine::freeSilentVoices()
+{
+   MeeblipVST_VoiceState& s = voices.state;
+
+   for( VstInt32 i = voices.getNumActive() - 1; i >= 0; i--)
+   {
+      VstInt32 v = voices.getActiveVoice( i);
+      if( s.ampStage[v] == kEnvDecay && s.ampLevel[v] < kIdleLevel)
+      {
+         s.ampStage[v]    = kEnvIdle;
+         s.ampLevel[v]    = 0.0f;
+         s.filterStage[v] = kEnvIdle;
+         s.filterLevel[v] = 0.0f;
+         s.ic1eq[v] = 0.0f;
+         s.ic2eq[v] = 0.0f;
+         s.da1[v] = 0.0f;        // a silent lane keeps its coefficients
+         s.da2[v] = 0.0f;
+         s.da3[v] = 0.0f;
+         fixed.amp[v]  = 0;
+         fixed.low[v]  = 0;
+         fixed.band[v] = 0;
+         voices.freeVoice( v);
+      }
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// process() is in the header, it renders float for processReplacing and
+// double for processDoubleReplacing
+
+template void MeeblipVST_Engine::render<float>( float* buffer, VstInt32 sampleFrames);
+template void MeeblipVST_Engine::render<double>( double* buffer, VstInt32 sampleFrames);
@@ -0,0 +1,330 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Engine.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   firmware symbols renamed to fixed point
+//    17.10.2026  AWe   the firmware mode is the fixed point mode
+//    17.10.2026  AWe   a change of the voice mode releases all voices
+//    17.10.2026  AWe   render, decimation and mix in the sample type of the
+//                      host, processDoubleReplacing renders in double
+//    17.10.2026  AWe   render the lane groups in parallel with aweWorkerPool
+//    17.10.2026  AWe   optional 2x/4x/8x oversampling of the voices
+//    17.10.2026  AWe   firmware engine mode, fixed point voice like the AVR
+//    17.10.2026  AWe   oscillators read the shared band limited wavetables
+//    17.10.2026  AWe   CUTOFF, RESONANCE, PULSE_KNOB and VCFENVMOD are smoothed
+//                      at the control rate, the filter coefficients ramp in
+//                      between
+//    17.10.2026  AWe   render the voices with a SIMD kernel in lane groups
+//    17.10.2026  AWe   render up to kMaxVoices voices from MeeblipVST_VoicePool
+//    17.10.2026  AWe   software synthesis engine for the meeblip SE V2 voice
+//
+// --------------------------------------------------------------------------
+
+#ifndef __MeeblipVST_Engine__
+#define __MeeblipVST_Engine__
+
+#include "MeeblipVST_FixedPoint.h"
+#include "MeeblipVST_Kernel.h"
+#include "MeeblipVST_Layout.h"
+#include "MeeblipVST_Oversampler.h"
+#include "MeeblipVST_Smoother.h"
+#include "MeeblipVST_Voices.h"
+#include "MeeblipVST_Wavetables.h"
+#include "aweVSTtypes.h"
+#include "aweWorkerPool.h"
+
+#include <stddef.h>
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+enum
+{
+   kControlRate     = 32,      // samples between two control rate updates
+   kMaxRenderFrames = 256,     // size of the internal render buffer
+   kMaxRenderThreads = 8,      // the audio thread and up to 7 workers
+
+   kMaxOversampledFrames = kMaxRenderFrames << (kNumOversampleFactors - 1),
+   kMaxControlSegments   = kMaxOversampledFrames / kControlRate + 1
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_ControlFrame
+// --------------------------------------------------------------------------
+
+// the values of one control period which are the same for all voices
+
+struct MeeblipVST_ControlFrame
+{
+   float lfo;                 // lfo modulation
+   float width;               // pulse width
+   float cutoff;              // smoothed knob values
+   float envMod;
+   float damping;
+};
+
+// part of a render call within one control period, the voices are
+// updated with control at the start of the segment if update is set
+
+struct MeeblipVST_ControlSegment
+{
+   VstInt32 offset;
+   VstInt32 frames;
+   bool update;
+   MeeblipVST_ControlFrame control;
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_RenderBuffers
+// --------------------------------------------------------------------------
+
+// the buffers and the decimator of one sample type, the engine has one set
+// for float and one for double. The host decides by the process call which
+// one is used
+
+template <typename FloatType>
+struct MeeblipVST_RenderBuffers
+{
+   MeeblipVST_RenderBuffers() : oversample( NULL), tasks( NULL) {}
+   ~MeeblipVST_RenderBuffers()   { delete[] oversample; delete[] tasks; }
+
+   FloatType render[ kMaxRenderFrames];
+   FloatType* oversample;     // kMaxRenderFrames * factor, NULL without oversampling
+   FloatType* tasks;          // kMaxVoices * taskStride, NULL without workers
+
+   MeeblipVST_Oversampler<FloatType> oversampler;
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_Engine
+// --------------------------------------------------------------------------
+
+// The engine renders the voice of the meeblip SE V2 in software. It is
+// driven by the knob values of the gui parameters( the same 7 bit values
+// which are sent as CC to the hardware) and by note on/off events.
+//
+// Everything which depends on a knob value only is derived in setKnobValue(),
+// everything which is modulated( lfo, envelopes, glide) is updated at the
+// control rate, the per sample loop contains oscillators, filter and amp only.
+// The knob values with a ramp in the layout table glide to a new value at
+// the control rate, the kernels interpolate the filter coefficients linearly
+// from one control update to the next.
+// Like on the hardware there is one lfo and one pwm sweep for all voices.
+//
+// The per sample loop is a MeeblipVST_Kernel which renders a group of
+// neighboring voices at once. A group is rendered if at least one of its
+// voices is active, the silent lanes run along with an amp level of zero.
+//
+// In the fixed point mode the voice is rendered by a
+// MeeblipVST_FixedPointKernel in 8/16 bit integer. The control rate part
+// quantizes pitch, filter and envelopes to 16 bit, the knob values are
+// used without smoothing, scaled to a byte.
+//
+// With oversampling the voices run at factor times the sample rate, the
+// oscillators, the distortion and the filter see the higher rate and the
+// mix is decimated by MeeblipVST_Oversampler. The knob mapping, the
+// envelope times and the control rate in seconds stay the same.
+//
+// A render call first steps the shared control values( smoother, lfo, pwm)
+// through all control periods of the call, then renders each lane group
+// as one task: the control updates of its voices and the kernel for all
+// periods. The lane groups don't share any state, with render threads the
+// tasks run on aweWorkerPool, each into its own buffer, and are summed in
+// the order of the groups. The sum is the same, bit for bit, as the one of
+// the single threaded render.
+//
+// process() works in the sample type of the host. With float the voices
+// are rendered by the SIMD kernels. With double the voices are rendered by
+// renderVoiceDouble(), the phases, the filter integrators, the mix and the
+// decimation are double, the control rate values stay float.
+
+class MeeblipVST_Engine
+{
+public:
+   MeeblipVST_Engine();
+   ~MeeblipVST_Engine();
+
+   void setSampleRate( float sampleRate);
+
+   // 1, 2, 4 or 8, allocates, not from the audio thread. The latency of
+   // the decimation in samples is reported by getLatency()
+   void setOversampling( VstInt32 factor);
+   VstInt32 getOversampling()    { return floatPath.oversampler.getFactor(); }
+   VstInt32 getLatency()         { return floatPath.oversampler.getLatency(); }
+   void reset();
+
+   void setKnobValue( VstInt32 index, VstInt32 knobValue);
+
+   // 1 renders on the audio thread only, more start worker threads.
+   // Allocates, not from the audio thread
+   void setRenderThreads( VstInt32 threads);
+   VstInt32 getRenderThreads()   { return pool.getNumWorkers() + 1; }
+   aweWorkerPool& getWorkerPool()  { return pool; }
+
+   void setPolyphony( VstInt32 polyphony)  { voices.setPolyphony( polyphony); }
+   void setVoiceMode( VstInt32 mode);       // a change releases all voices
+   void setStealMode( VstInt32 mode)       { voices.setStealMode( mode); }
+
+   void noteOn( VstInt32 note, VstInt32 velocity);
+   void noteOff( VstInt32 note);
+   void allNotesOff();
+
+   bool isActive() { return voices.getNumActive() > 0; }
+
+   // the widest supported kernel is selected in the constructor, setKernel()
+   // returns false if the kernel type is not available on this cpu
+   bool setKernel( VstInt32 type);
+   const MeeblipVST_Kernel* getKernel() { return kernel; }
+
+   // kEngineModern or kEngineFixedPoint, a change stops all voices
+   void setEngineMode( VstInt32 mode);
+   VstInt32 getEngineMode()               { return engineMode; }
+   const MeeblipVST_FixedPointKernel* getFixedPointKernel() { return fixedPointKernel; }
+
+   // render the voices and add them to both outputs
+   template <typename FloatType>
+   void process( FloatType* out1, FloatType* out2, VstInt32 sampleFrames)
+   {
+      MeeblipVST_RenderBuffers<FloatType>& path = getPath( out1);
+      const VstInt32 factor = path.oversampler.getFactor();
+
+      while( sampleFrames > 0 && isActive())
+      {
+         VstInt32 frames = sampleFrames < kMaxRenderFrames ? sampleFrames : kMaxRenderFrames;
+
+         if( factor > 1)
+         {
+            render( path.oversample, frames * factor);
+            path.oversampler.process( path.oversample, path.render, frames);
+         }
+         else
+            render( path.render, frames);
+         for( VstInt32 i = 0; i < frames; i++)
+         {
+            (*out1++) += path.render[i];
+            (*out2++) += path.render[i];
+         }
+         sampleFrames -= frames;
+      }
+      // a silent engine leaves the last samples in the decimator, they
+      // are below the idle level of the voices
+   }
+
+protected:
+   template <typename FloatType>
+   void render( FloatType* buffer, VstInt32 sampleFrames);
+   void prepareRender( VstInt32 sampleFrames);
+   void updateControl();
+   void updateVoiceControl( VstInt32 v, const MeeblipVST_ControlFrame& c);
+   void updateVoice( VstInt32 v, const MeeblipVST_ControlFrame& c, bool ramp);
+   void updateFixedVoice( VstInt32 v, float lfo);
+   template <typename FloatType>
+   void renderTask( VstInt32 task, FloatType* buffer);
+   void renderLanes( const MeeblipVST_KernelParams& p, VstInt32 task, float* buffer, VstInt32 sampleFrames);
+   void renderLanes( const MeeblipVST_KernelParams& p, VstInt32 task, double* buffer, VstInt32 sampleFrames);
+   void renderFixedTask( VstInt32 task, int32* mix);
+   void freeSilentVoices();
+   void allocateTaskBuffers();
+
+   MeeblipVST_ControlFrame currentControl();
+
+   template <typename FloatType>
+   static void renderTaskProc( void* context, int task);
+   template <typename FloatType>
+   static void mixTaskProc( void* context, int task);
+
+   MeeblipVST_RenderBuffers<float>& getPath( const float*)    { return floatPath; }
+   MeeblipVST_RenderBuffers<double>& getPath( const double*)  { return doublePath; }
+
+   void startVoice( VstInt32 v, bool retrigger);
+   void releaseVoice( VstInt32 v);
+
+   float timeToCoef( float seconds, float ratio);
+   float knobToTime( VstInt32 knobValue, float minTime, float maxTime);
+
+   float sampleRate;          // rate of the voices, oversampled
+   float baseRate;            // rate of the host
+   VstInt32 knob[ kNumGuiParameters];
+
+   // derived from knob values
+   float detune;              // osc B detune in semitones
+   float pulseWidth;          // pulse width if the pwm sweep is off
+   float pwmRate;             // pwm sweep increment per control period
+   float glideCoef;           // portamento coefficient per control period
+   float lfoIncrement;        // lfo phase increment per control period
+   float lfoDepth;
+   float cutoff;              // base cutoff in octaves above kMinCutoff
+   float envMod;              // filter envelope depth in octaves
+   float damping;             // 1/Q of the filter
+
+   float ampAttackCoef;       // per sample
+   float ampDecayCoef;
+   float filterAttackCoef;    // per control period
+   float filterDecayCoef;
+
+   // derived from the knob bytes for the fixed point mode
+   float fixedDetune;
+   float fixedCutoff;
+   float fixedEnvMod;
+   VstInt32 fixedAmpAttack;   // envelope increment per control period
+   VstInt32 fixedAmpDecay;    // fraction of the level per control period, 16 bit
+   VstInt32 fixedFilterAttack;
+   VstInt32 fixedFilterDecay;
+   int16 fixedWidth;
+   int16 fixedDamping;
+
+   // state shared by all voices
+   float pwmPhase;
+   float width;               // current pulse width
+   float lfoPhase;
+   float lfoValue;            // last random value of the sample and hold
+   float lfoOut;              // current lfo modulation
+   uint32 random;
+
+   VstInt32 controlCount;     // samples left until the next control update
+
+   MeeblipVST_Smoother smoother;
+
+   MeeblipVST_VoicePool voices;
+
+   const MeeblipVST_Kernel* kernel;
+   MeeblipVST_KernelParams kernelParams;
+
+   VstInt32 engineMode;
+   const MeeblipVST_FixedPointKernel* fixedPointKernel;
+   MeeblipVST_FixedPointParams fixedPointParams;
+   MeeblipVST_FixedPointState fixed;
+
+   const MeeblipVST_Wavetables* wavetables;   // shared, for the current sample rate
+
+   MeeblipVST_RenderBuffers<float> floatPath;
+   MeeblipVST_RenderBuffers<double> doublePath;
+
+   // the current render call
+   MeeblipVST_ControlSegment segments[ kMaxControlSegments];
+   VstInt32 numSegments;
+   VstInt32 renderFrames;
+   void* renderTarget;        // float or double
+   int32 fixedPointMix[ kMaxOversampledFrames];   // sum of the fixed point voices
+
+   // a task is one lane group, its active voices are
+   // taskVoices[ taskBegin[t]] .. taskVoices[ taskBegin[t + 1] - 1]
+   VstInt32 numTasks;
+   VstInt32 taskFirst[ kMaxVoices];         // first lane of the group
+   VstInt32 taskBegin[ kMaxVoices + 1];
+   VstInt32 taskVoices[ kMaxVoices];
+
+   aweWorkerPool pool;
+   VstInt32 taskStride;       // kMaxRenderFrames * factor
+   int32* taskMix;            // kMaxVoices * taskStride, NULL without workers
+};
+
+#endif // __MeeblipVST_Engine__
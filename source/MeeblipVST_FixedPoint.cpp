@@ -0,0 +1,435 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_FixedPoint.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   renamed from MeeblipVST_Firmware.cpp, the fixed point
+//                      voice is no emulation of the hardware
+//    17.10.2026  AWe   describe the voice as fixed point, not as the firmware
+//    17.10.2026  AWe   8/16 bit fixed point voice of the firmware, scalar
+//                      reference and SSE2/AVX2 integer kernels
+//
+// --------------------------------------------------------------------------
+
+// An 8/16 bit fixed point voice: 16 bit phase accumulators, 8 bit
+// oscillator samples, a 16 bit state variable filter with saturating adds,
+// an 8 bit vca. The multiplies are 16x16 with the upper half of the
+// product.
+//
+// The SIMD kernels process one voice per 16 bit lane. The integer
+// operations are exact, so the lanes need no care about rounding, the
+// mix is summed in 32 bit and doesn't depend on the order of the voices.
+
+#include "MeeblipVST_FixedPoint.h"
+
+#include <stddef.h>
+
+#if defined( _M_IX86) || defined( _M_X64) || defined( __i386__) || defined( __x86_64__)
+ #define FIXED_X86 1
+#endif
+
+#if FIXED_X86 && (defined( _MSC_VER) || defined( __SSE2__))
+ #define FIXED_SSE2 1
+ #include <emmintrin.h>
+#endif
+
+#if FIXED_X86 && ((defined( _MSC_VER) && _MSC_VER >= 1700) || defined( __GNUC__))
+ #define FIXED_AVX2 1
+ #include <immintrin.h>
+ #if defined( __GNUC__)
+  #define FIXED_TARGET_AVX2 __attribute__(( target( "avx2")))
+ #else
+  #define FIXED_TARGET_AVX2
+ #endif
+#endif
+
+// --------------------------------------------------------------------------
+// Debug support
+// --------------------------------------------------------------------------
+
+#define VERBOSITY       99
+#define VERBOSITY_MIN   1
+
+#include "aweDBG.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static_assert( kMaxVoices % 16 == 0, "the voices have to fill whole lane groups");
+
+// --------------------------------------------------------------------------
+// scalar reference kernel
+// --------------------------------------------------------------------------
+
+static inline int16 saturate16( int32 x)
+{
+   return (int16)( x > 32767 ? 32767 : x < -32768 ? -32768 : x);
+}
+
+// upper half of the signed 16x16 product
+static inline int16 mulHigh16( int16 a, int16 b)
+{
+   return (int16)( ( (int32)a * b) >> 16);
+}
+
+// a * b with b in Q15, the doubling saturates
+static inline int16 mulQ15( int16 a, int16 b)
+{
+   int16 m = mulHigh16( a, b);
+   return saturate16( m + m);
+}
+
+// a * b with b in Q14
+static inline int16 mulQ14( int16 a, int16 b)
+{
+   int16 m = mulHigh16( a, b);
+   m = saturate16( m + m);
+   return saturate16( m + m);
+}
+
+// 8 bit sawtooth from the upper byte of the phase, -128..127
+static inline int16 saw8Bit( int16 phase)
+{
+   return (int16)( (int16)( phase ^ 0x8000) >> 8);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static void renderFixedScalar( MeeblipVST_FixedPointState& s, const MeeblipVST_FixedPointParams& p, VstInt32 v, int32* mix, VstInt32 sampleFrames)
+{
+   int16 phaseA = s.phaseA[v];
+   int16 phaseB = s.phaseB[v];
+   const int16 incA = s.incA[v];
+   const int16 incB = s.incB[v];
+   uint16 rnd = (uint16)s.random[v];
+
+   int16 low = s.low[v];
+   int16 band = s.band[v];
+   const int16 f = s.cutoff[v];
+   const int16 amp = s.amp[v];
+
+   const uint16 width = (uint16)p.width;
+   const int16 damping = p.damping;
+
+   for( VstInt32 i = 0; i < sampleFrames; i++)
+   {
+      // oscillator B, also the modulator for FM
+      phaseB = (int16)( phaseB + incB);
+
+      int16 b;
+      if( p.oscBSquare)
+         b = phaseB < 0 ? -128 : 127;
+      else
+         b = saw8Bit( phaseB);
+
+      // oscillator A, FM moves the increment by up to one octave
+      int16 inc = incA;
+      if( p.fm)
+         inc = (int16)( incA + mulQ15( incA, (int16)( b << 8)));
+      phaseA = (int16)( phaseA + inc);
+
+      int16 a;
+      if( p.oscANoise)
+      {
+         rnd ^= (uint16)( rnd << 7);
+         rnd ^= (uint16)( rnd >> 9);
+         rnd ^= (uint16)( rnd << 8);
+         a = (int16)( (int16)rnd >> 8);
+      }
+      else if( p.oscAPulse)
+         a = (uint16)phaseA < width ? 127 : -128;
+      else
+         a = saw8Bit( phaseA);
+
+      int16 x = p.oscBEnable ? (int16)( (a + b) >> 1) : a;
+
+      // the distortion clips at 8 bit
+      if( p.distortion)
+      {
+         x = (int16)( x << 2);
+         x = x > 127 ? 127 : x < -128 ? -128 : x;
+      }
+
+      // state variable filter
+      int16 in = (int16)( x << 8);
+      low = saturate16( low + mulQ15( band, f));
+      int16 high = saturate16( saturate16( in - low) - mulQ14( band, damping));
+      band = saturate16( band + mulQ15( high, f));
+
+      int16 y = p.highPass ? high : low;
+
+      mix[i] += mulQ15( y, amp);
+   }
+
+   s.phaseA[v] = phaseA;
+   s.phaseB[v] = phaseB;
+   s.random[v] = (int16)rnd;
+   s.low[v] = low;
+   s.band[v] = band;
+}
+
+// --------------------------------------------------------------------------
+// SSE2 kernel, 8 voices
+// --------------------------------------------------------------------------
+
+#if FIXED_SSE2
+
+static inline __m128i mulQ15SSE2( __m128i a, __m128i b)
+{
+   __m128i m = _mm_mulhi_epi16( a, b);
+   return _mm_adds_epi16( m, m);
+}
+
+static inline __m128i mulQ14SSE2( __m128i a, __m128i b)
+{
+   __m128i m = _mm_mulhi_epi16( a, b);
+   m = _mm_adds_epi16( m, m);
+   return _mm_adds_epi16( m, m);
+}
+
+static inline __m128i saw8BitSSE2( __m128i phase, __m128i sign)
+{
+   return _mm_srai_epi16( _mm_xor_si128( phase, sign), 8);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static void renderFixedSSE2( MeeblipVST_FixedPointState& s, const MeeblipVST_FixedPointParams& p, VstInt32 v, int32* mix, VstInt32 sampleFrames)
+{
+   __m128i phaseA = _mm_loadu_si128( (const __m128i*)&s.phaseA[v]);
+   __m128i phaseB = _mm_loadu_si128( (const __m128i*)&s.phaseB[v]);
+   const __m128i incA = _mm_loadu_si128( (const __m128i*)&s.incA[v]);
+   const __m128i incB = _mm_loadu_si128( (const __m128i*)&s.incB[v]);
+   __m128i rnd = _mm_loadu_si128( (const __m128i*)&s.random[v]);
+
+   __m128i low = _mm_loadu_si128( (const __m128i*)&s.low[v]);
+   __m128i band = _mm_loadu_si128( (const __m128i*)&s.band[v]);
+   const __m128i f = _mm_loadu_si128( (const __m128i*)&s.cutoff[v]);
+   const __m128i amp = _mm_loadu_si128( (const __m128i*)&s.amp[v]);
+
+   const __m128i sign = _mm_set1_epi16( (short)0x8000);
+   const __m128i max8 = _mm_set1_epi16( 127);
+   const __m128i min8 = _mm_set1_epi16( -128);
+   const __m128i ones = _mm_set1_epi16( 1);
+
+   // the unsigned compare of the pulse is a signed one with flipped signs
+   const __m128i width = _mm_xor_si128( _mm_set1_epi16( p.width), sign);
+   const __m128i damping = _mm_set1_epi16( p.damping);
+
+   for( VstInt32 i = 0; i < sampleFrames; i++)
+   {
+      // oscillator B, also the modulator for FM
+      phaseB = _mm_add_epi16( phaseB, incB);
+
+      __m128i b;
+      if( p.oscBSquare)
+         b = _mm_xor_si128( _mm_cmplt_epi16( phaseB, _mm_setzero_si128()), max8);
+      else
+         b = saw8BitSSE2( phaseB, sign);
+
+      // oscillator A
+      __m128i inc = incA;
+      if( p.fm)
+         inc = _mm_add_epi16( incA, mulQ15SSE2( incA, _mm_slli_epi16( b, 8)));
+      phaseA = _mm_add_epi16( phaseA, inc);
+
+      __m128i a;
+      if( p.oscANoise)
+      {
+         rnd = _mm_xor_si128( rnd, _mm_slli_epi16( rnd, 7));
+         rnd = _mm_xor_si128( rnd, _mm_srli_epi16( rnd, 9));
+         rnd = _mm_xor_si128( rnd, _mm_slli_epi16( rnd, 8));
+         a = _mm_srai_epi16( rnd, 8);
+      }
+      else if( p.oscAPulse)
+         a = _mm_xor_si128( _mm_cmplt_epi16( _mm_xor_si128( phaseA, sign), width), min8);
+      else
+         a = saw8BitSSE2( phaseA, sign);
+
+      __m128i x = p.oscBEnable ? _mm_srai_epi16( _mm_add_epi16( a, b), 1) : a;
+
+      if( p.distortion)
+         x = _mm_max_epi16( _mm_min_epi16( _mm_slli_epi16( x, 2), max8), min8);
+
+      // state variable filter
+      __m128i in = _mm_slli_epi16( x, 8);
+      low = _mm_adds_epi16( low, mulQ15SSE2( band, f));
+      __m128i high = _mm_subs_epi16( _mm_subs_epi16( in, low), mulQ14SSE2( band, damping));
+      band = _mm_adds_epi16( band, mulQ15SSE2( high, f));
+
+      __m128i y = p.highPass ? high : low;
+
+      // 8 x 16 bit -> 4 x 32 bit -> 1
+      __m128i sum = _mm_madd_epi16( mulQ15SSE2( y, amp), ones);
+      sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 1, 0, 3, 2)));
+      sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 2, 3, 0, 1)));
+      mix[i] += _mm_cvtsi128_si32( sum);
+   }
+
+   _mm_storeu_si128( (__m128i*)&s.phaseA[v], phaseA);
+   _mm_storeu_si128( (__m128i*)&s.phaseB[v], phaseB);
+   _mm_storeu_si128( (__m128i*)&s.random[v], rnd);
+   _mm_storeu_si128( (__m128i*)&s.low[v], low);
+   _mm_storeu_si128( (__m128i*)&s.band[v], band);
+}
+
+#endif // FIXED_SSE2
+
+// --------------------------------------------------------------------------
+// AVX2 kernel, 16 voices
+// --------------------------------------------------------------------------
+
+#if FIXED_AVX2
+
+FIXED_TARGET_AVX2 static inline __m256i mulQ15AVX2( __m256i a, __m256i b)
+{
+   __m256i m = _mm256_mulhi_epi16( a, b);
+   return _mm256_adds_epi16( m, m);
+}
+
+FIXED_TARGET_AVX2 static inline __m256i mulQ14AVX2( __m256i a, __m256i b)
+{
+   __m256i m = _mm256_mulhi_epi16( a, b);
+   m = _mm256_adds_epi16( m, m);
+   return _mm256_adds_epi16( m, m);
+}
+
+FIXED_TARGET_AVX2 static inline __m256i saw8BitAVX2( __m256i phase, __m256i sign)
+{
+   return _mm256_srai_epi16( _mm256_xor_si256( phase, sign), 8);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+FIXED_TARGET_AVX2 static void renderFixedAVX2( MeeblipVST_FixedPointState& s, const MeeblipVST_FixedPointParams& p, VstInt32 v, int32* mix, VstInt32 sampleFrames)
+{
+   __m256i phaseA = _mm256_loadu_si256( (const __m256i*)&s.phaseA[v]);
+   __m256i phaseB = _mm256_loadu_si256( (const __m256i*)&s.phaseB[v]);
+   const __m256i incA = _mm256_loadu_si256( (const __m256i*)&s.incA[v]);
+   const __m256i incB = _mm256_loadu_si256( (const __m256i*)&s.incB[v]);
+   __m256i rnd = _mm256_loadu_si256( (const __m256i*)&s.random[v]);
+
+   __m256i low = _mm256_loadu_si256( (const __m256i*)&s.low[v]);
+   __m256i band = _mm256_loadu_si256( (const __m256i*)&s.band[v]);
+   const __m256i f = _mm256_loadu_si256( (const __m256i*)&s.cutoff[v]);
+   const __m256i amp = _mm256_loadu_si256( (const __m256i*)&s.amp[v]);
+
+   const __m256i sign = _mm256_set1_epi16( (short)0x8000);
+   const __m256i max8 = _mm256_set1_epi16( 127);
+   const __m256i min8 = _mm256_set1_epi16( -128);
+   const __m256i ones = _mm256_set1_epi16( 1);
+
+   const __m256i width = _mm256_xor_si256( _mm256_set1_epi16( p.width), sign);
+   const __m256i damping = _mm256_set1_epi16( p.damping);
+
+   for( VstInt32 i = 0; i < sampleFrames; i++)
+   {
+      // oscillator B, also the modulator for FM
+      phaseB = _mm256_add_epi16( phaseB, incB);
+
+      __m256i b;
+      if( p.oscBSquare)
+         b = _mm256_xor_si256( _mm256_cmpgt_epi16( _mm256_setzero_si256(), phaseB), max8);
+      else
+         b = saw8BitAVX2( phaseB, sign);
+
+      // oscillator A
+      __m256i inc = incA;
+      if( p.fm)
+         inc = _mm256_add_epi16( incA, mulQ15AVX2( incA, _mm256_slli_epi16( b, 8)));
+      phaseA = _mm256_add_epi16( phaseA, inc);
+
+      __m256i a;
+      if( p.oscANoise)
+      {
+         rnd = _mm256_xor_si256( rnd, _mm256_slli_epi16( rnd, 7));
+         rnd = _mm256_xor_si256( rnd, _mm256_srli_epi16( rnd, 9));
+         rnd = _mm256_xor_si256( rnd, _mm256_slli_epi16( rnd, 8));
+         a = _mm256_srai_epi16( rnd, 8);
+      }
+      else if( p.oscAPulse)
+         a = _mm256_xor_si256( _mm256_cmpgt_epi16( width, _mm256_xor_si256( phaseA, sign)), min8);
+      else
+         a = saw8BitAVX2( phaseA, sign);
+
+      __m256i x = p.oscBEnable ? _mm256_srai_epi16( _mm256_add_epi16( a, b), 1) : a;
+
+      if( p.distortion)
+         x = _mm256_max_epi16( _mm256_min_epi16( _mm256_slli_epi16( x, 2), max8), min8);
+
+      // state variable filter
+      __m256i in = _mm256_slli_epi16( x, 8);
+      low = _mm256_adds_epi16( low, mulQ15AVX2( band, f));
+      __m256i high = _mm256_subs_epi16( _mm256_subs_epi16( in, low), mulQ14AVX2( band, damping));
+      band = _mm256_adds_epi16( band, mulQ15AVX2( high, f));
+
+      __m256i y = p.highPass ? high : low;
+
+      // 16 x 16 bit -> 8 x 32 bit -> 1
+      __m256i sum8 = _mm256_madd_epi16( mulQ15AVX2( y, amp), ones);
+      __m128i sum = _mm_add_epi32( _mm256_castsi256_si128( sum8), _mm256_extracti128_si256( sum8, 1));
+      sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 1, 0, 3, 2)));
+      sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 2, 3, 0, 1)));
+      mix[i] += _mm_cvtsi128_si32( sum);
+   }
+
+   _mm256_storeu_si256( (__m256i*)&s.phaseA[v], phaseA);
+   _mm256_storeu_si256( (__m256i*)&s.phaseB[v], phaseB);
+   _mm256_storeu_si256( (__m256i*)&s.random[v], rnd);
+   _mm256_storeu_si256( (__m256i*)&s.low[v], low);
+   _mm256_storeu_si256( (__m256i*)&s.band[v], band);
+}
+
+#endif // FIXED_AVX2
+
+// --------------------------------------------------------------------------
+// runtime dispatch
+// --------------------------------------------------------------------------
+
+// there is no NEON version, the scalar kernel is used on ARM
+
+static MeeblipVST_FixedPointKernel fixedPointKernels[ kNumKernelTypes] =
+{
+   { kKernelScalar, "scalar", 1,  renderFixedScalar },
+#if FIXED_SSE2
+   { kKernelSSE2,   "sse2",   8,  renderFixedSSE2 },
+#else
+   { kKernelSSE2,   "sse2",   8,  NULL },
+#endif
+#if FIXED_AVX2
+   { kKernelAVX2,   "avx2",   16, renderFixedAVX2 },
+#else
+   { kKernelAVX2,   "avx2",   16, NULL },
+#endif
+   { kKernelNEON,   "neon",   8,  NULL },
+};
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the cpu check is the one of the floating point kernel of the same type
+
+const MeeblipVST_FixedPointKernel* getFixedPointKernel( VstInt32 type)
+{
+   if( type < 0 || type >= kNumKernelTypes || fixedPointKernels[ type].render == NULL)
+      return NULL;
+
+   if( getKernel( type) == NULL)
+      return NULL;
+
+   return &fixedPointKernels[ type];
+}
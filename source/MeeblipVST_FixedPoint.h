@@ -0,0 +1,132 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_FixedPoint.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   renamed from MeeblipVST_Firmware.h, the symbols are named
+//                      after the fixed point voice
+//    17.10.2026  AWe   kEngineFirmware renamed to kEngineFixedPoint, the mode
+//                      is not checked against the hardware
+//    17.10.2026  AWe   8/16 bit fixed point voice of the firmware, scalar
+//                      reference and SSE2/AVX2 integer kernels
+//
+// --------------------------------------------------------------------------
+
+#ifndef __MeeblipVST_FixedPoint__
+#define __MeeblipVST_FixedPoint__
+
+#include "MeeblipVST_Kernel.h"
+#include "MeeblipVST_Layout.h"
+#include "MeeblipVST_Voices.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+enum EngineMode
+{
+   kEngineModern = 0,         // floating point, band limited oscillators
+   kEngineFixedPoint,         // 8/16 bit fixed point voice
+
+   kNumEngineModes
+};
+
+enum
+{
+   kFixedEnvMax = 0xffff   // full scale of the control rate envelopes
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_FixedPointState
+// --------------------------------------------------------------------------
+
+// Fixed point state of all voices. The phases are 16 bit accumulators
+// which wrap like unsigned values, the filter integrators and the amp are
+// signed Q15. The per sample values are int16 so a 128 bit register holds
+// 8 voices. The envelopes run at the control rate in the engine.
+
+struct MeeblipVST_FixedPointState
+{
+   int16 phaseA[ kMaxVoices];
+   int16 phaseB[ kMaxVoices];
+   int16 incA[ kMaxVoices];         // phase increment per sample, 1..0x7fff
+   int16 incB[ kMaxVoices];
+   int16 random[ kMaxVoices];       // xorshift16, never zero
+
+   int16 low[ kMaxVoices];          // filter integrators
+   int16 band[ kMaxVoices];
+   int16 cutoff[ kMaxVoices];       // filter coefficient f, Q15
+
+   int16 amp[ kMaxVoices];          // 8 bit vca level as Q15
+
+   int32 ampEnv[ kMaxVoices];       // 0..kFixedEnvMax
+   int32 filterEnv[ kMaxVoices];
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_FixedPointParams
+// --------------------------------------------------------------------------
+
+// values which are the same for all voices during one control period
+
+struct MeeblipVST_FixedPointParams
+{
+   int16 width;               // pulse width of oscillator A, unsigned 16 bit
+   int16 damping;             // 1/Q of the filter, Q14
+
+   VstInt32 oscBEnable;
+   VstInt32 oscBSquare;
+   VstInt32 oscAPulse;
+   VstInt32 oscANoise;
+   VstInt32 fm;
+   VstInt32 distortion;
+   VstInt32 highPass;
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_FixedPointKernel
+// --------------------------------------------------------------------------
+
+// A kernel renders the voices first .. first+lanes-1 and adds their Q15
+// samples to mix. All arithmetic is 16 bit integer with wrap around and
+// saturation, the sum is 32 bit. The SIMD versions render the same samples
+// as the scalar one, in any lane grouping.
+
+typedef void (*MeeblipVST_FixedPointProc)( MeeblipVST_FixedPointState& s, const MeeblipVST_FixedPointParams& p, VstInt32 first, int32* mix, VstInt32 sampleFrames);
+
+struct MeeblipVST_FixedPointKernel
+{
+   KernelType type;
+   const char* name;
+   VstInt32 lanes;
+   MeeblipVST_FixedPointProc render;
+};
+
+// scale of the mix to the output, the same gain as the modern engine
+static const float kFixedOutputScale = 0.5f / 32768.0f;
+
+// returns NULL if the kernel is not built in or not supported by the cpu
+const MeeblipVST_FixedPointKernel* getFixedPointKernel( VstInt32 type);
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the fixed point voice works with a full byte per knob, the range of the knob
+// is taken from the layout table: minValue -> 0, maxValue -> 255
+
+inline VstInt32 knobToByte( VstInt32 index, VstInt32 knobValue)
+{
+   const MeeblipVST_LayoutItem* layoutItem = getLayoutItem( index);
+   VstInt32 range = layoutItem->maxValue - layoutItem->minValue;
+
+   return (knobValue - layoutItem->minValue) * 255 / range;
+}
+
+#endif // __MeeblipVST_FixedPoint__
@@ -0,0 +1,763 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Kernel.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   remove the NEON kernel, it was never built or tested, ARM
+//                      uses the scalar kernel
+//    17.10.2026  AWe   the comment of phase8Bit refers to the ANTI_ALIAS switch
+//    17.10.2026  AWe   the scalar kernel is a template over the sample type,
+//                      renderVoiceDouble() for the double precision path
+//    17.10.2026  AWe   ANTI_ALIAS on: band limited wavetables instead of polyBLEP,
+//                      ANTI_ALIAS off: 8 bit phase like the firmware
+//    17.10.2026  AWe   filter coefficients ramp linearly within a control period
+//    17.10.2026  AWe   per sample voice kernels, scalar reference and
+//                      SSE2/AVX2/NEON versions across voices
+//
+// --------------------------------------------------------------------------
+
+// The SIMD kernels process one voice per lane. Every conditional of the
+// scalar kernel which depends on the voice( phase wrap, pulse comparison,
+// envelope clamp) is computed on both sides and selected with a mask, the
+// wavetable lookups are gathers. The switches in MeeblipVST_KernelParams
+// are the same for all lanes and stay branches.
+//
+// No kernel may use fused multiply add, the scalar kernel has to be built
+// without contraction( -ffp-contract=off on gcc/clang, default on msvc),
+// otherwise the voice state differs between the kernels in the last bit.
+
+#include "MeeblipVST_Kernel.h"
+#include "MeeblipVST_Wavetables.h"
+
+#include <math.h>
+#include <stddef.h>
+
+#if defined( _M_IX86) || defined( _M_X64) || defined( __i386__) || defined( __x86_64__)
+ #define KERNEL_X86 1
+#endif
+
+#if KERNEL_X86 && (defined( _MSC_VER) || defined( __SSE2__))
+ #define KERNEL_SSE2 1
+ #include <emmintrin.h>
+#endif
+
+// AVX2 intrinsics are available since VS2012, gcc and clang build the AVX2
+// kernel with a function attribute, the rest of the plugin stays SSE2
+#if KERNEL_X86 && ((defined( _MSC_VER) && _MSC_VER >= 1700) || defined( __GNUC__))
+ #define KERNEL_AVX2 1
+ #include <immintrin.h>
+ #if defined( __GNUC__)
+  #define KERNEL_TARGET_AVX2 __attribute__(( target( "avx2")))
+ #else
+  #define KERNEL_TARGET_AVX2
+ #endif
+#endif
+
+#if defined( _MSC_VER) && KERNEL_X86
+ #include <intrin.h>
+#endif
+
+// --------------------------------------------------------------------------
+// Debug support
+// --------------------------------------------------------------------------
+
+#define VERBOSITY       99
+#define VERBOSITY_MIN   1
+
+#include "aweDBG.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static const float kDrive      = 4.0f;    // gain in front of the distortion
+static const float kOutputGain = 0.5f;
+static const float kNoiseScale = 1.0f / 2147483648.0f;
+static const float kTableScale = (float)kWavetableSize;
+static const float k8BitSteps  = 256.0f;
+static const float k8BitScale  = 1.0f / 256.0f;
+
+static_assert( kMaxVoices % 8 == 0, "the voices have to fill whole lane groups");
+
+// --------------------------------------------------------------------------
+// scalar reference kernel
+// --------------------------------------------------------------------------
+
+// linear interpolation in the band limited table at offset, 0 <= phase <= 1
+
+template <typename FloatType>
+static inline FloatType lookup( const float* tables, VstInt32 offset, FloatType phase)
+{
+   FloatType x = phase * kTableScale;
+   VstInt32 n = (VstInt32)x;
+   FloatType f = x - (FloatType)n;
+   const float* t = tables + offset + n;
+   return t[0] + f * (t[1] - t[0]);
+}
+
+// without ANTI_ALIAS the oscillators use the upper 8 bits of the phase
+// accumulator, phase >= 0
+
+template <typename FloatType>
+static inline FloatType phase8Bit( FloatType phase)
+{
+   return (FloatType)(VstInt32)( phase * k8BitSteps) * k8BitScale;
+}
+
+static inline float absValue( float x)     { return fabsf( x); }
+static inline double absValue( double x)   { return fabs( x); }
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// render one voice and add it to the buffer, the state is kept in locals
+// for the length of the segment. FloatType is the type of the phases, the
+// filter integrators and the output, coefficients and envelope stay float.
+// The float version is the scalar reference kernel, the double version
+// renders the voices of processDoubleReplacing
+
+template <typename FloatType>
+static void renderVoice( MeeblipVST_VoiceState& s, const MeeblipVST_KernelParams& p, VstInt32 v, FloatType* buffer, VstInt32 sampleFrames)
+{
+   FloatType phaseA = (FloatType)s.phaseA[v];
+   FloatType phaseB = (FloatType)s.phaseB[v];
+   const float incA = s.incA[v];
+   const float incB = s.incB[v];
+   uint32 rnd = s.random[v];
+
+   float a1 = s.a1[v];
+   float a2 = s.a2[v];
+   float a3 = s.a3[v];
+   const float da1 = s.da1[v];
+   const float da2 = s.da2[v];
+   const float da3 = s.da3[v];
+   FloatType ic1eq = (FloatType)s.ic1eq[v];
+   FloatType ic2eq = (FloatType)s.ic2eq[v];
+
+   float ampLevel = s.ampLevel[v];
+   const float ampTarget = s.ampTarget[v];
+   const float ampCoef = s.ampCoef[v];
+
+   const float* tables = p.wavetable;
+   const VstInt32 tableA = s.tableA[v];
+   const VstInt32 tableB = s.tableB[v];
+
+   const float width = p.width;
+   const float pulseOffset = 2.0f * width - 1.0f;
+   const float damping = p.damping;
+
+   for( VstInt32 i = 0; i < sampleFrames; i++)
+   {
+      // oscillator B, also the modulator for FM
+      phaseB += incB;
+      if( phaseB >= 1.0f)
+         phaseB -= 1.0f;
+
+      FloatType b;
+      if( p.antiAlias)
+      {
+         b = lookup( tables, tableB, phaseB);
+         if( p.oscBSquare)
+         {
+            FloatType t = phaseB + 0.5f;
+            if( t >= 1.0f)
+               t -= 1.0f;
+            b = lookup( tables, tableB, t) - b;
+         }
+      }
+      else
+      {
+         FloatType q = phase8Bit( phaseB);
+         b = p.oscBSquare ? (q < 0.5f ? 1.0f : -1.0f) : 2.0f * q - 1.0f;
+      }
+
+      // oscillator A
+      FloatType inc = p.fm ? incA * (1.0f + b) : incA;
+      phaseA += inc;
+      if( phaseA >= 1.0f)
+         phaseA -= 1.0f;
+
+      FloatType a;
+      if( p.oscANoise)
+      {
+         rnd ^= rnd << 13;
+         rnd ^= rnd >> 17;
+         rnd ^= rnd << 5;
+         a = (int)rnd * kNoiseScale;
+      }
+      else if( p.antiAlias)
+      {
+         a = lookup( tables, tableA, phaseA);
+         if( p.oscAPulse)
+         {
+            FloatType t = phaseA + 1.0f - width;
+            if( t >= 1.0f)
+               t -= 1.0f;
+            a = (lookup( tables, tableA, t) - a) + pulseOffset;
+         }
+      }
+      else
+      {
+         FloatType q = phase8Bit( phaseA);
+         a = p.oscAPulse ? (q < width ? 1.0f : -1.0f) : 2.0f * q - 1.0f;
+      }
+
+      FloatType x = p.oscBEnable ? 0.5f * (a + b) : a;
+
+      if( p.distortion)
+      {
+         x *= kDrive;
+         x = x / (1.0f + absValue( x));
+      }
+
+      // state variable filter
+      FloatType v3 = x - ic2eq;
+      FloatType v1 = a1 * ic1eq + a2 * v3;
+      FloatType v2 = ic2eq + a2 * ic1eq + a3 * v3;
+      ic1eq = 2.0f * v1 - ic1eq;
+      ic2eq = 2.0f * v2 - ic2eq;
+
+      FloatType y = p.highPass ? x - damping * v1 - v2 : v2;
+
+      a1 += da1;
+      a2 += da2;
+      a3 += da3;
+
+      // amp envelope
+      float level = ampTarget + (ampLevel - ampTarget) * ampCoef;
+      ampLevel = level < 1.0f ? level : 1.0f;
+
+      buffer[i] += y * ampLevel * kOutputGain;
+   }
+
+   s.phaseA[v] = phaseA;
+   s.phaseB[v] = phaseB;
+   s.random[v] = rnd;
+   s.a1[v] = a1;
+   s.a2[v] = a2;
+   s.a3[v] = a3;
+   s.ic1eq[v] = ic1eq;
+   s.ic2eq[v] = ic2eq;
+   s.ampLevel[v] = ampLevel;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void renderVoiceDouble( MeeblipVST_VoiceState& s, const MeeblipVST_KernelParams& p, VstInt32 v, double* buffer, VstInt32 sampleFrames)
+{
+   renderVoice( s, p, v, buffer, sampleFrames);
+}
+
+// --------------------------------------------------------------------------
+// SSE2 kernel, 4 voices
+// --------------------------------------------------------------------------
+
+#if KERNEL_SSE2
+
+static inline __m128 selectSSE2( __m128 mask, __m128 a, __m128 b)
+{
+   return _mm_or_ps( _mm_and_ps( mask, a), _mm_andnot_ps( mask, b));
+}
+
+static inline __m128 wrapSSE2( __m128 phase, __m128 one)
+{
+   return _mm_sub_ps( phase, _mm_and_ps( _mm_cmpge_ps( phase, one), one));
+}
+
+static inline __m128 lookupSSE2( const float* tables, __m128i offset, __m128 phase, __m128 scale)
+{
+   __m128 x = _mm_mul_ps( phase, scale);
+   __m128i n = _mm_cvttps_epi32( x);
+   __m128 f = _mm_sub_ps( x, _mm_cvtepi32_ps( n));
+
+   VstInt32 index[4];
+   _mm_storeu_si128( (__m128i*)index, _mm_add_epi32( n, offset));
+
+   const float* t0 = tables + index[0];
+   const float* t1 = tables + index[1];
+   const float* t2 = tables + index[2];
+   const float* t3 = tables + index[3];
+   __m128 y0 = _mm_setr_ps( t0[0], t1[0], t2[0], t3[0]);
+   __m128 y1 = _mm_setr_ps( t0[1], t1[1], t2[1], t3[1]);
+   return _mm_add_ps( y0, _mm_mul_ps( f, _mm_sub_ps( y1, y0)));
+}
+
+static inline __m128 phase8BitSSE2( __m128 phase, __m128 steps, __m128 scale)
+{
+   return _mm_mul_ps( _mm_cvtepi32_ps( _mm_cvttps_epi32( _mm_mul_ps( phase, steps))), scale);
+}
+
+static inline __m128i xorshiftSSE2( __m128i r)
+{
+   r = _mm_xor_si128( r, _mm_slli_epi32( r, 13));
+   r = _mm_xor_si128( r, _mm_srli_epi32( r, 17));
+   r = _mm_xor_si128( r, _mm_slli_epi32( r, 5));
+   return r;
+}
+
+// phases and filter integrators are double in the voice state
+
+static inline __m128 loadDoubleSSE2( const double* p)
+{
+   return _mm_movelh_ps( _mm_cvtpd_ps( _mm_loadu_pd( p)), _mm_cvtpd_ps( _mm_loadu_pd( p + 2)));
+}
+
+static inline void storeDoubleSSE2( double* p, __m128 x)
+{
+   _mm_storeu_pd( p, _mm_cvtps_pd( x));
+   _mm_storeu_pd( p + 2, _mm_cvtps_pd( _mm_movehl_ps( x, x)));
+}
+
+static inline float sumSSE2( __m128 x)
+{
+   __m128 sum = _mm_add_ps( x, _mm_movehl_ps( x, x));
+   sum = _mm_add_ss( sum, _mm_shuffle_ps( sum, sum, 1));
+   return _mm_cvtss_f32( sum);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static void renderSSE2( MeeblipVST_VoiceState& s, const MeeblipVST_KernelParams& p, VstInt32 v, float* buffer, VstInt32 sampleFrames)
+{
+   __m128 phaseA = loadDoubleSSE2( &s.phaseA[v]);
+   __m128 phaseB = loadDoubleSSE2( &s.phaseB[v]);
+   const __m128 incA = _mm_loadu_ps( &s.incA[v]);
+   const __m128 incB = _mm_loadu_ps( &s.incB[v]);
+   __m128i rnd = _mm_loadu_si128( (const __m128i*)&s.random[v]);
+
+   __m128 a1 = _mm_loadu_ps( &s.a1[v]);
+   __m128 a2 = _mm_loadu_ps( &s.a2[v]);
+   __m128 a3 = _mm_loadu_ps( &s.a3[v]);
+   const __m128 da1 = _mm_loadu_ps( &s.da1[v]);
+   const __m128 da2 = _mm_loadu_ps( &s.da2[v]);
+   const __m128 da3 = _mm_loadu_ps( &s.da3[v]);
+   __m128 ic1eq = loadDoubleSSE2( &s.ic1eq[v]);
+   __m128 ic2eq = loadDoubleSSE2( &s.ic2eq[v]);
+
+   __m128 ampLevel = _mm_loadu_ps( &s.ampLevel[v]);
+   const __m128 ampTarget = _mm_loadu_ps( &s.ampTarget[v]);
+   const __m128 ampCoef = _mm_loadu_ps( &s.ampCoef[v]);
+
+   const float* tables = p.wavetable;
+   const __m128i tableA = _mm_loadu_si128( (const __m128i*)&s.tableA[v]);
+   const __m128i tableB = _mm_loadu_si128( (const __m128i*)&s.tableB[v]);
+
+   const __m128 half = _mm_set1_ps( 0.5f);
+   const __m128 one = _mm_set1_ps( 1.0f);
+   const __m128 minusOne = _mm_set1_ps( -1.0f);
+   const __m128 two = _mm_set1_ps( 2.0f);
+
+   const __m128 width = _mm_set1_ps( p.width);
+   const __m128 pulseOffset = _mm_sub_ps( _mm_mul_ps( two, width), one);
+   const __m128 damping = _mm_set1_ps( p.damping);
+
+   const __m128 tableScale = _mm_set1_ps( kTableScale);
+   const __m128 steps8Bit = _mm_set1_ps( k8BitSteps);
+   const __m128 scale8Bit = _mm_set1_ps( k8BitScale);
+   const __m128 drive = _mm_set1_ps( kDrive);
+   const __m128 gain = _mm_set1_ps( kOutputGain);
+   const __m128 noiseScale = _mm_set1_ps( kNoiseScale);
+   const __m128 absMask = _mm_castsi128_ps( _mm_set1_epi32( 0x7fffffff));
+
+   for( VstInt32 i = 0; i < sampleFrames; i++)
+   {
+      // oscillator B, also the modulator for FM
+      phaseB = wrapSSE2( _mm_add_ps( phaseB, incB), one);
+
+      __m128 b;
+      if( p.antiAlias)
+      {
+         b = lookupSSE2( tables, tableB, phaseB, tableScale);
+         if( p.oscBSquare)
+         {
+            __m128 t = wrapSSE2( _mm_add_ps( phaseB, half), one);
+            b = _mm_sub_ps( lookupSSE2( tables, tableB, t, tableScale), b);
+         }
+      }
+      else
+      {
+         __m128 q = phase8BitSSE2( phaseB, steps8Bit, scale8Bit);
+         b = p.oscBSquare ? selectSSE2( _mm_cmplt_ps( q, half), one, minusOne) : _mm_sub_ps( _mm_mul_ps( two, q), one);
+      }
+
+      // oscillator A
+      __m128 inc = p.fm ? _mm_mul_ps( incA, _mm_add_ps( one, b)) : incA;
+      phaseA = wrapSSE2( _mm_add_ps( phaseA, inc), one);
+
+      __m128 a;
+      if( p.oscANoise)
+      {
+         rnd = xorshiftSSE2( rnd);
+         a = _mm_mul_ps( _mm_cvtepi32_ps( rnd), noiseScale);
+      }
+      else if( p.antiAlias)
+      {
+         a = lookupSSE2( tables, tableA, phaseA, tableScale);
+         if( p.oscAPulse)
+         {
+            __m128 t = wrapSSE2( _mm_sub_ps( _mm_add_ps( phaseA, one), width), one);
+            a = _mm_add_ps( _mm_sub_ps( lookupSSE2( tables, tableA, t, tableScale), a), pulseOffset);
+         }
+      }
+      else
+      {
+         __m128 q = phase8BitSSE2( phaseA, steps8Bit, scale8Bit);
+         a = p.oscAPulse ? selectSSE2( _mm_cmplt_ps( q, width), one, minusOne) : _mm_sub_ps( _mm_mul_ps( two, q), one);
+      }
+
+      __m128 x = p.oscBEnable ? _mm_mul_ps( half, _mm_add_ps( a, b)) : a;
+
+      if( p.distortion)
+      {
+         x = _mm_mul_ps( x, drive);
+         x = _mm_div_ps( x, _mm_add_ps( one, _mm_and_ps( x, absMask)));
+      }
+
+      // state variable filter
+      __m128 v3 = _mm_sub_ps( x, ic2eq);
+      __m128 v1 = _mm_add_ps( _mm_mul_ps( a1, ic1eq), _mm_mul_ps( a2, v3));
+      __m128 v2 = _mm_add_ps( _mm_add_ps( ic2eq, _mm_mul_ps( a2, ic1eq)), _mm_mul_ps( a3, v3));
+      ic1eq = _mm_sub_ps( _mm_mul_ps( two, v1), ic1eq);
+      ic2eq = _mm_sub_ps( _mm_mul_ps( two, v2), ic2eq);
+
+      __m128 y = p.highPass ? _mm_sub_ps( _mm_sub_ps( x, _mm_mul_ps( damping, v1)), v2) : v2;
+
+      a1 = _mm_add_ps( a1, da1);
+      a2 = _mm_add_ps( a2, da2);
+      a3 = _mm_add_ps( a3, da3);
+
+      // amp envelope
+      __m128 level = _mm_add_ps( ampTarget, _mm_mul_ps( _mm_sub_ps( ampLevel, ampTarget), ampCoef));
+      ampLevel = _mm_min_ps( level, one);
+
+      buffer[i] += sumSSE2( _mm_mul_ps( _mm_mul_ps( y, ampLevel), gain));
+   }
+
+   storeDoubleSSE2( &s.phaseA[v], phaseA);
+   storeDoubleSSE2( &s.phaseB[v], phaseB);
+   _mm_storeu_si128( (__m128i*)&s.random[v], rnd);
+   _mm_storeu_ps( &s.a1[v], a1);
+   _mm_storeu_ps( &s.a2[v], a2);
+   _mm_storeu_ps( &s.a3[v], a3);
+   storeDoubleSSE2( &s.ic1eq[v], ic1eq);
+   storeDoubleSSE2( &s.ic2eq[v], ic2eq);
+   _mm_storeu_ps( &s.ampLevel[v], ampLevel);
+}
+
+#endif // KERNEL_SSE2
+
+// --------------------------------------------------------------------------
+// AVX2 kernel, 8 voices
+// --------------------------------------------------------------------------
+
+#if KERNEL_AVX2
+
+KERNEL_TARGET_AVX2 static inline __m256 wrapAVX2( __m256 phase, __m256 one)
+{
+   return _mm256_sub_ps( phase, _mm256_and_ps( _mm256_cmp_ps( phase, one, _CMP_GE_OQ), one));
+}
+
+KERNEL_TARGET_AVX2 static inline __m256 lookupAVX2( const float* tables, __m256i offset, __m256 phase, __m256 scale)
+{
+   __m256 x = _mm256_mul_ps( phase, scale);
+   __m256i n = _mm256_cvttps_epi32( x);
+   __m256 f = _mm256_sub_ps( x, _mm256_cvtepi32_ps( n));
+
+   __m256i index = _mm256_add_epi32( n, offset);
+   __m256 y0 = _mm256_i32gather_ps( tables, index, 4);
+   __m256 y1 = _mm256_i32gather_ps( tables + 1, index, 4);
+   return _mm256_add_ps( y0, _mm256_mul_ps( f, _mm256_sub_ps( y1, y0)));
+}
+
+KERNEL_TARGET_AVX2 static inline __m256 phase8BitAVX2( __m256 phase, __m256 steps, __m256 scale)
+{
+   return _mm256_mul_ps( _mm256_cvtepi32_ps( _mm256_cvttps_epi32( _mm256_mul_ps( phase, steps))), scale);
+}
+
+KERNEL_TARGET_AVX2 static inline __m256i xorshiftAVX2( __m256i r)
+{
+   r = _mm256_xor_si256( r, _mm256_slli_epi32( r, 13));
+   r = _mm256_xor_si256( r, _mm256_srli_epi32( r, 17));
+   r = _mm256_xor_si256( r, _mm256_slli_epi32( r, 5));
+   return r;
+}
+
+KERNEL_TARGET_AVX2 static inline __m256 loadDoubleAVX2( const double* p)
+{
+   __m128 low  = _mm256_cvtpd_ps( _mm256_loadu_pd( p));
+   __m128 high = _mm256_cvtpd_ps( _mm256_loadu_pd( p + 4));
+   return _mm256_insertf128_ps( _mm256_castps128_ps256( low), high, 1);
+}
+
+KERNEL_TARGET_AVX2 static inline void storeDoubleAVX2( double* p, __m256 x)
+{
+   _mm256_storeu_pd( p, _mm256_cvtps_pd( _mm256_castps256_ps128( x)));
+   _mm256_storeu_pd( p + 4, _mm256_cvtps_pd( _mm256_extractf128_ps( x, 1)));
+}
+
+KERNEL_TARGET_AVX2 static inline float sumAVX2( __m256 x)
+{
+   __m128 sum = _mm_add_ps( _mm256_castps256_ps128( x), _mm256_extractf128_ps( x, 1));
+   sum = _mm_add_ps( sum, _mm_movehl_ps( sum, sum));
+   sum = _mm_add_ss( sum, _mm_shuffle_ps( sum, sum, 1));
+   return _mm_cvtss_f32( sum);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+KERNEL_TARGET_AVX2 static void renderAVX2( MeeblipVST_VoiceState& s, const MeeblipVST_KernelParams& p, VstInt32 v, float* buffer, VstInt32 sampleFrames)
+{
+   __m256 phaseA = loadDoubleAVX2( &s.phaseA[v]);
+   __m256 phaseB = loadDoubleAVX2( &s.phaseB[v]);
+   const __m256 incA = _mm256_loadu_ps( &s.incA[v]);
+   const __m256 incB = _mm256_loadu_ps( &s.incB[v]);
+   __m256i rnd = _mm256_loadu_si256( (const __m256i*)&s.random[v]);
+
+   __m256 a1 = _mm256_loadu_ps( &s.a1[v]);
+   __m256 a2 = _mm256_loadu_ps( &s.a2[v]);
+   __m256 a3 = _mm256_loadu_ps( &s.a3[v]);
+   const __m256 da1 = _mm256_loadu_ps( &s.da1[v]);
+   const __m256 da2 = _mm256_loadu_ps( &s.da2[v]);
+   const __m256 da3 = _mm256_loadu_ps( &s.da3[v]);
+   __m256 ic1eq = loadDoubleAVX2( &s.ic1eq[v]);
+   __m256 ic2eq = loadDoubleAVX2( &s.ic2eq[v]);
+
+   __m256 ampLevel = _mm256_loadu_ps( &s.ampLevel[v]);
+   const __m256 ampTarget = _mm256_loadu_ps( &s.ampTarget[v]);
+   const __m256 ampCoef = _mm256_loadu_ps( &s.ampCoef[v]);
+
+   const float* tables = p.wavetable;
+   const __m256i tableA = _mm256_loadu_si256( (const __m256i*)&s.tableA[v]);
+   const __m256i tableB = _mm256_loadu_si256( (const __m256i*)&s.tableB[v]);
+
+   const __m256 half = _mm256_set1_ps( 0.5f);
+   const __m256 one = _mm256_set1_ps( 1.0f);
+   const __m256 minusOne = _mm256_set1_ps( -1.0f);
+   const __m256 two = _mm256_set1_ps( 2.0f);
+
+   const __m256 width = _mm256_set1_ps( p.width);
+   const __m256 pulseOffset = _mm256_sub_ps( _mm256_mul_ps( two, width), one);
+   const __m256 damping = _mm256_set1_ps( p.damping);
+
+   const __m256 tableScale = _mm256_set1_ps( kTableScale);
+   const __m256 steps8Bit = _mm256_set1_ps( k8BitSteps);
+   const __m256 scale8Bit = _mm256_set1_ps( k8BitScale);
+   const __m256 drive = _mm256_set1_ps( kDrive);
+   const __m256 gain = _mm256_set1_ps( kOutputGain);
+   const __m256 noiseScale = _mm256_set1_ps( kNoiseScale);
+   const __m256 absMask = _mm256_castsi256_ps( _mm256_set1_epi32( 0x7fffffff));
+
+   for( VstInt32 i = 0; i < sampleFrames; i++)
+   {
+      // oscillator B, also the modulator for FM
+      phaseB = wrapAVX2( _mm256_add_ps( phaseB, incB), one);
+
+      __m256 b;
+      if( p.antiAlias)
+      {
+         b = lookupAVX2( tables, tableB, phaseB, tableScale);
+         if( p.oscBSquare)
+         {
+            __m256 t = wrapAVX2( _mm256_add_ps( phaseB, half), one);
+            b = _mm256_sub_ps( lookupAVX2( tables, tableB, t, tableScale), b);
+         }
+      }
+      else
+      {
+         __m256 q = phase8BitAVX2( phaseB, steps8Bit, scale8Bit);
+         b = p.oscBSquare ? _mm256_blendv_ps( minusOne, one, _mm256_cmp_ps( q, half, _CMP_LT_OQ)) : _mm256_sub_ps( _mm256_mul_ps( two, q), one);
+      }
+
+      // oscillator A
+      __m256 inc = p.fm ? _mm256_mul_ps( incA, _mm256_add_ps( one, b)) : incA;
+      phaseA = wrapAVX2( _mm256_add_ps( phaseA, inc), one);
+
+      __m256 a;
+      if( p.oscANoise)
+      {
+         rnd = xorshiftAVX2( rnd);
+         a = _mm256_mul_ps( _mm256_cvtepi32_ps( rnd), noiseScale);
+      }
+      else if( p.antiAlias)
+      {
+         a = lookupAVX2( tables, tableA, phaseA, tableScale);
+         if( p.oscAPulse)
+         {
+            __m256 t = wrapAVX2( _mm256_sub_ps( _mm256_add_ps( phaseA, one), width), one);
+            a = _mm256_add_ps( _mm256_sub_ps( lookupAVX2( tables, tableA, t, tableScale), a), pulseOffset);
+         }
+      }
+      else
+      {
+         __m256 q = phase8BitAVX2( phaseA, steps8Bit, scale8Bit);
+         a = p.oscAPulse ? _mm256_blendv_ps( minusOne, one, _mm256_cmp_ps( q, width, _CMP_LT_OQ)) : _mm256_sub_ps( _mm256_mul_ps( two, q), one);
+      }
+
+      __m256 x = p.oscBEnable ? _mm256_mul_ps( half, _mm256_add_ps( a, b)) : a;
+
+      if( p.distortion)
+      {
+         x = _mm256_mul_ps( x, drive);
+         x = _mm256_div_ps( x, _mm256_add_ps( one, _mm256_and_ps( x, absMask)));
+      }
+
+      // state variable filter
+      __m256 v3 = _mm256_sub_ps( x, ic2eq);
+      __m256 v1 = _mm256_add_ps( _mm256_mul_ps( a1, ic1eq), _mm256_mul_ps( a2, v3));
+      __m256 v2 = _mm256_add_ps( _mm256_add_ps( ic2eq, _mm256_mul_ps( a2, ic1eq)), _mm256_mul_ps( a3, v3));
+      ic1eq = _mm256_sub_ps( _mm256_mul_ps( two, v1), ic1eq);
+      ic2eq = _mm256_sub_ps( _mm256_mul_ps( two, v2), ic2eq);
+
+      __m256 y = p.highPass ? _mm256_sub_ps( _mm256_sub_ps( x, _mm256_mul_ps( damping, v1)), v2) : v2;
+
+      a1 = _mm256_add_ps( a1, da1);
+      a2 = _mm256_add_ps( a2, da2);
+      a3 = _mm256_add_ps( a3, da3);
+
+      // amp envelope
+      __m256 level = _mm256_add_ps( ampTarget, _mm256_mul_ps( _mm256_sub_ps( ampLevel, ampTarget), ampCoef));
+      ampLevel = _mm256_min_ps( level, one);
+
+      buffer[i] += sumAVX2( _mm256_mul_ps( _mm256_mul_ps( y, ampLevel), gain));
+   }
+
+   storeDoubleAVX2( &s.phaseA[v], phaseA);
+   storeDoubleAVX2( &s.phaseB[v], phaseB);
+   _mm256_storeu_si256( (__m256i*)&s.random[v], rnd);
+   _mm256_storeu_ps( &s.a1[v], a1);
+   _mm256_storeu_ps( &s.a2[v], a2);
+   _mm256_storeu_ps( &s.a3[v], a3);
+   storeDoubleAVX2( &s.ic1eq[v], ic1eq);
+   storeDoubleAVX2( &s.ic2eq[v], ic2eq);
+   _mm256_storeu_ps( &s.ampLevel[v], ampLevel);
+}
+
+#endif // KERNEL_AVX2
+
+// --------------------------------------------------------------------------
+// runtime dispatch
+// --------------------------------------------------------------------------
+
+#if KERNEL_X86
+
+static bool cpuHasSSE2()
+{
+#if defined( _M_X64) || defined( __x86_64__)
+   return true;
+#elif defined( _MSC_VER)
+   int info[4];
+   __cpuid( info, 1);
+   return (info[3] & (1 << 26)) != 0;
+#else
+   return __builtin_cpu_supports( "sse2") != 0;
+#endif
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static bool cpuHasAVX2()
+{
+#if defined( _MSC_VER) && _MSC_VER >= 1600
+   int info[4];
+   __cpuid( info, 0);
+   if( info[0] < 7)
+      return false;
+
+   // the os has to save the ymm registers
+   __cpuid( info, 1);
+   if( (info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+      return false;
+   if( (_xgetbv( 0) & 6) != 6)
+      return false;
+
+   __cpuidex( info, 7, 0);
+   return (info[1] & (1 << 5)) != 0;
+#elif defined( __GNUC__)
+   return __builtin_cpu_supports( "avx2") != 0;
+#else
+   return false;
+#endif
+}
+
+#endif // KERNEL_X86
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// there is no NEON version, the scalar kernel is used on ARM
+
+static MeeblipVST_Kernel kernels[ kNumKernelTypes] =
+{
+   { kKernelScalar, "scalar", 1, renderVoice<float> },
+#if KERNEL_SSE2
+   { kKernelSSE2,   "sse2",   4, renderSSE2 },
+#else
+   { kKernelSSE2,   "sse2",   4, NULL },
+#endif
+#if KERNEL_AVX2
+   { kKernelAVX2,   "avx2",   8, renderAVX2 },
+#else
+   { kKernelAVX2,   "avx2",   8, NULL },
+#endif
+   { kKernelNEON,   "neon",   4, NULL },
+};
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+const MeeblipVST_Kernel* getKernel( VstInt32 type)
+{
+   if( type < 0 || type >= kNumKernelTypes || kernels[ type].render == NULL)
+      return NULL;
+
+   bool supported = true;
+
+#if KERNEL_X86
+   if( type == kKernelSSE2)
+      supported = cpuHasSSE2();
+   else if( type == kKernelAVX2)
+      supported = cpuHasAVX2();
+#endif
+
+   return supported ? &kernels[ type] : NULL;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+const MeeblipVST_Kernel* getBestKernel()
+{
+   static const MeeblipVST_Kernel* best = NULL;
+
+   if( best == NULL)
+   {
+      static const VstInt32 order[] = { kKernelAVX2, kKernelSSE2, kKernelNEON, kKernelScalar };
+
+      const MeeblipVST_Kernel* kernel = NULL;
+      for( VstInt32 i = 0; kernel == NULL; i++)
+         kernel = getKernel( order[i]);
+
+      DBG( 1, "\ngetBestKernel %s, %d voices per lane group", kernel->name, kernel->lanes );
+      best = kernel;
+   }
+
+   return best;
+}
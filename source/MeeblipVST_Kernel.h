@@ -0,0 +1,95 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Kernel.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   no NEON kernel, kKernelNEON is reserved
+//    17.10.2026  AWe   add renderVoiceDouble()
+//    17.10.2026  AWe   add the wavetable to the kernel parameters
+//    17.10.2026  AWe   per sample voice kernels, scalar reference and
+//                      SSE2/AVX2/NEON versions across voices
+//
+// --------------------------------------------------------------------------
+
+#ifndef __MeeblipVST_Kernel__
+#define __MeeblipVST_Kernel__
+
+#include "MeeblipVST_Voices.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+enum KernelType
+{
+   kKernelScalar = 0,         // portable reference
+   kKernelSSE2,               // 4 voices per lane group
+   kKernelAVX2,               // 8 voices per lane group
+   kKernelNEON,               // reserved, there is no NEON kernel yet
+
+   kNumKernelTypes
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_KernelParams
+// --------------------------------------------------------------------------
+
+// values which are the same for all voices during one control period
+
+struct MeeblipVST_KernelParams
+{
+   const float* wavetable;    // MeeblipVST_Wavetables::getSaw()
+   float width;               // pulse width of oscillator A
+   float damping;             // 1/Q of the filter
+
+   VstInt32 oscBEnable;
+   VstInt32 oscBSquare;
+   VstInt32 oscAPulse;
+   VstInt32 oscANoise;
+   VstInt32 antiAlias;        // band limited tables, else 8 bit phase
+   VstInt32 fm;
+   VstInt32 distortion;
+   VstInt32 highPass;
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_Kernel
+// --------------------------------------------------------------------------
+
+// A kernel renders the voices first .. first+lanes-1 for sampleFrames samples
+// and adds their sum to buffer. All versions execute the same floating point
+// operations in the same order for each voice, so the voice state of a SIMD
+// kernel is bit exact to the scalar one. Only the order in which the voices
+// are summed differs, the output matches the scalar kernel within
+// kKernelTolerance.
+
+typedef void (*MeeblipVST_KernelProc)( MeeblipVST_VoiceState& s, const MeeblipVST_KernelParams& p, VstInt32 first, float* buffer, VstInt32 sampleFrames);
+
+struct MeeblipVST_Kernel
+{
+   KernelType type;
+   const char* name;
+   VstInt32 lanes;
+   MeeblipVST_KernelProc render;
+};
+
+static const float kKernelTolerance = 1.0e-5f;    // per voice, absolute
+
+// returns NULL if the kernel is not built in or not supported by the cpu
+const MeeblipVST_Kernel* getKernel( VstInt32 type);
+
+// the widest kernel supported by the cpu, selected once at runtime
+const MeeblipVST_Kernel* getBestKernel();
+
+// the voice in double precision for processDoubleReplacing: the scalar
+// kernel with phases, filter integrators and the sum in double, adds one
+// voice to buffer
+void renderVoiceDouble( MeeblipVST_VoiceState& s, const MeeblipVST_KernelParams& p, VstInt32 v, double* buffer, VstInt32 sampleFrames);
+
+#endif // __MeeblipVST_Kernel__
@@ -9,6 +9,22 @@
 // --------------------------------------------------------------------------
 // Changelog
 //
+//    17.10.2026  AWe   MeeblipVST_ParamScale holds no display strings
+//    17.10.2026  AWe   a short name of at most 7 characters per gui parameter
+//    17.10.2026  AWe   OSC_DETUNE is shown in cents
+//    17.10.2026  AWe   kNumParameters ends the parameter ids, kNumExtraParameters
+//                      is counted from it
+//    17.10.2026  AWe   add the render threads to the extra parameters
+//    17.10.2026  AWe   add the oversampling factors to the extra parameters
+//    17.10.2026  AWe   add the engine mode to the extra parameters
+//    17.10.2026  AWe   the gui parameters are defined in one X-macro table,
+//                      MEEBLIP_GUI_PARAMETERS, ids, count, CCs and the layout
+//                      are generated from it. Constant layout table, scaling
+//                      info per parameter
+//    17.10.2026  AWe   midi CC numbers as enum, MeeblipVST_CCMap for an O(1)
+//                      lookup of the parameter of a CC, with midi learn
+//    17.10.2026  AWe   add non gui parameters for the voice pool
+//    17.10.2026  AWe   add ids for the gui parameters, used by the synthesis engine
 //    11.09.2013  AWe   adapted to use vstsdk2.4 from VST3 SDK and vstqui4
 //    19.08.2013  AWe   add non gui parameters for midi channel selection
 //    01.08.2013  AWe   add MeeblipVST_ParamIds (previously they have their own file)
@@ -27,16 +43,118 @@
 //
 // --------------------------------------------------------------------------
 
+// --------------------------------------------------------------------------
+// gui parameters
+// --------------------------------------------------------------------------
+
+// All gui parameters in one table, the order is the parameter order of the
+// plugin and of the .fxp files. Everything else is generated from it at
+// compile time: the parameter ids, kNumGuiParameters, the CC numbers and
+// their duplicate check, the layout table and the scaling info.
+//
+// name   full name, served by getParameterProperties()
+// short  name of at most 7 characters, the VST 2 parameter name
+// kind   SWITCH  button, 0..1
+//        KNOB    knob, 0..127
+//        KNOB2   knob with center detent, -64..63
+// CC     midi controller of the meeblip SE V2
+// X, Y   position of the gui element
+// unit   appended to the display string, may be empty
+// smooth curve of the ramp to a new value in the engine, NONE, LINEAR or
+//        EXP, see MeeblipVST_Smoother.h
+// ms     ramp time in milliseconds
+//
+// spare knobs of the SE V2 front panel: CC 63, 62, 57 and 56
+
+#define MEEBLIP_GUI_PARAMETERS( X) \
+   /*  id           name            short      kind     CC  dflt    X    Y  unit     smooth   ms */ \
+   X( OscBWave,   "OSCB_WAVE",    "B_WAVE",  SWITCH,   75,    0,   45,  244, "",      NONE,     0) \
+   X( OscBEnable, "OSCB_ENABL",   "B_ON",    SWITCH,   74,    0,  105,  263, "",      NONE,     0) \
+   X( OscBOct,    "OSCB_OCT",     "B_OCT",   SWITCH,   73,    0,  165,  263, "",      NONE,     0) \
+   X( AntiAlias,  "ANTI_ALIAS",   "ANTI_AL", SWITCH,   72,    0,  225,  263, "",      NONE,     0) \
+   X( LfoWave,    "LFO_WAVE",     "LFOWAVE", SWITCH,   67,    0,  286,  263, "",      NONE,     0) \
+   X( LfoRandom,  "LFO_RANDOM",   "LFO_RND", SWITCH,   66,    0,  346,  263, "",      NONE,     0) \
+   X( OscFm,      "OSC_FM",       "OSC_FM",  SWITCH,   65,    0,  406,  263, "",      NONE,     0) \
+   X( KnobShift,  "KNOB_SHIFT",   "SHIFT",   SWITCH,   64,    0,  466,  244, "",      NONE,     0) \
+                                                                                                   \
+   X( OscAWave,   "OSCA_WAVE",    "A_WAVE",  SWITCH,   79,    0,   45,  168, "",      NONE,     0) \
+   X( PwmSweep,   "PWM_SWEEP",    "PWM_SWP", SWITCH,   78,    0,  105,  187, "",      NONE,     0) \
+   X( OscANoise,  "OSCA_NOISE",   "A_NOISE", SWITCH,   77,    0,  165,  187, "",      NONE,     0) \
+   X( Sustain,    "SUSTAIN",      "SUSTAIN", SWITCH,   76,    0,  225,  187, "",      NONE,     0) \
+   X( LfoDest,    "LFO_DEST",     "LFODEST", SWITCH,   71,    0,  286,  187, "",      NONE,     0) \
+   X( LfoEnable,  "LFO_ENABLE",   "LFO_ON",  SWITCH,   70,    0,  346,  187, "",      NONE,     0) \
+   X( Distortion, "DISTORTION",   "DIST",    SWITCH,   69,    0,  406,  187, "",      NONE,     0) \
+   X( FilterMode, "FILTER_MODE",  "FLTMODE", SWITCH,   68,    0,  466,  168, "",      NONE,     0) \
+                                                                                                   \
+   X( OscDetune,  "OSC_DETUNE",   "DETUNE",  KNOB2,    55,    0,   45,   93, " ct",   NONE,     0) \
+   X( PulseKnob,  "PULSE_KNOB",   "PULSE",   KNOB,     54,   64,  105,  112, "",      LINEAR,  10) \
+   X( Portamento, "PORTAMENTO",   "PORTA",   KNOB,     53,    0,  165,  112, "",      NONE,     0) \
+   X( VcfEnvMod,  "VCFENVMOD",    "ENVMOD",  KNOB2,    52,    0,  225,  112, "",      LINEAR,  20) \
+   X( LfoLevel,   "LFOLEVEL",     "LFO_LVL", KNOB,     51,    0,  286,  112, "",      NONE,     0) \
+   X( LfoFreq,    "LFOFREQ",      "LFOFREQ", KNOB,     50,    0,  346,  112, "",      NONE,     0) \
+   X( Cutoff,     "CUTOFF",       "CUTOFF",  KNOB,     49,  127,  406,  112, "",      LINEAR,  20) \
+   X( Resonance,  "RESONANCE",    "RESO",    KNOB,     48,    0,  466,   93, "",      EXP,     30) \
+                                                                                                   \
+   X( DcfAttack,  "DCF_ATTACK",   "DCF_ATK", KNOB,     61,    0,  165,   36, "",      NONE,     0) \
+   X( DcfDecay,   "DCF_DECAY",    "DCF_DCY", KNOB,     60,   96,  225,   36, "",      NONE,     0) \
+   X( AmpAttack,  "AMP_ATTACK",   "AMP_ATK", KNOB,     59,    0,  286,   36, "",      NONE,     0) \
+   X( AmpDecay,   "AMP_DECAY",    "AMP_DCY", KNOB,     58,   96,  346,   36, "",      NONE,     0) \
+   /* end of table */
+
+#define MEEBLIP_GUI_SWITCH    ButtonAnimated
+#define MEEBLIP_MIN_SWITCH    0
+#define MEEBLIP_MAX_SWITCH    1
+#define MEEBLIP_STEPS_SWITCH  1
+
+#define MEEBLIP_GUI_KNOB      KnobAnimated
+#define MEEBLIP_MIN_KNOB      0
+#define MEEBLIP_MAX_KNOB      127
+#define MEEBLIP_STEPS_KNOB    127
+
+#define MEEBLIP_GUI_KNOB2     Knob2Animated
+#define MEEBLIP_MIN_KNOB2     -64
+#define MEEBLIP_MAX_KNOB2     63
+#define MEEBLIP_STEPS_KNOB2   127
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
 enum MeeblipVST_ParamIds
 {
-//   kNumGuiParameters = sizeof( MeeblipVST_Layout)/ sizeof( MeeblipVST_LayoutItem),
-   kNumGuiParameters = 28,
+   // gui parameters, same order as in the MeeblipVST_Layout[] table
+#define MEEBLIP_PARAM_ID( id, name, shortName, kind, cc, dflt, x, y, unit, smooth, ms)   k##id,
+   MEEBLIP_GUI_PARAMETERS( MEEBLIP_PARAM_ID)
+#undef MEEBLIP_PARAM_ID
+
+   kNumGuiParameters,
 
    // extra parameters
    kMidiInChannel = kNumGuiParameters,
    kMidiOutChannel,
+   kPolyphony,
+   kVoiceMode,
+   kStealMode,
+   kEngineMode,
+   kOversampling,                // real-time factor
+   kOfflineOversampling,         // factor for offline rendering
+   kRenderThreads,               // threads which render the voices
 
-   kNumExtraParameters = 2,
+   // a new extra parameter goes above, the counts follow
+   kNumParameters,
+   kNumExtraParameters = kNumParameters - kNumGuiParameters
+};
+
+// midi controller numbers, checked for duplicates at compile time in
+// MeeblipVST_Layout.cpp
+
+enum MeeblipVST_CCs
+{
+#define MEEBLIP_PARAM_CC( id, name, shortName, kind, cc, dflt, x, y, unit, smooth, ms)   kCC##id = cc,
+   MEEBLIP_GUI_PARAMETERS( MEEBLIP_PARAM_CC)
+#undef MEEBLIP_PARAM_CC
+
+   kNumMidiCCs    = 128
 };
 
 enum GuiItemId
@@ -70,6 +188,7 @@ typedef struct tagMeeblipVST_LayoutItemBitmap  MeeblipVST_LayoutItemBitmap;
 struct tagMeeblipVST_LayoutItem
 {
    const char *parameterName;
+   const char *shortName;         // at most 7 characters, see kVstMaxParamStrLen
 
    const GuiItemId guiItem;
    const int32 posX;
@@ -89,15 +208,81 @@ typedef struct tagMeeblipVST_LayoutItem  MeeblipVST_LayoutItem;
 //
 // --------------------------------------------------------------------------
 
-MeeblipVST_LayoutItemBitmap MeeblipVST_Bitmaps[];
-MeeblipVST_LayoutItem MeeblipVST_Layout[];
+extern MeeblipVST_LayoutItemBitmap MeeblipVST_Bitmaps[];
+extern const MeeblipVST_LayoutItem MeeblipVST_Layout[ kNumGuiParameters];
+
+// --------------------------------------------------------------------------
+// MeeblipVST_ParamScale
+// --------------------------------------------------------------------------
+
+// scaling of a gui parameter between the normalized host value 0..1 and the
+// knob value of the meeblip, generated from the kind of the parameter. Only
+// the steps, their reciprocal and the minimum, the display strings are kept
+// by MeeblipVST_Display
+
+struct MeeblipVST_ParamScale
+{
+   float steps;                  // number of steps between min and max
+   float stepReciprocal;         // 1 / steps
+   int32 minValue;
+};
+
+extern const MeeblipVST_ParamScale MeeblipVST_ParamScales[ kNumGuiParameters];
+
+// nearest knob value, value is clipped to 0..1. No branches, the same code
+// for switches, knobs and bipolar knobs
+inline VstInt32 paramToKnobValue( float value, VstInt32 index)
+{
+   const MeeblipVST_ParamScale& scale = MeeblipVST_ParamScales[ index];
+
+   value = value > 0.0f ? value : 0.0f;
+   value = value < 1.0f ? value : 1.0f;
+   return scale.minValue + (VstInt32)( value * scale.steps + 0.5f);
+}
+
+inline float knobValueToParam( VstInt32 knobValue, VstInt32 index)
+{
+   const MeeblipVST_ParamScale& scale = MeeblipVST_ParamScales[ index];
+   return (float)( knobValue - scale.minValue) * scale.stepReciprocal;
+}
 
 // --------------------------------------------------------------------------
 //
 // --------------------------------------------------------------------------
 
 tresult mapCCToTag( CtrlNumber midiControllerNumber, ParamID &tag);
-MeeblipVST_LayoutItem *getLayoutItem( ParamID tag);
+const MeeblipVST_LayoutItem *getLayoutItem( ParamID tag);
+
+// --------------------------------------------------------------------------
+// MeeblipVST_CCMap
+// --------------------------------------------------------------------------
+
+// reverse map from midi channel and controller number to the gui parameter,
+// filled from the layout table for all channels. learn() assigns a CC to
+// a parameter on one channel and removes the previous assignment of this
+// parameter on that channel
+
+class MeeblipVST_CCMap
+{
+public:
+   enum { kNumChannels = 16, kNone = -1 };
+
+   MeeblipVST_CCMap()   { reset(); }
+
+   void reset();
+
+   // the gui parameter, or kNone
+   VstInt32 getParameter( VstInt32 channel, VstInt32 cc)
+   {
+      return map[ channel & 0x0f][ cc & 0x7f];
+   }
+
+   void learn( VstInt32 channel, VstInt32 cc, VstInt32 parameter);
+   void forget( VstInt32 channel, VstInt32 cc)   { map[ channel & 0x0f][ cc & 0x7f] = kNone; }
+
+protected:
+   signed char map[ kNumChannels][ kNumMidiCCs];
+};
 
 // --------------------------------------------------------------------------
 //
@@ -0,0 +1,84 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_MidiLink.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   one schedule of the midi link to the hardware, shared
+//                      by the CC output and the sysex sender
+//
+// --------------------------------------------------------------------------
+
+#ifndef __MeeblipVST_MidiLink__
+#define __MeeblipVST_MidiLink__
+
+#include "pluginterfaces/vst2.x/aeffect.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// 31250 baud, 10 bits per byte
+#define MIDI_DIN_BYTES_PER_SECOND   3125.0f
+
+// --------------------------------------------------------------------------
+// MeeblipVST_MidiLink
+// --------------------------------------------------------------------------
+
+// The CCs and the sysex messages go out over the same cable. Every message
+// occupies the link for its bytes at the byte rate, the next one, of any
+// kind, starts when the link is free again. The times are frames relative
+// to the current block, endBlock() moves them to the next one.
+//
+// Audio thread only, except setBytesPerSecond() and setSampleRate() which
+// are called while the plugin is suspended.
+
+class MeeblipVST_MidiLink
+{
+public:
+   MeeblipVST_MidiLink()
+      : sampleRate( 44100.0f)
+      , bytesPerSecond( MIDI_DIN_BYTES_PER_SECOND)
+      , nextFreeFrame( 0.0)
+   {
+   }
+
+   void setSampleRate( float sampleRate)     { this->sampleRate = sampleRate; }
+
+   // 0 disables the rate limit
+   void setBytesPerSecond( float bytesPerSecond)
+   {
+      this->bytesPerSecond = bytesPerSecond > 0.0f ? bytesPerSecond : 0.0f;
+   }
+   float getBytesPerSecond()                 { return bytesPerSecond; }
+
+   // the first frame at or after frame the link is free
+   double getFreeFrame( double frame)        { return frame > nextFreeFrame ? frame : nextFreeFrame; }
+
+   // a message of bytes leaves at frame
+   void occupy( double frame, VstInt32 bytes)
+   {
+      nextFreeFrame = frame;
+      if( bytesPerSecond > 0.0f)
+         nextFreeFrame += (double)bytes * sampleRate / bytesPerSecond;
+   }
+
+   void endBlock( VstInt32 sampleFrames)
+   {
+      nextFreeFrame -= sampleFrames;
+      if( nextFreeFrame < 0.0)
+         nextFreeFrame = 0.0;
+   }
+
+protected:
+   float sampleRate;
+   float bytesPerSecond;
+   double nextFreeFrame;         // first frame the link is free, relative to the block
+};
+
+#endif // __MeeblipVST_MidiLink__
@@ -0,0 +1,346 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Oversampler.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   template over the sample type, SSE2 for double
+//    17.10.2026  AWe   2x/4x/8x decimation with polyphase half-band stages
+//
+// --------------------------------------------------------------------------
+
+// The SSE2 version computes 4 float or 2 double outputs at once, each lane
+// adds the taps in the same order as the scalar loop, so both versions give
+// the same samples.
+
+#include "MeeblipVST_Oversampler.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined( _M_IX86) || defined( _M_X64) || defined( __i386__) || defined( __x86_64__)
+ #if defined( _MSC_VER) || defined( __SSE2__)
+  #define OVERSAMPLER_SSE2 1
+  #include <emmintrin.h>
+ #endif
+#endif
+
+// --------------------------------------------------------------------------
+// Debug support
+// --------------------------------------------------------------------------
+
+#define VERBOSITY       99
+#define VERBOSITY_MIN   1
+
+#include "aweDBG.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static const double kPi = 3.14159265358979323846;
+
+// the last stage is steep: 63 taps, flat to 0.82 * nyquist, -80 dB above
+// 1.18 * nyquist. The stages before it only have to keep the band of the
+// final output clean, 15 taps
+static const VstInt32 kFinalHalfTaps = 16;
+static const float    kFinalBeta     = 8.0f;
+static const VstInt32 kEarlyHalfTaps = 4;
+static const float    kEarlyBeta     = 6.0f;
+
+// modified bessel function of order 0, for the kaiser window
+static double besselI0( double x)
+{
+   double sum = 1.0;
+   double term = 1.0;
+   for( VstInt32 k = 1; k < 50; k++)
+   {
+      term *= (x / (2.0 * k)) * (x / (2.0 * k));
+      sum += term;
+      if( term < sum * 1.0e-12)
+         break;
+   }
+   return sum;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the outputs 0 .. n-1 of a stage in groups of the vector width, returns n
+
+#if OVERSAMPLER_SSE2
+
+static VstInt32 decimateSSE2( const float* taps, VstInt32 numTaps, const float* even, const float* odd, float* output, VstInt32 sampleFrames)
+{
+   const __m128 half = _mm_set1_ps( 0.5f);
+   VstInt32 m = 0;
+   for( ; m + 4 <= sampleFrames; m += 4)
+   {
+      __m128 sum = _mm_setzero_ps();
+      for( VstInt32 j = 0; j < numTaps; j++)
+         sum = _mm_add_ps( sum, _mm_mul_ps( _mm_set1_ps( taps[j]), _mm_loadu_ps( odd + m + j)));
+
+      _mm_storeu_ps( output + m, _mm_add_ps( _mm_mul_ps( half, _mm_loadu_ps( even + m)), sum));
+   }
+   return m;
+}
+
+static VstInt32 decimateSSE2( const double* taps, VstInt32 numTaps, const double* even, const double* odd, double* output, VstInt32 sampleFrames)
+{
+   const __m128d half = _mm_set1_pd( 0.5);
+   VstInt32 m = 0;
+   for( ; m + 2 <= sampleFrames; m += 2)
+   {
+      __m128d sum = _mm_setzero_pd();
+      for( VstInt32 j = 0; j < numTaps; j++)
+         sum = _mm_add_pd( sum, _mm_mul_pd( _mm_set1_pd( taps[j]), _mm_loadu_pd( odd + m + j)));
+
+      _mm_storeu_pd( output + m, _mm_add_pd( _mm_mul_pd( half, _mm_loadu_pd( even + m)), sum));
+   }
+   return m;
+}
+
+#endif
+
+// --------------------------------------------------------------------------
+//  MeeblipVST_HalfBand Implementation
+// --------------------------------------------------------------------------
+
+template <typename FloatType>
+MeeblipVST_HalfBand<FloatType>::MeeblipVST_HalfBand()
+   : halfTaps( 0)
+   , taps( NULL)
+   , even( NULL)
+   , odd( NULL)
+   , memory( NULL)
+{
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+template <typename FloatType>
+MeeblipVST_HalfBand<FloatType>::~MeeblipVST_HalfBand()
+{
+   free();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+template <typename FloatType>
+void MeeblipVST_HalfBand<FloatType>::free()
+{
+   delete[] memory;
+   memory = NULL;
+   taps = even = odd = NULL;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// kaiser windowed sinc, the odd coefficient at distance 2k+1 from the
+// center is (-1)^k / (pi (2k+1)), scaled to a gain of 1 at DC
+
+template <typename FloatType>
+void MeeblipVST_HalfBand<FloatType>::init( VstInt32 halfTaps, float beta, VstInt32 maxOutput)
+{
+   DBG( 1, "\nMeeblipVST_HalfBand::init %d taps, %d frames", 4 * halfTaps - 1, maxOutput );
+
+   free();
+   this->halfTaps = halfTaps;
+
+   VstInt32 numTaps = 2 * halfTaps;
+   VstInt32 evenSize = halfTaps - 1 + maxOutput;
+   VstInt32 oddSize = numTaps - 1 + maxOutput;
+
+   // 4 extra samples to align the taps to 16 bytes
+   memory = new FloatType[ numTaps + evenSize + oddSize + 4];
+   taps = (FloatType*)( ( (size_t)memory + 15) & ~(size_t)15);
+   even = taps + numTaps;
+   odd = even + evenSize;
+
+   double* c = new double[ halfTaps];
+   double sum = 0.0;
+   double norm = besselI0( beta);
+
+   for( VstInt32 k = 0; k < halfTaps; k++)
+   {
+      double n = 2 * k + 1;
+      double r = n / (2.0 * halfTaps);
+      double window = besselI0( beta * sqrt( 1.0 - r * r)) / norm;
+      c[k] = ( (k & 1) ? -1.0 : 1.0) / (kPi * n) * window;
+      sum += 2.0 * c[k];
+   }
+
+   // taps[j] multiplies odd[m + j]: c[M-1] .. c[0] c[0] .. c[M-1]
+   for( VstInt32 k = 0; k < halfTaps; k++)
+   {
+      FloatType t = (FloatType)( c[k] * 0.5 / sum);
+      taps[ halfTaps - 1 - k] = t;
+      taps[ halfTaps + k] = t;
+   }
+
+   delete[] c;
+   reset();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+template <typename FloatType>
+void MeeblipVST_HalfBand<FloatType>::reset()
+{
+   if( memory == NULL)
+      return;
+
+   memset( even, 0, (halfTaps - 1) * sizeof( FloatType));
+   memset( odd, 0, (2 * halfTaps - 1) * sizeof( FloatType));
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// input and output may be the same buffer, the input is split into the
+// branches before the first output is written
+
+template <typename FloatType>
+void MeeblipVST_HalfBand<FloatType>::process( const FloatType* input, FloatType* output, VstInt32 sampleFrames)
+{
+   const VstInt32 numTaps = 2 * halfTaps;
+   const VstInt32 evenHistory = halfTaps - 1;
+   const VstInt32 oddHistory = numTaps - 1;
+
+   FloatType* e = even + evenHistory;
+   FloatType* o = odd + oddHistory;
+   for( VstInt32 i = 0; i < sampleFrames; i++)
+   {
+      e[i] = input[ 2 * i];
+      o[i] = input[ 2 * i + 1];
+   }
+
+#if OVERSAMPLER_SSE2
+   VstInt32 m = decimateSSE2( taps, numTaps, even, odd, output, sampleFrames);
+#else
+   VstInt32 m = 0;
+#endif
+
+   for( ; m < sampleFrames; m++)
+   {
+      FloatType sum = 0;
+      for( VstInt32 j = 0; j < numTaps; j++)
+         sum += taps[j] * odd[ m + j];
+
+      output[m] = FloatType( 0.5) * even[m] + sum;
+   }
+
+   // keep the history for the next call
+   memmove( even, even + sampleFrames, evenHistory * sizeof( FloatType));
+   memmove( odd, odd + sampleFrames, oddHistory * sizeof( FloatType));
+}
+
+// --------------------------------------------------------------------------
+//  MeeblipVST_Oversampler Implementation
+// --------------------------------------------------------------------------
+
+template <typename FloatType>
+MeeblipVST_Oversampler<FloatType>::MeeblipVST_Oversampler()
+   : factor( 1)
+   , numStages( 0)
+{
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+template <typename FloatType>
+void MeeblipVST_Oversampler<FloatType>::setFactor( VstInt32 factor, VstInt32 maxFrames)
+{
+   DBG( 1, "\nMeeblipVST_Oversampler::setFactor %d", factor );
+
+   numStages = factor >= 8 ? 3 : factor >= 4 ? 2 : factor >= 2 ? 1 : 0;
+   this->factor = 1 << numStages;
+
+   // stage 0 runs at the highest rate, the last stage outputs maxFrames
+   for( VstInt32 s = 0; s < numStages; s++)
+   {
+      VstInt32 maxOutput = maxFrames << (numStages - 1 - s);
+      if( s == numStages - 1)
+         stages[s].init( kFinalHalfTaps, kFinalBeta, maxOutput);
+      else
+         stages[s].init( kEarlyHalfTaps, kEarlyBeta, maxOutput);
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+template <typename FloatType>
+void MeeblipVST_Oversampler<FloatType>::reset()
+{
+   for( VstInt32 s = 0; s < numStages; s++)
+      stages[s].reset();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the input buffer is the scratch memory of the stages
+
+template <typename FloatType>
+void MeeblipVST_Oversampler<FloatType>::process( FloatType* input, FloatType* output, VstInt32 sampleFrames)
+{
+   if( numStages == 0)
+   {
+      memcpy( output, input, sampleFrames * sizeof( FloatType));
+      return;
+   }
+
+   for( VstInt32 s = 0; s < numStages - 1; s++)
+      stages[s].process( input, input, sampleFrames << (numStages - 1 - s));
+
+   stages[ numStages - 1].process( input, output, sampleFrames);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+template <typename FloatType>
+VstInt32 MeeblipVST_Oversampler<FloatType>::getLatency() const
+{
+   // latency of stage s in its input samples, 2^(numStages - s) of them
+   // make one output sample
+   double latency = 0.0;
+   for( VstInt32 s = 0; s < numStages; s++)
+      latency += (double)stages[s].getLatency() / (1 << (numStages - s));
+
+   return (VstInt32)( latency + 0.5);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the float version for processReplacing, the double one for
+// processDoubleReplacing
+
+template class MeeblipVST_HalfBand<float>;
+template class MeeblipVST_HalfBand<double>;
+template class MeeblipVST_Oversampler<float>;
+template class MeeblipVST_Oversampler<double>;
@@ -0,0 +1,108 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Oversampler.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   template over the sample type
+//    17.10.2026  AWe   2x/4x/8x decimation with polyphase half-band stages
+//
+// --------------------------------------------------------------------------
+
+#ifndef __MeeblipVST_Oversampler__
+#define __MeeblipVST_Oversampler__
+
+#include "aweVSTtypes.h"
+#include "pluginterfaces/vst2.x/aeffect.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+enum
+{
+   kNumOversampleFactors = 4,       // 1x, 2x, 4x, 8x
+   kMaxOversampleStages  = kNumOversampleFactors - 1
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_HalfBand
+// --------------------------------------------------------------------------
+
+// One 2:1 stage. The half-band filter has every second coefficient zero
+// except the center one, split into its two polyphase branches only the odd
+// input samples pass the FIR, the even ones are the center tap:
+//
+//    y[m] = 0.5 * even[m - M + 1] + sum( t[j] * odd[m - 2M + 1 + j]),  j = 0..2M-1
+//
+// The latency is 2M - 1 input samples. FloatType is float or double, the
+// instances are in MeeblipVST_Oversampler.cpp.
+
+template <typename FloatType>
+class MeeblipVST_HalfBand
+{
+public:
+   MeeblipVST_HalfBand();
+   ~MeeblipVST_HalfBand();
+
+   // allocates the branches for up to maxOutput samples per call
+   void init( VstInt32 halfTaps, float beta, VstInt32 maxOutput);
+   void reset();
+
+   // 2 * sampleFrames samples in, sampleFrames out
+   void process( const FloatType* input, FloatType* output, VstInt32 sampleFrames);
+
+   VstInt32 getLatency() const   { return 2 * halfTaps - 1; }
+
+protected:
+   void free();
+
+   VstInt32 halfTaps;      // M, a multiple of 2
+   FloatType* taps;        // 2M coefficients of the odd branch, 16 byte aligned
+   FloatType* even;        // M - 1 history + maxOutput
+   FloatType* odd;         // 2M - 1 history + maxOutput
+   FloatType* memory;
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_Oversampler
+// --------------------------------------------------------------------------
+
+// The voices are synthesized at factor times the sample rate, so there is
+// nothing to upsample. The oversampler brings the mix back to the sample
+// rate with a cascade of half-band stages, the stages at the higher rates
+// have a wide transition band and few taps, the last one is steep.
+//
+// setFactor() allocates and must not be called from the audio thread, the
+// plugin calls it in resume(). process() runs on preallocated memory.
+
+template <typename FloatType>
+class MeeblipVST_Oversampler
+{
+public:
+   MeeblipVST_Oversampler();
+
+   // 1, 2, 4 or 8. maxFrames is the largest sampleFrames of process()
+   void setFactor( VstInt32 factor, VstInt32 maxFrames);
+   VstInt32 getFactor() const   { return factor; }
+
+   void reset();
+
+   // factor * sampleFrames samples in, sampleFrames out
+   void process( FloatType* input, FloatType* output, VstInt32 sampleFrames);
+
+   // rounded to whole samples at the output rate
+   VstInt32 getLatency() const;
+
+protected:
+   VstInt32 factor;
+   VstInt32 numStages;
+   MeeblipVST_HalfBand<FloatType> stages[ kMaxOversampleStages];
+};
+
+#endif // __MeeblipVST_Oversampler__
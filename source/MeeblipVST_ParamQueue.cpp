@@ -0,0 +1,280 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_ParamQueue.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   the audio thread takes back the queue of a thread which
+//                      pushed nothing for PARAM_PRODUCER_IDLE_TIME, the producer
+//                      marks its queue busy while it pushes
+//    17.10.2026  AWe   push() with the time of the change, for parameter sets
+//    17.10.2026  AWe   hand parameter changes from the gui and automation
+//                      threads to the audio thread without locks
+//
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST_ParamQueue.h"
+
+#include <stddef.h>
+#include <string.h>
+
+// --------------------------------------------------------------------------
+// Debug support
+// --------------------------------------------------------------------------
+
+#define VERBOSITY       99
+#define VERBOSITY_MIN   1
+
+#include "aweDBG.h"
+
+// --------------------------------------------------------------------------
+//  MeeblipVST_ParamQueue Implementation
+// --------------------------------------------------------------------------
+
+MeeblipVST_ParamQueue::MeeblipVST_ParamQueue()
+   : audioThread( NULL)
+   , overflows( 0)
+   , lastBlockTime( 0.0)
+   , blockTime( 0.0)
+   , numPending( 0)
+{
+   for( VstInt32 i = 0; i < kMaxParamProducers; i++)
+   {
+      producers[i] = NULL;
+      busy[i] = 0;
+      lastOwner[i] = NULL;
+      lastActive[i] = 0.0;
+   }
+
+   for( VstInt32 i = 0; i < kNumParameters; i++)
+   {
+      changed[i] = 0;
+      latestValue[i] = 0;
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_ParamQueue::allocate()
+{
+   DBG( 1, "\nMeeblipVST_ParamQueue::allocate" );
+
+   for( VstInt32 i = 0; i < kMaxParamProducers; i++)
+      queues[i].allocate( kParamQueueSize);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the queue owned by the calling thread, a free queue is claimed if it has
+// none. The queue is busy until releaseQueue(), the audio thread doesn't
+// take it back meanwhile. -1 if all queues belong to other threads
+
+VstInt32 MeeblipVST_ParamQueue::acquireQueue()
+{
+   aweThreadId self = aweCurrentThreadId();
+
+   // first the own queue, a thread never holds two
+   for( VstInt32 pass = 0; pass < 2; pass++)
+   {
+      for( VstInt32 i = 0; i < kMaxParamProducers; i++)
+      {
+         if( pass == 0 && aweAtomicLoadPtr( &producers[i]) != self)
+            continue;
+
+         if( pass == 1)
+         {
+            if( !aweAtomicCompareExchangePtr( &producers[i], NULL, self))
+               continue;
+            DBG( 2, "      parameter queue %d for thread %p", i, self );
+         }
+
+         // busy before the owner is checked again, reclaimQueue() tests
+         // them in the opposite order
+         aweAtomicExchange( &busy[i], 1);
+         aweAtomicFence();
+         if( aweAtomicLoadPtr( &producers[i]) == self)
+            return i;
+
+         // taken back by the audio thread
+         aweAtomicStore( &busy[i], 0);
+      }
+   }
+
+   return -1;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// audio thread, takes the queue away from owner. The owner sees it before
+// it pushes, or the audio thread sees that it is busy
+
+bool MeeblipVST_ParamQueue::reclaimQueue( VstInt32 q, void* owner)
+{
+   if( !aweAtomicCompareExchangePtr( &producers[q], owner, this))
+      return false;
+
+   aweAtomicFence();
+   if( aweAtomicLoad( &busy[q]) != 0)
+   {
+      aweAtomicStorePtr( &producers[q], owner);
+      return false;
+   }
+   return true;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_ParamQueue::markChanged( VstInt32 index, float value, bool sendCC)
+{
+   int32 bits;
+   memcpy( &bits, &value, sizeof( bits));
+
+   aweAtomicStore( &latestValue[ index], bits);
+   aweAtomicStore( &changed[ index], kParamChanged | (sendCC ? kParamSendCC : 0));
+   aweAtomicAdd( &overflows, 1);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_ParamQueue::push( VstInt32 index, float value, bool sendCC, double time)
+{
+   if( index < 0 || index >= kNumParameters)
+      return;
+
+   MeeblipVST_ParamChange change;
+   change.index = index;
+   change.value = value;
+   change.flags = kParamChanged | (sendCC ? kParamSendCC : 0);
+   change.time  = time;
+   change.deltaFrames = 0;
+
+   // once a parameter is marked, its later changes have to follow the mark
+   VstInt32 q = acquireQueue();
+   bool queued = q >= 0 && aweAtomicLoad( &changed[ index]) == 0 && queues[q].push( change);
+   if( q >= 0)
+      releaseQueue( q);
+   if( !queued)
+      markChanged( index, value, sendCC);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_ParamQueue::beginBlock( float sampleRate, VstInt32 sampleFrames)
+{
+   double now = aweGetTime();
+   lastBlockTime = blockTime > 0.0 ? blockTime : now;
+   blockTime = now;
+   numPending = 0;
+
+   VstInt32 lastFrame = sampleFrames > 0 ? sampleFrames - 1 : 0;
+
+   // after a pause of the audio thread the timing has no meaning
+   if( sampleRate <= 0.0f || blockTime - lastBlockTime > 2.0 * sampleFrames / sampleRate)
+      lastFrame = 0;
+
+   for( VstInt32 q = 0; q < kMaxParamProducers; q++)
+   {
+      // an idle queue is taken back, if no changes arrived since the
+      // last block it is empty after the ones below were collected
+      void* owner = aweAtomicLoadPtr( &producers[q]);
+      bool reclaim = owner != NULL && owner == lastOwner[q]
+                  && blockTime - lastActive[q] > PARAM_PRODUCER_IDLE_TIME
+                  && reclaimQueue( q, owner);
+
+      if( owner != lastOwner[q])
+      {
+         lastOwner[q] = owner;
+         lastActive[q] = blockTime;
+      }
+
+      bool drained = false;
+      for( ;;)
+      {
+         if( numPending >= kMaxPendingChanges)
+            break;
+         if( !queues[q].pop( pending[ numPending]))
+         {
+            drained = true;
+            break;
+         }
+
+         lastActive[q] = blockTime;
+         MeeblipVST_ParamChange& change = pending[ numPending++];
+
+         double offset = (change.time - lastBlockTime) * sampleRate;
+         if( offset < 0.0)
+            change.deltaFrames = 0;
+         else if( offset > lastFrame)
+            change.deltaFrames = lastFrame;
+         else
+            change.deltaFrames = (VstInt32)offset;
+      }
+
+      if( reclaim)
+      {
+         if( drained && lastActive[q] < blockTime)
+         {
+            DBG( 2, "      parameter queue %d of thread %p is free", q, owner );
+            lastOwner[q] = NULL;
+            aweAtomicStorePtr( &producers[q], NULL);
+         }
+         else
+            aweAtomicStorePtr( &producers[q], owner);
+      }
+   }
+
+   // a marked value is newer than the queued changes of its parameter,
+   // those were pushed before the mark was set. Drop them and apply the
+   // marked value at the start of the block
+   for( VstInt32 i = 0; i < kNumParameters; i++)
+   {
+      if( aweAtomicLoad( &changed[i]) == 0)
+         continue;
+
+      VstInt32 n = 0;
+      for( VstInt32 k = 0; k < numPending; k++)
+      {
+         if( pending[k].index != i)
+            pending[ n++] = pending[k];
+      }
+      numPending = n;
+
+      if( numPending >= kMaxPendingChanges)
+         break;
+
+      MeeblipVST_ParamChange& change = pending[ numPending++];
+      change.flags = aweAtomicExchange( &changed[i], 0);
+      change.index = i;
+      int32 bits = aweAtomicLoad( &latestValue[i]);
+      memcpy( &change.value, &bits, sizeof( bits));
+      change.time  = lastBlockTime;
+      change.deltaFrames = 0;
+   }
+
+   // merge the queues, insertion sort keeps the order of each producer
+   for( VstInt32 i = 1; i < numPending; i++)
+   {
+      MeeblipVST_ParamChange change = pending[i];
+      VstInt32 j = i;
+      for( ; j > 0 && change.deltaFrames < pending[j-1].deltaFrames; j--)
+         pending[j] = pending[j-1];
+      pending[j] = change;
+   }
+}
@@ -0,0 +1,139 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_ParamQueue.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   an idle queue is taken back by the audio thread, threads
+//                      which end no longer keep their queue
+//    17.10.2026  AWe   kNumParameters moved to MeeblipVST_Layout.h
+//    17.10.2026  AWe   push() with the time of the change, for parameter sets
+//    17.10.2026  AWe   hand parameter changes from the gui and automation
+//                      threads to the audio thread without locks
+//
+// --------------------------------------------------------------------------
+
+#ifndef __MeeblipVST_ParamQueue__
+#define __MeeblipVST_ParamQueue__
+
+#include "MeeblipVST_Layout.h"
+#include "aweSPSCQueue.h"
+#include "aweThread.h"
+#include "pluginterfaces/vst2.x/aeffect.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// a queue whose thread has pushed nothing for this time, in seconds, is
+// taken back by the audio thread and free for the next thread
+#define PARAM_PRODUCER_IDLE_TIME   1.0
+
+enum
+{
+   kMaxParamProducers   = 4,     // threads which push at the same time, see
+                                 // PARAM_PRODUCER_IDLE_TIME
+   kParamQueueSize      = 512,   // changes per producer between two blocks
+   kMaxPendingChanges   = 512    // changes applied in one block
+};
+
+enum ParamChangeFlags
+{
+   kParamChanged = 1,
+   kParamSendCC  = 2             // send the new value to the hardware
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_ParamChange
+// --------------------------------------------------------------------------
+
+struct MeeblipVST_ParamChange
+{
+   VstInt32 index;
+   float value;
+   VstInt32 flags;
+   double time;                  // aweGetTime() of the producer
+   VstInt32 deltaFrames;         // position in the block, set by the audio thread
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_ParamQueue
+// --------------------------------------------------------------------------
+
+// Every thread which calls setParameter() gets its own single producer/
+// single consumer queue on its first call, the audio thread is the consumer
+// of all of them. At the start of a block the audio thread collects the
+// changes, sorts them by time and places them in the block at the distance
+// they had to the start of the previous block. So a knob movement is
+// reproduced with the timing of the gui, delayed by one block.
+//
+// A thread doesn't tell when it ends, hosts start and stop threads for
+// automation or offline work. So the audio thread takes a queue back once
+// it is empty and its thread has pushed nothing for
+// PARAM_PRODUCER_IDLE_TIME. The producer marks its queue busy while it
+// pushes, a busy queue is not taken back. A thread which pushes again
+// after that claims a free queue like on its first call.
+//
+// If more than kMaxParamProducers threads push within that time, or a
+// queue is full, the parameter is only marked as changed and applied at
+// the start of the next block with its latest value. Nothing is lost, only
+// the timing.
+
+class MeeblipVST_ParamQueue
+{
+public:
+   MeeblipVST_ParamQueue();
+
+   // outside of the audio thread, before the first push()
+   void allocate();
+
+   // the audio thread registers itself at the start of every block, a
+   // setParameter() on this thread is applied directly
+   void setAudioThread()   { aweAtomicStorePtr( &audioThread, aweCurrentThreadId()); }
+   bool isAudioThread()    { return aweCurrentThreadId() == aweAtomicLoadPtr( &audioThread); }
+
+   // producer side, any thread except the audio thread. Changes pushed
+   // with the same time, like the parameters of a program, are applied at
+   // the same sample
+   void push( VstInt32 index, float value, bool sendCC)  { push( index, value, sendCC, aweGetTime()); }
+   void push( VstInt32 index, float value, bool sendCC, double time);
+
+   // consumer side, collect the changes for the next block of sampleFrames
+   void beginBlock( float sampleRate, VstInt32 sampleFrames);
+
+   VstInt32 getNumPending()                              { return numPending; }
+   const MeeblipVST_ParamChange& getPending( VstInt32 i) { return pending[i]; }
+
+   // changes which were not queued but marked
+   VstInt32 getOverflows()                               { return aweAtomicLoad( &overflows); }
+
+protected:
+   VstInt32 acquireQueue();
+   void releaseQueue( VstInt32 q)                        { aweAtomicStore( &busy[q], 0); }
+   bool reclaimQueue( VstInt32 q, void* owner);
+   void markChanged( VstInt32 index, float value, bool sendCC);
+
+   aweSPSCQueue<MeeblipVST_ParamChange> queues[ kMaxParamProducers];
+   void* volatile producers[ kMaxParamProducers];     // owner thread of each queue
+   volatile int32 busy[ kMaxParamProducers];          // the owner is in push()
+   void* lastOwner[ kMaxParamProducers];              // audio thread only
+   double lastActive[ kMaxParamProducers];            // blockTime of the last change
+   aweThreadId volatile audioThread;
+
+   volatile int32 changed[ kNumParameters];           // ParamChangeFlags
+   volatile int32 latestValue[ kNumParameters];       // bits of the float value
+   volatile int32 overflows;
+
+   double lastBlockTime;
+   double blockTime;
+
+   MeeblipVST_ParamChange pending[ kMaxPendingChanges];
+   VstInt32 numPending;
+};
+
+#endif // __MeeblipVST_ParamQueue__
@@ -0,0 +1,1305 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_PatchLibrary.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   loadPatch() builds the path with snprintf()
+//    17.10.2026  AWe   .syx files with the sysex dumps of the hardware
+//    17.10.2026  AWe   patch library, memory mapped index over the .fxp and
+//                      .fxb files of a directory tree
+//
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST_PatchLibrary.h"
+#include "MeeblipVST_Chunk.h"
+#include "MeeblipVST_Sysex.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// VS2010 has only _snprintf, it returns -1 if the text is truncated and
+// then doesn't terminate it. The callers check the result
+#if defined( _MSC_VER) && _MSC_VER < 1900
+ #define snprintf _snprintf
+#endif
+
+// --------------------------------------------------------------------------
+// Debug support
+// --------------------------------------------------------------------------
+
+#define VERBOSITY       99
+#define VERBOSITY_MIN   1
+
+#include "aweDBG.h"
+
+// --------------------------------------------------------------------------
+// index file
+// --------------------------------------------------------------------------
+
+// All values are little endian int32, the sections follow each other:
+//
+//    header         kNumIndexFields
+//    file           [ numFiles]      kNumFileFields
+//    patch          [ numPatches]    kNumPatchFields
+//    fingerprint    [ numPatches]    kNumGuiParameters midi values, bytes
+//    sorted         [ numPatches]    patch numbers in the order of the names
+//    hash           [ hashSize]      patch + 1, 0 for an empty slot
+//    strings        zero terminated, the paths, names and tags are offsets
+//
+// The index is only a cache of the patch files. A different version or
+// parameter count is rejected and update() writes it new.
+
+enum
+{
+   kIndexMagic          = CCONST( 'M', 'B', 'i', 'x'),
+   kIndexVersion        = 1
+};
+
+enum IndexField
+{
+   kIndexMagicField = 0,
+   kIndexVersionField,
+   kIndexNumParameters,
+   kIndexNumFiles,
+   kIndexNumPatches,
+   kIndexHashSize,
+   kIndexFiles,
+   kIndexPatches,
+   kIndexFingerprints,
+   kIndexSorted,
+   kIndexHash,
+   kIndexStrings,
+   kIndexStringsSize,
+
+   kNumIndexFields
+};
+
+enum FileField
+{
+   kFilePath = 0,
+   kFileSizeLow,
+   kFileSizeHigh,
+   kFileTimeLow,
+   kFileTimeHigh,
+   kFileFirstPatch,
+   kFileNumPatches,
+
+   kNumFileFields
+};
+
+enum PatchField
+{
+   kPatchFile = 0,
+   kPatchProgram,
+   kPatchOffset,                 // of the first parameter in the file
+   kPatchFormat,
+   kPatchCount,                  // of the parameters in the file
+   kPatchName,
+   kPatchTags,
+   kPatchNameHash,
+
+   kNumPatchFields
+};
+
+enum
+{
+   kFileRecordSize      = 4 * kNumFileFields,
+   kPatchRecordSize     = 4 * kNumPatchFields,
+
+   // fxProgram: chunkMagic, byteSize, fxMagic, version, fxID, fxVersion,
+   // numParams, prgName[ 28], then the parameters or the chunk size
+   kFxProgramHeader     = 56,
+   kFxProgramNameLen    = 28,
+
+   // fxBank: chunkMagic, byteSize, fxMagic, version, fxID, fxVersion,
+   // numPrograms, future[ 128], then the programs or the chunk size
+   kFxBankHeader        = 156
+};
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static VstInt32 readLE32( const unsigned char* p)
+{
+   return (VstInt32)( (uint32)p[0] | ( (uint32)p[1] << 8) | ( (uint32)p[2] << 16) | ( (uint32)p[3] << 24));
+}
+
+static VstInt32 readBE32( const unsigned char* p)
+{
+   return (VstInt32)( ( (uint32)p[0] << 24) | ( (uint32)p[1] << 16) | ( (uint32)p[2] << 8) | (uint32)p[3]);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// names and tags are compared without case, ASCII only
+
+static inline unsigned char foldChar( char c)
+{
+   return ( c >= 'A' && c <= 'Z') ? (unsigned char)( c - 'A' + 'a') : (unsigned char)c;
+}
+
+static uint32 hashName( const char* name)
+{
+   // FNV-1a
+   uint32 hash = 2166136261u;
+   while( *name)
+      hash = ( hash ^ foldChar( *name++)) * 16777619u;
+   return hash;
+}
+
+static int compareNames( const char* a, const char* b)
+{
+   while( *a && foldChar( *a) == foldChar( *b))
+   {
+      a++;
+      b++;
+   }
+   return (int)foldChar( *a) - (int)foldChar( *b);
+}
+
+static bool startsWith( const char* name, const char* prefix)
+{
+   while( *prefix)
+   {
+      if( foldChar( *name++) != foldChar( *prefix++))
+         return false;
+   }
+   return true;
+}
+
+static bool hasExtension( const char* path, const char* extension)
+{
+   size_t length = strlen( path);
+   size_t extensionLength = strlen( extension);
+
+   return length > extensionLength && compareNames( path + length - extensionLength, extension) == 0;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// bytes per value in the file
+static VstInt32 valueSize( VstInt32 format)
+{
+   return format == kPatchSysex ? 1 : 4;
+}
+
+static void readValues( const unsigned char* p, VstInt32 format, VstInt32 count, float* values)
+{
+   if( format == kPatchSysex)
+   {
+      for( VstInt32 i = 0; i < count; i++)
+         values[ i] = ( p[ i] & 0x7f) * ( 1.0f / 127.0f);
+      return;
+   }
+
+   for( VstInt32 i = 0; i < count; i++, p += 4)
+   {
+      VstInt32 bits = format == kPatchFxParams ? readBE32( p) : readLE32( p);
+      float value;
+      memcpy( &value, &bits, sizeof( value));
+
+      // also catches NaN
+      if( !( value >= 0.0f))
+         value = 0.0f;
+      if( value > 1.0f)
+         value = 1.0f;
+      values[ i] = value;
+   }
+}
+
+static void makeFingerprint( const float* values, unsigned char* fingerprint)
+{
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+   {
+      float value = values[ i] > 0.0f ? values[ i] : 0.0f;
+      value = value < 1.0f ? value : 1.0f;
+      fingerprint[ i] = (unsigned char)( value * 127.0f + 0.5f);
+   }
+}
+
+static void getDefaultValues( float* values)
+{
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+      values[ i] = knobValueToParam( getLayoutItem( i)->defaultValue, i);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// root without trailing separators, the index path defaults to the root
+
+static bool copyRoot( char* dest, const char* root)
+{
+   size_t length = strlen( root);
+   if( length >= kAweMaxPath)
+      return false;
+
+   memcpy( dest, root, length + 1);
+   while( length > 1 && ( dest[ length - 1] == '/' || dest[ length - 1] == '\\'))
+      dest[ --length] = 0;
+   return true;
+}
+
+static bool makeIndexPath( char* dest, const char* root, const char* indexPath)
+{
+   if( indexPath)
+   {
+      if( strlen( indexPath) >= kAweMaxPath)
+         return false;
+      strcpy( dest, indexPath);
+      return true;
+   }
+
+   if( strlen( root) + 1 + strlen( PATCH_LIBRARY_INDEX) >= kAweMaxPath)
+      return false;
+
+   sprintf( dest, "%s/%s", root, PATCH_LIBRARY_INDEX);
+   return true;
+}
+
+// --------------------------------------------------------------------------
+// scan
+// --------------------------------------------------------------------------
+
+// growing array of plain structs, only used while the index is built
+
+template <typename T>
+class ScanArray
+{
+public:
+   ScanArray() : items( NULL), count( 0), capacity( 0) {}
+   ~ScanArray()                     { delete[] items; }
+
+   T& add()
+   {
+      if( count == capacity)
+         reserve( capacity ? 2 * capacity : 256);
+      return items[ count++];
+   }
+
+   void append( const T* source, VstInt32 n)
+   {
+      if( count + n > capacity)
+         reserve( 2 * ( count + n));
+      for( VstInt32 i = 0; i < n; i++)
+         items[ count++] = source[ i];
+   }
+
+   void reserve( VstInt32 size)
+   {
+      if( size <= capacity)
+         return;
+
+      T* grown = new T[ size];
+      for( VstInt32 i = 0; i < count; i++)
+         grown[ i] = items[ i];
+      delete[] items;
+
+      items = grown;
+      capacity = size;
+   }
+
+   T& operator[]( VstInt32 i)       { return items[ i]; }
+   T* getItems()                    { return items; }
+   VstInt32 getCount()              { return count; }
+
+private:
+   ScanArray( const ScanArray&);
+   ScanArray& operator=( const ScanArray&);
+
+   T* items;
+   VstInt32 count;
+   VstInt32 capacity;
+};
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+struct BuildFile
+{
+   VstInt32 path;
+   long long size;
+   long long modified;
+   VstInt32 firstPatch;
+   VstInt32 numPatches;
+};
+
+struct BuildPatch
+{
+   VstInt32 file;
+   VstInt32 program;
+   VstInt32 offset;
+   VstInt32 format;
+   VstInt32 count;
+   VstInt32 name;
+   VstInt32 tags;
+   unsigned char fingerprint[ kNumGuiParameters];
+};
+
+struct MeeblipVST_PatchScan
+{
+   MeeblipVST_PatchLibrary* library;
+   size_t rootLength;
+
+   ScanArray<BuildFile> files;
+   ScanArray<BuildPatch> patches;
+   ScanArray<char> strings;
+
+   // the files of the previous index by their path, file + 1
+   ScanArray<VstInt32> previous;
+   VstInt32 previousMask;
+
+   VstInt32 parsed;
+   VstInt32 reused;
+
+   VstInt32 addString( const char* string, size_t length)
+   {
+      VstInt32 offset = strings.getCount();
+      strings.append( string, (VstInt32)length);
+      strings.add() = 0;
+      return offset;
+   }
+};
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the file being parsed
+
+struct ScanFile
+{
+   MeeblipVST_PatchScan* scan;
+   const unsigned char* data;
+   size_t size;
+   VstInt32 file;
+   VstInt32 tags;
+   const char* stem;             // file name without extension
+   size_t stemLength;
+};
+
+static size_t nameLength( const char* name, size_t size)
+{
+   size_t length = 0;
+   while( length < size && name[ length])
+      length++;
+   while( length > 0 && name[ length - 1] == ' ')
+      length--;
+   return length;
+}
+
+// the name of the program or the fallback, else the file name with the
+// number of the program of a bank
+
+static void addPatch( ScanFile& file, VstInt32 program, bool bank, size_t offset, VstInt32 format, VstInt32 count,
+                      const char* name, size_t size, const char* fallback, size_t fallbackSize)
+{
+   MeeblipVST_PatchScan& scan = *file.scan;
+
+   BuildPatch& patch = scan.patches.add();
+   patch.file     = file.file;
+   patch.program  = program;
+   patch.offset   = (VstInt32)offset;
+   patch.format   = format;
+   patch.count    = count < kNumGuiParameters ? count : kNumGuiParameters;
+   patch.tags     = file.tags;
+
+   size_t length = nameLength( name, size);
+   if( length == 0 && fallback)
+   {
+      name = fallback;
+      length = nameLength( fallback, fallbackSize);
+   }
+
+   if( length > 0)
+      patch.name = scan.addString( name, length);
+   else
+   {
+      char stem[ kAweMaxPath + 16];
+      length = file.stemLength;
+      memcpy( stem, file.stem, length);
+      if( bank)
+         length += sprintf( stem + length, " %d", program + 1);
+      patch.name = scan.addString( stem, length);
+   }
+
+   float values[ kNumGuiParameters];
+   getDefaultValues( values);
+   readValues( file.data + offset, format, patch.count, values);
+   makeFingerprint( values, patch.fingerprint);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the programs of a MeeblipVST chunk, see MeeblipVST_Chunk.h
+
+static bool parseChunk( ScanFile& file, size_t chunk, size_t chunkSize, VstInt32 program, bool bank,
+                        const char* fxName, size_t fxNameSize)
+{
+   MeeblipVST_ChunkReader reader( file.data + chunk, (VstInt32)chunkSize);
+
+   VstInt32 magic = 0, version, headerSize, numPrograms, curProgram, numParameters, numExtra, programSize;
+   if( !reader.getInt32( magic) || magic != kChunkMagic
+    || !reader.getInt32( version) || !reader.getInt32( headerSize) || !reader.getInt32( numPrograms)
+    || !reader.getInt32( curProgram) || !reader.getInt32( numParameters) || !reader.getInt32( numExtra)
+    || !reader.getInt32( programSize))
+      return false;
+
+   if( headerSize < 4 * kChunkHeaderFields || numPrograms < 0 || numParameters < 0
+    || programSize < kVstMaxProgNameLen + 4 * numParameters
+    || (long long)headerSize + (long long)numPrograms * programSize > (long long)chunkSize)
+      return false;
+
+   for( VstInt32 p = 0; p < numPrograms; p++)
+   {
+      size_t record = chunk + headerSize + (size_t)p * programSize;
+
+      // a preset has one program, it takes the place of the fxProgram
+      addPatch( file, bank ? p : program, bank || numPrograms > 1, record + kVstMaxProgNameLen, kPatchChunk, numParameters,
+                (const char*)file.data + record, kVstMaxProgNameLen, fxName, fxNameSize);
+   }
+   return true;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// a fxProgram between offset and end, a single .fxp or one of a .fxb
+
+static bool parseProgram( ScanFile& file, size_t offset, size_t end, VstInt32 program, bool bank)
+{
+   const unsigned char* p = file.data + offset;
+   if( end - offset < kFxProgramHeader || memcmp( p, "CcnK", 4) != 0)
+      return false;
+
+   VstInt32 numParams = readBE32( p + 24);
+   const char* name = (const char*)p + 28;
+
+   if( memcmp( p + 8, "FxCk", 4) == 0)
+   {
+      if( numParams < 0 || ( end - offset - kFxProgramHeader) / 4 < (size_t)numParams)
+         return false;
+
+      addPatch( file, program, bank, offset + kFxProgramHeader, kPatchFxParams, numParams, name, kFxProgramNameLen, NULL, 0);
+      return true;
+   }
+
+   if( memcmp( p + 8, "FPCh", 4) == 0)
+   {
+      if( end - offset < kFxProgramHeader + 4)
+         return false;
+
+      VstInt32 chunkSize = readBE32( p + kFxProgramHeader);
+      if( chunkSize < 0 || end - offset - kFxProgramHeader - 4 < (size_t)chunkSize)
+         return false;
+
+      return parseChunk( file, offset + kFxProgramHeader + 4, chunkSize, program, bank, name, kFxProgramNameLen);
+   }
+
+   return false;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static bool parseBank( ScanFile& file)
+{
+   const unsigned char* p = file.data;
+   if( file.size < kFxBankHeader || memcmp( p, "CcnK", 4) != 0)
+      return false;
+
+   if( memcmp( p + 8, "FxBk", 4) == 0)
+   {
+      VstInt32 numPrograms = readBE32( p + 24);
+      size_t offset = kFxBankHeader;
+
+      for( VstInt32 i = 0; i < numPrograms; i++)
+      {
+         if( file.size - offset < kFxProgramHeader)
+            return i > 0;
+
+         // byteSize doesn't count chunkMagic and itself
+         VstInt32 byteSize = readBE32( p + offset + 4);
+         if( byteSize < kFxProgramHeader - 8 || file.size - offset - 8 < (size_t)byteSize)
+            return i > 0;
+
+         size_t end = offset + 8 + byteSize;
+         parseProgram( file, offset, end, i, true);
+         offset = end;
+      }
+      return true;
+   }
+
+   if( memcmp( p + 8, "FBCh", 4) == 0)
+   {
+      if( file.size < kFxBankHeader + 4)
+         return false;
+
+      VstInt32 chunkSize = readBE32( p + kFxBankHeader);
+      if( chunkSize < 0 || file.size - kFxBankHeader - 4 < (size_t)chunkSize)
+         return false;
+
+      return parseChunk( file, kFxBankHeader + 4, chunkSize, 0, true, NULL, 0);
+   }
+
+   return false;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// every dump in the file is a patch, other messages are skipped
+
+static bool parseSysex( ScanFile& file)
+{
+   bool found = false;
+   size_t pos = 0;
+
+   while( pos < file.size)
+   {
+      const unsigned char* start = (const unsigned char*)memchr( file.data + pos, kSysexStart, file.size - pos);
+      if( start == NULL)
+         break;
+
+      size_t offset = start - file.data;
+      const unsigned char* end = (const unsigned char*)memchr( start, kSysexEnd, file.size - offset);
+      if( end == NULL)
+         break;
+
+      MeeblipVST_SysexDump dump;
+      VstInt32 size = (VstInt32)( end - start + 1);
+      if( sysexDecodeDump( start, size, dump))
+      {
+         addPatch( file, dump.program, true, offset + kSysexHeaderSize, kPatchSysex, kNumGuiParameters,
+                   dump.name, kVstMaxProgNameLen, NULL, 0);
+         found = true;
+      }
+      pos = offset + size;
+   }
+   return found;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static void sortByName( VstInt32* items, VstInt32* temp, VstInt32 count, MeeblipVST_PatchScan& scan)
+{
+   // merge sort, stable: patches with the same name stay in file order
+   if( count < 2)
+      return;
+
+   VstInt32 half = count / 2;
+   sortByName( items, temp, half, scan);
+   sortByName( items + half, temp, count - half, scan);
+
+   const char* strings = scan.strings.getItems();
+   BuildPatch* patches = scan.patches.getItems();
+
+   VstInt32 a = 0, b = half, n = 0;
+   while( a < half && b < count)
+   {
+      if( compareNames( strings + patches[ items[ b]].name, strings + patches[ items[ a]].name) < 0)
+         temp[ n++] = items[ b++];
+      else
+         temp[ n++] = items[ a++];
+   }
+   while( a < half)
+      temp[ n++] = items[ a++];
+
+   // the rest of b is in place already
+   memcpy( items, temp, n * sizeof( VstInt32));
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static bool writeIndex( MeeblipVST_PatchScan& scan, const char* indexPath)
+{
+   VstInt32 numFiles = scan.files.getCount();
+   VstInt32 numPatches = scan.patches.getCount();
+   BuildPatch* patches = scan.patches.getItems();
+
+   // an empty pool would leave the strings without a terminator
+   scan.strings.add() = 0;
+   VstInt32 stringsSize = scan.strings.getCount();
+   const char* strings = scan.strings.getItems();
+
+   VstInt32 hashSize = 16;
+   while( hashSize < 2 * numPatches)
+      hashSize *= 2;
+
+   VstInt32* sorted = new VstInt32[ numPatches + 1];
+   VstInt32* temp = new VstInt32[ numPatches + 1];
+   VstInt32* hash = new VstInt32[ hashSize];
+   uint32* nameHash = new uint32[ numPatches + 1];
+
+   for( VstInt32 i = 0; i < numPatches; i++)
+      sorted[ i] = i;
+   sortByName( sorted, temp, numPatches, scan);
+
+   // linear probing, the first patch of a name is found first
+   memset( hash, 0, hashSize * sizeof( VstInt32));
+   for( VstInt32 i = 0; i < numPatches; i++)
+   {
+      nameHash[ i] = hashName( strings + patches[ i].name);
+
+      VstInt32 slot = nameHash[ i] & ( hashSize - 1);
+      while( hash[ slot])
+         slot = ( slot + 1) & ( hashSize - 1);
+      hash[ slot] = i + 1;
+   }
+
+   VstInt32 fingerprintsSize = ( numPatches * kNumGuiParameters + 3) & ~3;
+
+   VstInt32 filesOffset          = 4 * kNumIndexFields;
+   VstInt32 patchesOffset        = filesOffset + numFiles * kFileRecordSize;
+   VstInt32 fingerprintsOffset   = patchesOffset + numPatches * kPatchRecordSize;
+   VstInt32 sortedOffset         = fingerprintsOffset + fingerprintsSize;
+   VstInt32 hashOffset           = sortedOffset + 4 * numPatches;
+   VstInt32 stringsOffset        = hashOffset + 4 * hashSize;
+   VstInt32 indexSize            = stringsOffset + stringsSize;
+
+   unsigned char* data = new unsigned char[ indexSize];
+   MeeblipVST_ChunkWriter writer( data);
+
+   writer.putInt32( kIndexMagic);
+   writer.putInt32( kIndexVersion);
+   writer.putInt32( kNumGuiParameters);
+   writer.putInt32( numFiles);
+   writer.putInt32( numPatches);
+   writer.putInt32( hashSize);
+   writer.putInt32( filesOffset);
+   writer.putInt32( patchesOffset);
+   writer.putInt32( fingerprintsOffset);
+   writer.putInt32( sortedOffset);
+   writer.putInt32( hashOffset);
+   writer.putInt32( stringsOffset);
+   writer.putInt32( stringsSize);
+
+   for( VstInt32 i = 0; i < numFiles; i++)
+   {
+      const BuildFile& file = scan.files[ i];
+      writer.putInt32( file.path);
+      writer.putInt32( (VstInt32)( file.size & 0xffffffff));
+      writer.putInt32( (VstInt32)( file.size >> 32));
+      writer.putInt32( (VstInt32)( file.modified & 0xffffffff));
+      writer.putInt32( (VstInt32)( file.modified >> 32));
+      writer.putInt32( file.firstPatch);
+      writer.putInt32( file.numPatches);
+   }
+
+   for( VstInt32 i = 0; i < numPatches; i++)
+   {
+      const BuildPatch& patch = patches[ i];
+      writer.putInt32( patch.file);
+      writer.putInt32( patch.program);
+      writer.putInt32( patch.offset);
+      writer.putInt32( patch.format);
+      writer.putInt32( patch.count);
+      writer.putInt32( patch.name);
+      writer.putInt32( patch.tags);
+      writer.putInt32( (VstInt32)nameHash[ i]);
+   }
+
+   for( VstInt32 i = 0; i < numPatches; i++)
+      writer.putBytes( patches[ i].fingerprint, kNumGuiParameters);
+   static const unsigned char padding[ 4] = { 0, 0, 0, 0 };
+   writer.putBytes( padding, fingerprintsSize - numPatches * kNumGuiParameters);
+
+   for( VstInt32 i = 0; i < numPatches; i++)
+      writer.putInt32( sorted[ i]);
+   for( VstInt32 i = 0; i < hashSize; i++)
+      writer.putInt32( hash[ i]);
+   writer.putBytes( strings, stringsSize);
+
+   delete[] sorted;
+   delete[] temp;
+   delete[] hash;
+   delete[] nameHash;
+
+   // written next to the index and renamed, a reader that has the old one
+   // mapped keeps it
+   char tempPath[ kAweMaxPath + 4];
+   sprintf( tempPath, "%s.tmp", indexPath);
+
+   bool done = false;
+   FILE* file = fopen( tempPath, "wb");
+   if( file)
+   {
+      done = fwrite( data, 1, indexSize, file) == (size_t)indexSize;
+      done = fclose( file) == 0 && done;
+
+      if( done)
+      {
+         remove( indexPath);
+         done = rename( tempPath, indexPath) == 0;
+      }
+      else
+         remove( tempPath);
+   }
+   delete[] data;
+
+   DBG( 1, "\nwriteIndex %s: %d files, %d patches, %d bytes%s", indexPath, numFiles, numPatches, indexSize, done ? "" : " failed");
+   return done;
+}
+
+// --------------------------------------------------------------------------
+//  MeeblipVST_PatchLibrary Implementation
+// --------------------------------------------------------------------------
+
+MeeblipVST_PatchLibrary::MeeblipVST_PatchLibrary()
+{
+   root[0] = 0;
+   close();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+MeeblipVST_PatchLibrary::~MeeblipVST_PatchLibrary()
+{
+   close();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_PatchLibrary::close()
+{
+   index.close();
+
+   numFiles       = 0;
+   numPatches     = 0;
+   hashSize       = 0;
+   files          = NULL;
+   patches        = NULL;
+   fingerprints   = NULL;
+   sorted         = NULL;
+   hash           = NULL;
+   strings        = NULL;
+   stringsSize    = 0;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+bool MeeblipVST_PatchLibrary::open( const char* root, const char* indexPath)
+{
+   close();
+
+   char path[ kAweMaxPath];
+   if( !copyRoot( this->root, root) || !makeIndexPath( path, this->root, indexPath))
+      return false;
+
+   return mapIndex( path);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// checks that the sections are inside of the file, the records are checked
+// when they are used
+
+bool MeeblipVST_PatchLibrary::mapIndex( const char* indexPath)
+{
+   if( !index.open( indexPath))
+      return false;
+
+   const unsigned char* data = index.getData();
+   long long size = (long long)index.getSize();
+
+   VstInt32 header[ kNumIndexFields];
+   if( size < 4 * kNumIndexFields)
+   {
+      close();
+      return false;
+   }
+   for( VstInt32 i = 0; i < kNumIndexFields; i++)
+      header[ i] = readLE32( data + 4 * i);
+
+   VstInt32 fileCount = header[ kIndexNumFiles];
+   VstInt32 patchCount = header[ kIndexNumPatches];
+   VstInt32 slotCount = header[ kIndexHashSize];
+   VstInt32 stringsBytes = header[ kIndexStringsSize];
+
+   bool valid = header[ kIndexMagicField] == kIndexMagic
+             && header[ kIndexVersionField] == kIndexVersion
+             && header[ kIndexNumParameters] == kNumGuiParameters
+             && fileCount >= 0 && patchCount >= 0 && stringsBytes > 0
+             && slotCount >= 2 * patchCount && slotCount > 0 && ( slotCount & ( slotCount - 1)) == 0;
+
+   struct Section { VstInt32 offset; long long size; } sections[] =
+   {
+      { header[ kIndexFiles],          (long long)fileCount * kFileRecordSize },
+      { header[ kIndexPatches],        (long long)patchCount * kPatchRecordSize },
+      { header[ kIndexFingerprints],   (long long)patchCount * kNumGuiParameters },
+      { header[ kIndexSorted],         (long long)patchCount * 4 },
+      { header[ kIndexHash],           (long long)slotCount * 4 },
+      { header[ kIndexStrings],        (long long)stringsBytes },
+   };
+
+   for( size_t i = 0; valid && i < sizeof( sections) / sizeof( sections[0]); i++)
+      valid = sections[ i].offset >= 0 && sections[ i].size >= 0 && sections[ i].offset + sections[ i].size <= size;
+
+   // a string can't run off the end
+   valid = valid && data[ header[ kIndexStrings] + stringsBytes - 1] == 0;
+
+   if( !valid)
+   {
+      DBG( 1, "\nMeeblipVST_PatchLibrary::mapIndex %s is not a valid index", indexPath);
+      close();
+      return false;
+   }
+
+   this->numFiles       = fileCount;
+   this->numPatches     = patchCount;
+   this->hashSize       = slotCount;
+   this->files          = data + header[ kIndexFiles];
+   this->patches        = data + header[ kIndexPatches];
+   this->fingerprints   = data + header[ kIndexFingerprints];
+   this->sorted         = data + header[ kIndexSorted];
+   this->hash           = data + header[ kIndexHash];
+   this->strings        = (const char*)data + header[ kIndexStrings];
+   this->stringsSize    = stringsBytes;
+
+   DBG( 1, "\nMeeblipVST_PatchLibrary::mapIndex %s: %d files, %d patches", indexPath, fileCount, patchCount);
+   return true;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+bool MeeblipVST_PatchLibrary::update( const char* root, const char* indexPath)
+{
+   char path[ kAweMaxPath];
+   char rootPath[ kAweMaxPath];
+   if( !copyRoot( rootPath, root) || !makeIndexPath( path, rootPath, indexPath))
+      return false;
+
+   // the previous index, if there is one, by the paths of its files
+   open( rootPath, indexPath);
+
+   MeeblipVST_PatchScan scan;
+   scan.library      = this;
+   scan.rootLength   = strlen( rootPath);
+   scan.parsed       = 0;
+   scan.reused       = 0;
+
+   VstInt32 previousSize = 16;
+   while( previousSize < 2 * numFiles)
+      previousSize *= 2;
+   scan.previous.reserve( previousSize);
+   for( VstInt32 i = 0; i < previousSize; i++)
+      scan.previous.add() = 0;
+   scan.previousMask = previousSize - 1;
+
+   for( VstInt32 i = 0; i < numFiles; i++)
+   {
+      VstInt32 slot = hashName( getString( getField( files + i * kFileRecordSize, kFilePath))) & scan.previousMask;
+      while( scan.previous[ slot])
+         slot = ( slot + 1) & scan.previousMask;
+      scan.previous[ slot] = i + 1;
+   }
+
+   bool listed = aweListFiles( rootPath, scanFileProc, &scan);
+
+   // the strings of the reused patches are copied, the index can go
+   close();
+
+   if( !listed || !writeIndex( scan, path))
+      return false;
+
+   DBG( 1, "\nMeeblipVST_PatchLibrary::update %s: %d files parsed, %d reused", rootPath, scan.parsed, scan.reused);
+   return open( rootPath, indexPath);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_PatchLibrary::scanFileProc( void* context, const char* path)
+{
+   MeeblipVST_PatchScan* scan = (MeeblipVST_PatchScan*)context;
+   scan->library->scanFile( *scan, path);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_PatchLibrary::scanFile( MeeblipVST_PatchScan& scan, const char* path)
+{
+   bool sysex = hasExtension( path, ".syx");
+   bool bank = sysex || hasExtension( path, ".fxb");
+   if( !bank && !hasExtension( path, ".fxp"))
+      return;
+
+   long long size, modified;
+   if( !aweGetFileInfo( path, size, modified))
+      return;
+
+   const char* relative = path + scan.rootLength + 1;
+
+   // unchanged since the previous index: its patches are copied
+   VstInt32 slot = hashName( relative) & scan.previousMask;
+   for( ; scan.previous[ slot]; slot = ( slot + 1) & scan.previousMask)
+   {
+      const unsigned char* record = files + ( scan.previous[ slot] - 1) * kFileRecordSize;
+      if( strcmp( getString( getField( record, kFilePath)), relative) != 0)
+         continue;
+
+      long long oldSize = ( (long long)getField( record, kFileSizeHigh) << 32) | (uint32)getField( record, kFileSizeLow);
+      long long oldModified = ( (long long)getField( record, kFileTimeHigh) << 32) | (uint32)getField( record, kFileTimeLow);
+      VstInt32 first = getField( record, kFileFirstPatch);
+      VstInt32 count = getField( record, kFileNumPatches);
+
+      if( oldSize != size || oldModified != modified || first < 0 || count < 0 || first > numPatches - count)
+         break;
+
+      VstInt32 fileIndex = scan.files.getCount();
+      BuildFile& file = scan.files.add();
+      file.path         = scan.addString( relative, strlen( relative));
+      file.size         = size;
+      file.modified     = modified;
+      file.firstPatch   = scan.patches.getCount();
+      file.numPatches   = count;
+
+      VstInt32 tags = count > 0 ? scan.addString( getTags( first), strlen( getTags( first))) : 0;
+
+      for( VstInt32 p = first; p < first + count; p++)
+      {
+         const unsigned char* old = getPatchRecord( p);
+         BuildPatch& patch = scan.patches.add();
+
+         patch.file     = fileIndex;
+         patch.program  = getField( old, kPatchProgram);
+         patch.offset   = getField( old, kPatchOffset);
+         patch.format   = getField( old, kPatchFormat);
+         patch.count    = getField( old, kPatchCount);
+         patch.name     = scan.addString( getName( p), strlen( getName( p)));
+         patch.tags     = tags;
+         memcpy( patch.fingerprint, getFingerprint( p), kNumGuiParameters);
+      }
+
+      scan.reused++;
+      return;
+   }
+
+   aweMappedFile mapped;
+   if( !mapped.open( path))
+      return;
+
+   ScanFile file;
+   file.scan         = &scan;
+   file.data         = mapped.getData();
+   file.size         = mapped.getSize();
+   file.file         = scan.files.getCount();
+
+   // tags: the directories, for a bank also the name of the file
+   const char* name = strrchr( relative, '/');
+   name = name ? name + 1 : relative;
+   file.stem         = name;
+   file.stemLength   = strlen( name) - 4;
+
+   char tags[ kAweMaxPath];
+   size_t length = name > relative ? name - relative - 1 : 0;
+   memcpy( tags, relative, length);
+   if( bank)
+   {
+      if( length > 0)
+         tags[ length++] = '/';
+      memcpy( tags + length, file.stem, file.stemLength);
+      length += file.stemLength;
+   }
+   file.tags         = scan.addString( tags, length);
+
+   BuildFile& record = scan.files.add();
+   record.path          = scan.addString( relative, strlen( relative));
+   record.size          = size;
+   record.modified      = modified;
+   record.firstPatch    = scan.patches.getCount();
+
+   // the file stays in the index without patches, it isn't read again
+   // until it changes
+   if( file.data)
+   {
+      if( sysex)
+         parseSysex( file);
+      else if( bank)
+         parseBank( file);
+      else
+         parseProgram( file, 0, file.size, 0, false);
+   }
+
+   scan.files[ file.file].numPatches = scan.patches.getCount() - scan.files[ file.file].firstPatch;
+   scan.parsed++;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+VstInt32 MeeblipVST_PatchLibrary::getField( const unsigned char* record, VstInt32 field)
+{
+   return readLE32( record + 4 * field);
+}
+
+const unsigned char* MeeblipVST_PatchLibrary::getPatchRecord( VstInt32 patch)
+{
+   return patches + patch * kPatchRecordSize;
+}
+
+const char* MeeblipVST_PatchLibrary::getString( VstInt32 offset)
+{
+   return offset >= 0 && offset < stringsSize ? strings + offset : "";
+}
+
+VstInt32 MeeblipVST_PatchLibrary::hashSlot( VstInt32 slot)
+{
+   return readLE32( hash + 4 * slot);
+}
+
+VstInt32 MeeblipVST_PatchLibrary::sortedPatch( VstInt32 i)
+{
+   return readLE32( sorted + 4 * i);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+const char* MeeblipVST_PatchLibrary::getName( VstInt32 patch)
+{
+   if( patch < 0 || patch >= numPatches)
+      return "";
+   return getString( getField( getPatchRecord( patch), kPatchName));
+}
+
+const char* MeeblipVST_PatchLibrary::getTags( VstInt32 patch)
+{
+   if( patch < 0 || patch >= numPatches)
+      return "";
+   return getString( getField( getPatchRecord( patch), kPatchTags));
+}
+
+const char* MeeblipVST_PatchLibrary::getPath( VstInt32 patch)
+{
+   if( patch < 0 || patch >= numPatches)
+      return "";
+
+   VstInt32 file = getField( getPatchRecord( patch), kPatchFile);
+   if( file < 0 || file >= numFiles)
+      return "";
+   return getString( getField( files + file * kFileRecordSize, kFilePath));
+}
+
+VstInt32 MeeblipVST_PatchLibrary::getProgram( VstInt32 patch)
+{
+   if( patch < 0 || patch >= numPatches)
+      return 0;
+   return getField( getPatchRecord( patch), kPatchProgram);
+}
+
+const unsigned char* MeeblipVST_PatchLibrary::getFingerprint( VstInt32 patch)
+{
+   if( patch < 0 || patch >= numPatches)
+      return NULL;
+   return fingerprints + patch * kNumGuiParameters;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+bool MeeblipVST_PatchLibrary::hasTag( VstInt32 patch, const char* tag)
+{
+   size_t length = strlen( tag);
+
+   for( const char* tags = getTags( patch); *tags; )
+   {
+      const char* end = strchr( tags, '/');
+      size_t tagLength = end ? end - tags : strlen( tags);
+
+      if( tagLength == length && startsWith( tags, tag))
+         return true;
+
+      tags += end ? tagLength + 1 : tagLength;
+   }
+   return false;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+VstInt32 MeeblipVST_PatchLibrary::find( const char* name)
+{
+   if( numPatches == 0)
+      return -1;
+
+   uint32 nameHash = hashName( name);
+   VstInt32 mask = hashSize - 1;
+
+   for( VstInt32 slot = nameHash & mask, n = 0; n < hashSize; slot = ( slot + 1) & mask, n++)
+   {
+      VstInt32 patch = hashSlot( slot) - 1;
+      if( patch < 0 || patch >= numPatches)
+         return -1;
+
+      const unsigned char* record = getPatchRecord( patch);
+      if( (uint32)getField( record, kPatchNameHash) == nameHash
+       && compareNames( getString( getField( record, kPatchName)), name) == 0)
+         return patch;
+   }
+   return -1;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+VstInt32 MeeblipVST_PatchLibrary::findPrefix( const char* prefix, VstInt32* results, VstInt32 maxResults)
+{
+   // the first name that isn't less than the prefix
+   VstInt32 low = 0;
+   VstInt32 high = numPatches;
+   while( low < high)
+   {
+      VstInt32 middle = low + ( high - low) / 2;
+      if( compareNames( getName( sortedPatch( middle)), prefix) < 0)
+         low = middle + 1;
+      else
+         high = middle;
+   }
+
+   VstInt32 found = 0;
+   for( VstInt32 i = low; i < numPatches && found < maxResults; i++)
+   {
+      VstInt32 patch = sortedPatch( i);
+      if( !startsWith( getName( patch), prefix))
+         break;
+      results[ found++] = patch;
+   }
+   return found;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+VstInt32 MeeblipVST_PatchLibrary::findSimilar( VstInt32 patch, MeeblipVST_PatchMatch* results, VstInt32 maxResults)
+{
+   const unsigned char* fingerprint = getFingerprint( patch);
+   if( fingerprint == NULL)
+      return 0;
+
+   float values[ kNumGuiParameters];
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+      values[ i] = fingerprint[ i] * ( 1.0f / 127.0f);
+
+   return findSimilar( values, results, maxResults, patch);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// one pass over the fingerprints, the best maxResults are kept sorted by
+// insertion. A match with the same distance stays behind the earlier patch
+
+VstInt32 MeeblipVST_PatchLibrary::findSimilar( const float* values, MeeblipVST_PatchMatch* results, VstInt32 maxResults, VstInt32 exclude)
+{
+   if( maxResults <= 0)
+      return 0;
+
+   unsigned char target[ kNumGuiParameters];
+   makeFingerprint( values, target);
+
+   VstInt32 found = 0;
+   const unsigned char* fingerprint = fingerprints;
+
+   for( VstInt32 patch = 0; patch < numPatches; patch++, fingerprint += kNumGuiParameters)
+   {
+      VstInt32 distance = 0;
+      for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+      {
+         VstInt32 delta = (VstInt32)fingerprint[ i] - (VstInt32)target[ i];
+         distance += delta * delta;
+      }
+
+      if( patch == exclude || ( found == maxResults && distance >= results[ found - 1].distance))
+         continue;
+
+      VstInt32 i = found < maxResults ? found++ : found - 1;
+      for( ; i > 0 && results[ i - 1].distance > distance; i--)
+         results[ i] = results[ i - 1];
+
+      results[ i].patch = patch;
+      results[ i].distance = distance;
+   }
+   return found;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+bool MeeblipVST_PatchLibrary::loadPatch( VstInt32 patch, float* values)
+{
+   if( patch < 0 || patch >= numPatches)
+      return false;
+
+   const unsigned char* record = getPatchRecord( patch);
+   VstInt32 offset = getField( record, kPatchOffset);
+   VstInt32 format = getField( record, kPatchFormat);
+   VstInt32 count = getField( record, kPatchCount);
+
+   const char* relative = getPath( patch);
+   if( *relative == 0)
+      return false;
+
+   char path[ kAweMaxPath];
+   int length = snprintf( path, sizeof( path), "%s/%s", root, relative);
+   if( length < 0 || length >= (int)sizeof( path))
+      return false;
+
+   aweMappedFile file;
+   if( !file.open( path))
+   {
+      DBG( 1, "\nMeeblipVST_PatchLibrary::loadPatch can't open %s", path);
+      return false;
+   }
+
+   // the file may have changed since the index was written
+   if( format < 0 || format >= kNumPatchFormats || count < 0 || count > kNumGuiParameters
+    || offset < 0 || (size_t)offset + valueSize( format) * (size_t)count > file.getSize())
+      return false;
+
+   readValues( file.getData() + offset, format, count, values);
+   return true;
+}
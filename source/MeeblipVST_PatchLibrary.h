@@ -0,0 +1,141 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_PatchLibrary.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   .syx files with the sysex dumps of the hardware
+//    17.10.2026  AWe   patch library, memory mapped index over the .fxp and
+//                      .fxb files of a directory tree
+//
+// --------------------------------------------------------------------------
+
+#ifndef __MeeblipVST_PatchLibrary__
+#define __MeeblipVST_PatchLibrary__
+
+#include "MeeblipVST_Layout.h"
+#include "aweFile.h"
+#include "aweVSTtypes.h"
+#include "pluginterfaces/vst2.x/aeffect.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// where the parameters of a patch are in its file
+enum PatchFormat
+{
+   kPatchFxParams = 0,     // float parameters of a fxProgram, big endian
+   kPatchChunk,            // program of a MeeblipVST chunk, little endian
+   kPatchSysex,            // midi values of a sysex dump
+
+   kNumPatchFormats
+};
+
+#define PATCH_LIBRARY_INDEX   "MeeblipLibrary.idx"
+
+struct MeeblipVST_PatchScan;
+
+struct MeeblipVST_PatchMatch
+{
+   VstInt32 patch;
+   VstInt32 distance;      // sum of the squared differences of the midi values
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_PatchLibrary
+// --------------------------------------------------------------------------
+
+// The patches of all .fxp, .fxb and .syx files below a root directory. update()
+// scans the tree and writes the index file, open() only maps the index:
+// a library of any size is ready at once and the patch files are read only
+// when a patch is loaded.
+//
+// Per patch the index holds its file, its place in the file, its name, its
+// tags and its fingerprint, the midi values of the kNumGuiParameters layout
+// parameters. The tags are the directories between the root and the file,
+// for a bank or a .syx file also the name of the file, separated by '/'.
+//
+// Patches that share a name are all indexed, find() returns the first one.
+// The fxID of the files isn't checked, the shipped patches use 'GUI0'.
+//
+// find() looks the name up in a hash table, findPrefix() searches the name
+// table sorted by name, both ignore the case. findSimilar() compares the
+// fingerprints of all patches, they are stored one after another.
+//
+// Not for the audio thread, update() and loadPatch() do file I/O.
+
+class MeeblipVST_PatchLibrary
+{
+public:
+   MeeblipVST_PatchLibrary();
+   ~MeeblipVST_PatchLibrary();
+
+   // scans root and writes the index, indexPath NULL: root/PATCH_LIBRARY_INDEX.
+   // Files with the size and time of the previous index are not read again
+   bool update( const char* root, const char* indexPath = NULL);
+
+   // maps the index written by update()
+   bool open( const char* root, const char* indexPath = NULL);
+   void close();
+
+   VstInt32 getNumPatches()               { return numPatches; }
+   VstInt32 getNumFiles()                 { return numFiles; }
+
+   const char* getName( VstInt32 patch);
+   const char* getTags( VstInt32 patch);
+   const char* getPath( VstInt32 patch);          // relative to the root
+   VstInt32 getProgram( VstInt32 patch);          // program in a bank, else 0
+   const unsigned char* getFingerprint( VstInt32 patch);
+
+   // tag is one of the tags of the patch, case is ignored
+   bool hasTag( VstInt32 patch, const char* tag);
+
+   // the patch with this name, -1 if there is none. Constant time
+   VstInt32 find( const char* name);
+
+   // the patches whose name starts with prefix in the order of their names,
+   // up to maxResults. Returns their number
+   VstInt32 findPrefix( const char* prefix, VstInt32* results, VstInt32 maxResults);
+
+   // the maxResults patches nearest to a patch or to parameter values,
+   // nearest first. exclude is left out, e.g. the patch itself
+   VstInt32 findSimilar( VstInt32 patch, MeeblipVST_PatchMatch* results, VstInt32 maxResults);
+   VstInt32 findSimilar( const float* values, MeeblipVST_PatchMatch* results, VstInt32 maxResults, VstInt32 exclude = -1);
+
+   // the kNumGuiParameters values of the patch from its file, a parameter
+   // the file doesn't have keeps its value
+   bool loadPatch( VstInt32 patch, float* values);
+
+protected:
+   bool mapIndex( const char* indexPath);
+   void scanFile( MeeblipVST_PatchScan& scan, const char* path);
+   static void scanFileProc( void* context, const char* path);
+
+   VstInt32 getField( const unsigned char* record, VstInt32 field);
+   const unsigned char* getPatchRecord( VstInt32 patch);
+   const char* getString( VstInt32 offset);
+   VstInt32 hashSlot( VstInt32 slot);
+   VstInt32 sortedPatch( VstInt32 i);
+
+   char root[ kAweMaxPath];
+   aweMappedFile index;
+
+   VstInt32 numFiles;
+   VstInt32 numPatches;
+   VstInt32 hashSize;
+   const unsigned char* files;
+   const unsigned char* patches;
+   const unsigned char* fingerprints;
+   const unsigned char* sorted;
+   const unsigned char* hash;
+   const char* strings;
+   VstInt32 stringsSize;
+};
+
+#endif // __MeeblipVST_PatchLibrary__
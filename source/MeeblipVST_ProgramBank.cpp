@@ -0,0 +1,260 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_ProgramBank.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   remove setAll(), no user
+//    17.10.2026  AWe   the program bank as one table of 7 bit values, one
+//                      row per parameter, and a pool of names
+//
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST_ProgramBank.h"
+
+#include <string.h>
+
+// --------------------------------------------------------------------------
+// Debug support
+// --------------------------------------------------------------------------
+
+#define VERBOSITY       99
+#define VERBOSITY_MIN   1
+
+#include "aweDBG.h"
+
+// --------------------------------------------------------------------------
+//  MeeblipVST_ProgramBank Implementation
+// --------------------------------------------------------------------------
+
+MeeblipVST_ProgramBank::MeeblipVST_ProgramBank()
+{
+   for( VstInt32 p = 0; p < kNumPrograms; p++)
+      initProgram( p);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_ProgramBank::initProgram( VstInt32 program)
+{
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+      values[ i][ program] = toValue( knobValueToParam( getLayoutItem( i)->defaultValue, i));
+
+   midiInChannel[ program]  = 0;
+   midiOutChannel[ program] = 0;
+
+   setName( program, "-init-");
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the same rounding as FLOAT_TO_MIDI, out of range values are clamped
+
+unsigned char MeeblipVST_ProgramBank::toValue( float value)
+{
+   value = value > 0.0f ? value : 0.0f;
+   value = value < 1.0f ? value : 1.0f;
+   return (unsigned char)( value * 127.0f + 0.5f);
+}
+
+unsigned char MeeblipVST_ProgramBank::toChannel( float value)
+{
+   value = value > 0.0f ? value : 0.0f;
+   value = value < 1.0f ? value : 1.0f;
+   return (unsigned char)( value * 15.0f + 0.5f);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+float MeeblipVST_ProgramBank::getParameter( VstInt32 program, VstInt32 index) const
+{
+   return values[ index][ program] * ( 1.0f / 127);
+}
+
+void MeeblipVST_ProgramBank::setParameter( VstInt32 program, VstInt32 index, float value)
+{
+   values[ index][ program] = toValue( value);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_ProgramBank::getParameters( VstInt32 program, float* parameters) const
+{
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+      parameters[ i] = values[ i][ program] * ( 1.0f / 127);
+}
+
+void MeeblipVST_ProgramBank::setParameters( VstInt32 program, const float* parameters)
+{
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+      values[ i][ program] = toValue( parameters[ i]);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+float MeeblipVST_ProgramBank::getMidiInChannel( VstInt32 program) const
+{
+   return midiInChannel[ program] * ( 1.0f / 15);
+}
+
+float MeeblipVST_ProgramBank::getMidiOutChannel( VstInt32 program) const
+{
+   return midiOutChannel[ program] * ( 1.0f / 15);
+}
+
+void MeeblipVST_ProgramBank::setMidiInChannel( VstInt32 program, float value)
+{
+   midiInChannel[ program] = toChannel( value);
+}
+
+void MeeblipVST_ProgramBank::setMidiOutChannel( VstInt32 program, float value)
+{
+   midiOutChannel[ program] = toChannel( value);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// zero padded, compare() and the chunk see the same bytes for the same name
+
+void MeeblipVST_ProgramBank::setName( VstInt32 program, const char* name)
+{
+   char* dest = names[ program];
+   VstInt32 i = 0;
+
+   for( ; i < kVstMaxProgNameLen && name[ i]; i++)
+      dest[ i] = name[ i];
+   for( ; i <= kVstMaxProgNameLen; i++)
+      dest[ i] = 0;
+}
+
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the differences of all rows are or'ed per program, the loops have no
+// branches and run over whole rows
+
+VstInt32 MeeblipVST_ProgramBank::compare( const MeeblipVST_ProgramBank& other, unsigned char* changed) const
+{
+   unsigned char diff[ kNumPrograms];
+
+   for( VstInt32 p = 0; p < kNumPrograms; p++)
+      diff[ p] = ( midiInChannel[ p] ^ other.midiInChannel[ p]) | ( midiOutChannel[ p] ^ other.midiOutChannel[ p]);
+
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+   {
+      const unsigned char* a = values[ i];
+      const unsigned char* b = other.values[ i];
+
+      for( VstInt32 p = 0; p < kNumPrograms; p++)
+         diff[ p] |= a[ p] ^ b[ p];
+   }
+
+   VstInt32 count = 0;
+   for( VstInt32 p = 0; p < kNumPrograms; p++)
+   {
+      bool differs = diff[ p] != 0 || memcmp( names[ p], other.names[ p], sizeof( names[ p])) != 0;
+      if( changed)
+         changed[ p] = differs ? 1 : 0;
+      count += differs ? 1 : 0;
+   }
+
+   DBG( 2, "MeeblipVST_ProgramBank::compare %d programs differ", count );
+   return count;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the weight of to in 1/256, from and to may be this bank
+
+void MeeblipVST_ProgramBank::morph( const MeeblipVST_ProgramBank& from, const MeeblipVST_ProgramBank& to, float amount)
+{
+   amount = amount > 0.0f ? amount : 0.0f;
+   amount = amount < 1.0f ? amount : 1.0f;
+
+   unsigned int weight = (unsigned int)( amount * 256.0f + 0.5f);
+   unsigned int rest = 256 - weight;
+
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+   {
+      const unsigned char* a = from.values[ i];
+      const unsigned char* b = to.values[ i];
+      unsigned char* dest = values[ i];
+
+      for( VstInt32 p = 0; p < kNumPrograms; p++)
+         dest[ p] = (unsigned char)( ( a[ p] * rest + b[ p] * weight + 128) >> 8);
+   }
+
+   const MeeblipVST_ProgramBank& nearer = weight < 128 ? from : to;
+   if( &nearer != this)
+   {
+      memcpy( midiInChannel, nearer.midiInChannel, sizeof( midiInChannel));
+      memcpy( midiOutChannel, nearer.midiOutChannel, sizeof( midiOutChannel));
+      memcpy( names, nearer.names, sizeof( names));
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// The random number of a value is a hash of the seed and its position in
+// the table, there is no state carried from one value to the next
+
+static inline unsigned int bankHash( unsigned int x)
+{
+   x ^= x >> 16;
+   x *= 0x7feb352dU;
+   x ^= x >> 15;
+   x *= 0x846ca68bU;
+   x ^= x >> 16;
+   return x;
+}
+
+void MeeblipVST_ProgramBank::randomize( VstInt32 first, VstInt32 last, float amount, unsigned int seed)
+{
+   amount = amount > 0.0f ? amount : 0.0f;
+   amount = amount < 1.0f ? amount : 1.0f;
+
+   first = first > 0 ? first : 0;
+   last = last < kNumGuiParameters - 1 ? last : kNumGuiParameters - 1;
+
+   // offset = ( random 0..127 - 64) * amount, in 1/256
+   int scale = (int)( amount * 256.0f + 0.5f);
+   int bias = 64 * scale;
+
+   for( VstInt32 i = first; i <= last; i++)
+   {
+      unsigned char* row = values[ i];
+      unsigned int base = seed * 0x9e3779b9U + (unsigned int)( i * kNumPrograms);
+
+      for( VstInt32 p = 0; p < kNumPrograms; p++)
+      {
+         int random = (int)( bankHash( base + p) & 0x7f);
+         int value = row[ p] + ( ( random * scale + 128 + 256 * 64 - bias) >> 8) - 64;
+
+         value = value > 0 ? value : 0;
+         row[ p] = (unsigned char)( value < 127 ? value : 127);
+      }
+   }
+}
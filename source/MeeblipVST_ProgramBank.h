@@ -0,0 +1,104 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_ProgramBank.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   remove setAll(), no user
+//    17.10.2026  AWe   the program bank as one table of 7 bit values, one
+//                      row per parameter, and a pool of names
+//
+// --------------------------------------------------------------------------
+
+#ifndef __MeeblipVST_ProgramBank__
+#define __MeeblipVST_ProgramBank__
+
+#include "MeeblipVST_Layout.h"
+#include "aweVSTtypes.h"
+#include "pluginterfaces/vst2.x/aeffect.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+enum
+{
+   kNumPrograms = 128
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_ProgramBank
+// --------------------------------------------------------------------------
+
+// The parameters of the hardware are 7 bit, the bank keeps them as their
+// midi values 0..127, the same the CCs and the sysex dumps carry. A knob
+// has 127 steps and a switch 1, so the value of the knob survives the
+// round trip parameter -> midi value -> parameter.
+//
+// The table is parameter major: the row of a parameter holds its value in
+// all programs, one byte each. The compare of two banks, morph and
+// randomize run along the rows, the whole table is kNumGuiParameters *
+// kNumPrograms bytes. The names are a separate pool, the midi channels
+// ( 0..15) two more rows.
+
+class MeeblipVST_ProgramBank
+{
+public:
+   MeeblipVST_ProgramBank();
+
+   // the default values of the layout, name "-init-"
+   void initProgram( VstInt32 program);
+
+   // single values, parameters in the range 0..1
+   unsigned char getValue( VstInt32 program, VstInt32 index) const   { return values[ index][ program]; }
+   void setValue( VstInt32 program, VstInt32 index, unsigned char value) { values[ index][ program] = value & 0x7f; }
+
+   float getParameter( VstInt32 program, VstInt32 index) const;
+   void setParameter( VstInt32 program, VstInt32 index, float value);
+
+   // all kNumGuiParameters of a program
+   void getParameters( VstInt32 program, float* parameters) const;
+   void setParameters( VstInt32 program, const float* parameters);
+
+   float getMidiInChannel( VstInt32 program) const;
+   float getMidiOutChannel( VstInt32 program) const;
+   void setMidiInChannel( VstInt32 program, float value);
+   void setMidiOutChannel( VstInt32 program, float value);
+
+   const char* getName( VstInt32 program) const          { return names[ program]; }
+   void setName( VstInt32 program, const char* name);
+
+   // the whole bank, see MeeblipVST::compareBank(), morphBank() and
+   // randomizeBank()
+
+   const unsigned char* getRow( VstInt32 index) const    { return values[ index]; }
+
+   // the number of programs which differ from other. changed[ kNumPrograms]
+   // gets 1 for them if it isn't NULL
+   VstInt32 compare( const MeeblipVST_ProgramBank& other, unsigned char* changed = NULL) const;
+
+   // values between from( amount 0) and to( amount 1), the names and
+   // channels of the nearer one
+   void morph( const MeeblipVST_ProgramBank& from, const MeeblipVST_ProgramBank& to, float amount);
+
+   // adds a random offset of up to +-amount * 64 to the parameters first
+   // up to last of all programs. The same seed gives the same bank
+   void randomize( VstInt32 first, VstInt32 last, float amount, unsigned int seed);
+
+protected:
+   static unsigned char toValue( float value);
+   static unsigned char toChannel( float value);
+
+   unsigned char values[ kNumGuiParameters][ kNumPrograms];
+   unsigned char midiInChannel[ kNumPrograms];
+   unsigned char midiOutChannel[ kNumPrograms];
+
+   char names[ kNumPrograms][ kVstMaxProgNameLen + 1];
+};
+
+#endif // __MeeblipVST_ProgramBank__
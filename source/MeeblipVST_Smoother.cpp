@@ -0,0 +1,156 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Smoother.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   control rate smoothing of the engine parameters, ramp
+//                      time and curve are declared in the layout table
+//
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST_Smoother.h"
+
+#include <math.h>
+#include <stddef.h>
+
+// --------------------------------------------------------------------------
+// Debug support
+// --------------------------------------------------------------------------
+
+#define VERBOSITY       99
+#define VERBOSITY_MIN   1
+
+#include "aweDBG.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+struct SmoothSpec
+{
+   VstInt32 curve;
+   float ms;
+};
+
+static const SmoothSpec smoothSpecs[ kNumGuiParameters] =
+{
+#define MEEBLIP_SMOOTH_SPEC( id, name, shortName, kind, cc, dflt, x, y, unit, smooth, ms) \
+   { MEEBLIP_SMOOTH_##smooth, ms },
+   MEEBLIP_GUI_PARAMETERS( MEEBLIP_SMOOTH_SPEC)
+#undef MEEBLIP_SMOOTH_SPEC
+};
+
+static const float kSmoothEpsilon = 1.0e-5f;    // exp ramp ends here
+
+// --------------------------------------------------------------------------
+//  MeeblipVST_Smoother Implementation
+// --------------------------------------------------------------------------
+
+MeeblipVST_Smoother::MeeblipVST_Smoother()
+   : active( 0)
+{
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+   {
+      outputs[i] = NULL;
+      target[i]  = 0.0f;
+      step[i]    = 0.0f;
+      count[i]   = 0;
+   }
+   setControlRate( 44100.0f / 32);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_Smoother::setControlRate( float controlRate)
+{
+   DBG( 1, "\nMeeblipVST_Smoother::setControlRate %g", controlRate );
+
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+   {
+      VstInt32 n = (VstInt32)( smoothSpecs[i].ms * 0.001f * controlRate + 0.5f);
+      periods[i] = n > 1 ? n : 1;
+      coef[i] = powf( 0.01f, 1.0f / periods[i]);
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_Smoother::setTarget( VstInt32 index, float value)
+{
+   float* output = outputs[ index];
+   if( output == NULL)
+      return;
+
+   target[ index] = value;
+
+   if( smoothSpecs[ index].curve == kSmoothNone || *output == value)
+   {
+      *output = value;
+      active &= ~(1u << index);
+      return;
+   }
+
+   // a new target restarts the ramp from the current value
+   step[ index]  = (value - *output) / periods[ index];
+   count[ index] = periods[ index];
+   active |= 1u << index;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_Smoother::finish()
+{
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+   {
+      if( active & (1u << i))
+         *outputs[i] = target[i];
+   }
+   active = 0;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_Smoother::processActive()
+{
+   uint32 bits = active;
+
+   for( VstInt32 i = 0; bits != 0; i++, bits >>= 1)
+   {
+      if( !(bits & 1))
+         continue;
+
+      float* output = outputs[i];
+      bool done;
+
+      if( smoothSpecs[i].curve == kSmoothLinear)
+      {
+         *output += step[i];
+         done = --count[i] <= 0;
+      }
+      else
+      {
+         *output = target[i] + (*output - target[i]) * coef[i];
+         done = fabsf( *output - target[i]) < kSmoothEpsilon;
+      }
+
+      if( done)
+      {
+         *output = target[i];
+         active &= ~(1u << i);
+      }
+   }
+}
@@ -0,0 +1,86 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Smoother.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   control rate smoothing of the engine parameters, ramp
+//                      time and curve are declared in the layout table
+//
+// --------------------------------------------------------------------------
+
+#ifndef __MeeblipVST_Smoother__
+#define __MeeblipVST_Smoother__
+
+#include "MeeblipVST_Layout.h"
+#include "aweVSTtypes.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+enum SmoothCurve
+{
+   kSmoothNone = 0,           // the new value is applied right away
+   kSmoothLinear,             // straight line, reaches the target after the ramp time
+   kSmoothExp                 // one pole, within 1% of the target after the ramp time
+};
+
+#define MEEBLIP_SMOOTH_NONE     kSmoothNone
+#define MEEBLIP_SMOOTH_LINEAR   kSmoothLinear
+#define MEEBLIP_SMOOTH_EXP      kSmoothExp
+
+static_assert( kNumGuiParameters <= 32, "one bit per parameter in the active mask");
+
+// --------------------------------------------------------------------------
+// MeeblipVST_Smoother
+// --------------------------------------------------------------------------
+
+// Smooths the values the engine derives from the knob values. The engine
+// binds a variable to a parameter with setOutput() and passes every new
+// value to setTarget(). process() is called once per control period and
+// moves the bound variables towards their targets. Only the parameters
+// which are still moving are touched, if none is moving process() returns
+// right away.
+
+class MeeblipVST_Smoother
+{
+public:
+   MeeblipVST_Smoother();
+
+   // control periods per second
+   void setControlRate( float controlRate);
+
+   void setOutput( VstInt32 index, float* output)   { outputs[ index] = output; }
+   void setTarget( VstInt32 index, float target);
+
+   // all values jump to their targets
+   void finish();
+
+   bool isActive()   { return active != 0; }
+
+   void process()
+   {
+      if( active)
+         processActive();
+   }
+
+protected:
+   void processActive();
+
+   float* outputs[ kNumGuiParameters];
+   float target[ kNumGuiParameters];
+   float step[ kNumGuiParameters];           // linear: increment per control period
+   float coef[ kNumGuiParameters];           // exp: pole per control period
+   VstInt32 count[ kNumGuiParameters];       // linear: control periods left
+   VstInt32 periods[ kNumGuiParameters];     // linear: control periods of the ramp
+
+   uint32 active;                            // one bit per moving parameter
+};
+
+#endif // __MeeblipVST_Smoother__
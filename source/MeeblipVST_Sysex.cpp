@@ -0,0 +1,455 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Sysex.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   the receiver holds the header bytes of a split message
+//                      until it is decided whether it is a dump
+//    17.10.2026  AWe   next() takes the time of the shared MeeblipVST_MidiLink
+//    17.10.2026  AWe   sysex patch dumps of the meeblip SE V2: message format,
+//                      payload arena, receiver and paced sender
+//
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST_Sysex.h"
+
+#include <string.h>
+
+// --------------------------------------------------------------------------
+// Debug support
+// --------------------------------------------------------------------------
+
+#define VERBOSITY       99
+#define VERBOSITY_MIN   1
+
+#include "aweDBG.h"
+
+// --------------------------------------------------------------------------
+// messages
+// --------------------------------------------------------------------------
+
+static const unsigned char header[ kSysexHeaderSize - 2] =
+{
+   kSysexStart, kSysexManufacturer, kSysexModel1, kSysexModel2, kSysexDevice
+};
+
+VstInt32 sysexMessageSize( VstInt32 command)
+{
+   return command == kSysexProgramDump ? kSysexDumpSize : kSysexRequestSize;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+VstInt32 sysexEncodeRequest( unsigned char* data, VstInt32 command, VstInt32 program)
+{
+   memcpy( data, header, sizeof( header));
+   data[5] = (unsigned char)( command & 0x7f);
+   data[6] = (unsigned char)( program & 0x7f);
+   data[7] = kSysexEnd;
+   return kSysexRequestSize;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+VstInt32 sysexEncodeDump( unsigned char* data, const MeeblipVST_SysexDump& dump)
+{
+   memcpy( data, header, sizeof( header));
+   data[5] = kSysexProgramDump;
+   data[6] = (unsigned char)( dump.program & 0x7f);
+
+   unsigned char* p = data + kSysexHeaderSize;
+   VstInt32 sum = 0;
+
+   for( VstInt32 i = 0; i < kNumGuiParameters; i++)
+   {
+      *p = dump.values[i] & 0x7f;
+      sum += *p++;
+   }
+
+   // the name ends at the first zero, the rest is padding
+   bool end = false;
+   for( VstInt32 i = 0; i < kVstMaxProgNameLen; i++)
+   {
+      end = end || dump.name[i] == 0;
+      *p = end ? 0 : (unsigned char)( dump.name[i] & 0x7f);
+      sum += *p++;
+   }
+
+   *p++ = (unsigned char)( -sum & 0x7f);
+   *p++ = kSysexEnd;
+   return kSysexDumpSize;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+bool sysexDecodeDump( const unsigned char* data, VstInt32 size, MeeblipVST_SysexDump& dump)
+{
+   if( size != kSysexDumpSize || memcmp( data, header, sizeof( header)) != 0
+    || data[5] != kSysexProgramDump || data[ size - 1] != kSysexEnd)
+      return false;
+
+   // data, name and checksum
+   VstInt32 sum = 0;
+   for( VstInt32 i = kSysexHeaderSize; i < size - 1; i++)
+   {
+      if( data[i] & 0x80)
+         return false;
+      sum += data[i];
+   }
+   if( sum & 0x7f)
+      return false;
+
+   dump.program = data[6];
+   memcpy( dump.values, data + kSysexHeaderSize, kNumGuiParameters);
+   memcpy( dump.name, data + kSysexHeaderSize + kNumGuiParameters, kVstMaxProgNameLen);
+   dump.name[ kVstMaxProgNameLen] = 0;
+   return true;
+}
+
+// --------------------------------------------------------------------------
+//  MeeblipVST_SysexArena Implementation
+// --------------------------------------------------------------------------
+
+void MeeblipVST_SysexArena::allocate( VstInt32 size)
+{
+   delete[] data;
+   data = NULL;
+   data = new unsigned char[ size];
+
+   this->size = size;
+   used = 0;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+unsigned char* MeeblipVST_SysexArena::alloc( VstInt32 bytes)
+{
+   if( bytes < 0 || bytes > size - used)
+   {
+      overflows++;
+      return NULL;
+   }
+
+   unsigned char* p = data + used;
+   used += bytes;
+   return p;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+char* MeeblipVST_SysexArena::copy( const char* source, VstInt32 bytes)
+{
+   unsigned char* p = alloc( bytes);
+   if( p && bytes > 0)
+      memcpy( p, source, bytes);
+   return (char*)p;
+}
+
+// --------------------------------------------------------------------------
+//  MeeblipVST_SysexReceiver Implementation
+// --------------------------------------------------------------------------
+
+MeeblipVST_SysexReceiver::MeeblipVST_SysexReceiver()
+   : releasedLength( 0)
+   , ownBytes( 0)
+   , received( 0)
+   , errors( 0)
+{
+   reset();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_SysexReceiver::reset()
+{
+   state = kIdle;
+   length = 0;
+   heldLength = 0;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_SysexReceiver::beginEvent()
+{
+   ownBytes = 0;
+   releasedLength = 0;
+
+   if( state != kCollect || length >= kSysexHeaderSize - 1)
+      heldLength = 0;
+   else
+      heldLength = length;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the held bytes are no dump
+
+void MeeblipVST_SysexReceiver::release()
+{
+   if( heldLength > 0)
+   {
+      memcpy( released, buffer, heldLength);
+      releasedLength = heldLength;
+      heldLength = 0;
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// A dump is recognized by its first 6 bytes, up to the command. From then
+// on its bytes count as own bytes, before that the bytes of an event which
+// ends are held.
+
+bool MeeblipVST_SysexReceiver::receive( const unsigned char* data, VstInt32 size, VstInt32& pos, MeeblipVST_SysexDump& dump)
+{
+   while( pos < size)
+   {
+      unsigned char byte = data[ pos++];
+
+      // realtime messages may appear anywhere
+      if( byte >= 0xf8)
+         continue;
+
+      if( byte == kSysexStart)
+      {
+         if( state == kCollect && length >= kSysexHeaderSize - 1)
+            errors++;
+
+         release();
+
+         buffer[0] = byte;
+         length = 1;
+         state = kCollect;
+         continue;
+      }
+
+      if( state != kCollect)
+      {
+         if( byte & 0x80)
+            state = kIdle;
+         continue;
+      }
+
+      bool own = length >= kSysexHeaderSize - 1;
+
+      // any other status byte ends the message
+      if( byte & 0x80)
+      {
+         state = kIdle;
+         if( own)
+            ownBytes++;
+         else
+            release();
+
+         if( byte == kSysexEnd && length < kSysexMaxMessage)
+         {
+            buffer[ length++] = byte;
+            if( own && sysexDecodeDump( buffer, length, dump))
+            {
+               received++;
+               return true;
+            }
+         }
+
+         if( own)
+            errors++;
+         continue;
+      }
+
+      if( length == kSysexMaxMessage)
+      {
+         // too long for a dump
+         state = kForeign;
+         errors++;
+         ownBytes++;
+         continue;
+      }
+
+      buffer[ length++] = byte;
+
+      if( !own)
+      {
+         // header and command decide
+         if( length < kSysexHeaderSize - 1 ? byte != header[ length - 1] : byte != kSysexProgramDump)
+         {
+            state = kForeign;
+            release();
+         }
+         else if( length == kSysexHeaderSize - 1)
+         {
+            ownBytes += length;
+            heldLength = 0;
+         }
+      }
+      else
+         ownBytes++;
+   }
+
+   // hold the bytes of a header which isn't decided yet
+   if( state == kCollect && length < kSysexHeaderSize - 1 && length > heldLength)
+      ownBytes += length - heldLength;
+
+   return false;
+}
+
+// --------------------------------------------------------------------------
+//  MeeblipVST_SysexSender Implementation
+// --------------------------------------------------------------------------
+
+MeeblipVST_SysexSender::MeeblipVST_SysexSender()
+   : sent( 0)
+{
+   cancel();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_SysexSender::mark( volatile int32* mask, VstInt32 program)
+{
+   volatile int32* word = mask + ( program >> 5);
+   int32 bit = (int32)( 1u << ( program & 31));
+
+   int32 value = aweAtomicLoad( word);
+   while( !aweAtomicCompareExchange( word, value, value | bit))
+      value = aweAtomicLoad( word);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// the lowest marked program, its mark is cleared
+
+bool MeeblipVST_SysexSender::take( volatile int32* mask, VstInt32& program)
+{
+   for( VstInt32 w = 0; w < kMaskWords; w++)
+   {
+      int32 value = aweAtomicLoad( mask + w);
+      while( value)
+      {
+         VstInt32 b = 0;
+         while( ( value & (int32)( 1u << b)) == 0)
+            b++;
+
+         if( aweAtomicCompareExchange( mask + w, value, value & ~(int32)( 1u << b)))
+         {
+            program = w * 32 + b;
+            return true;
+         }
+         value = aweAtomicLoad( mask + w);
+      }
+   }
+   return false;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_SysexSender::request( VstInt32 program)
+{
+   DBG( 1, "\nMeeblipVST_SysexSender::request %d", program );
+
+   if( program < 0)
+      aweAtomicStore( &bankRequest, 1);
+   else if( program < kSysexNumPrograms)
+      mark( requests, program);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_SysexSender::send( VstInt32 program)
+{
+   DBG( 1, "\nMeeblipVST_SysexSender::send %d", program );
+
+   if( program < 0)
+   {
+      for( VstInt32 w = 0; w < kMaskWords; w++)
+         aweAtomicStore( dumps + w, -1);
+   }
+   else if( program < kSysexNumPrograms)
+      mark( dumps, program);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_SysexSender::cancel()
+{
+   aweAtomicStore( &bankRequest, 0);
+   for( VstInt32 w = 0; w < kMaskWords; w++)
+   {
+      aweAtomicStore( requests + w, 0);
+      aweAtomicStore( dumps + w, 0);
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+bool MeeblipVST_SysexSender::isBusy()
+{
+   int32 pending = aweAtomicLoad( &bankRequest);
+   for( VstInt32 w = 0; w < kMaskWords; w++)
+      pending |= aweAtomicLoad( requests + w) | aweAtomicLoad( dumps + w);
+   return pending != 0;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+bool MeeblipVST_SysexSender::next( VstInt32 sampleFrames, MeeblipVST_MidiLink& link, VstInt32& command, VstInt32& program, VstInt32& deltaFrames)
+{
+   double frame = link.getFreeFrame( 0.0);
+   if( frame >= sampleFrames)
+      return false;
+
+   if( aweAtomicLoad( &bankRequest) && aweAtomicExchange( &bankRequest, 0))
+   {
+      command = kSysexRequestBank;
+      program = 0;
+   }
+   else if( take( requests, program))
+      command = kSysexRequestProgram;
+   else if( take( dumps, program))
+      command = kSysexProgramDump;
+   else
+      return false;
+
+   deltaFrames = (VstInt32)frame;
+   link.occupy( frame, sysexMessageSize( command));
+
+   sent++;
+   return true;
+}
@@ -0,0 +1,233 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Sysex.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   the receiver holds the header bytes of a split message
+//                      until it is decided whether it is a dump
+//    17.10.2026  AWe   the sender is paced by the MeeblipVST_MidiLink of the CCs
+//    17.10.2026  AWe   sysex patch dumps of the meeblip SE V2: message format,
+//                      payload arena, receiver and paced sender
+//
+// --------------------------------------------------------------------------
+
+#ifndef __MeeblipVST_Sysex__
+#define __MeeblipVST_Sysex__
+
+#include "MeeblipVST_Layout.h"
+#include "MeeblipVST_MidiLink.h"
+#include "aweAtomic.h"
+#include "aweVSTtypes.h"
+#include "pluginterfaces/vst2.x/aeffect.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// The firmware of the SE V2 defines no patch dump, the messages use the id
+// for non-commercial use. A program is sent as the midi values of its CCs:
+//
+//    F0 7D 4D 42 02 <command> <program> [ data checksum] F7
+//
+//    kSysexRequestProgram    asks for the dump of program
+//    kSysexRequestBank       asks for the dumps of all programs, program 0
+//    kSysexProgramDump       data: values[ kNumGuiParameters] in the order
+//                            of the layout, name[ kVstMaxProgNameLen] 7 bit
+//                            ascii, zero padded. The checksum makes the sum
+//                            of data and checksum a multiple of 128
+
+enum
+{
+   kSysexStart          = 0xf0,
+   kSysexEnd            = 0xf7,
+   kSysexManufacturer   = 0x7d,           // non-commercial
+   kSysexModel1         = 0x4d,           // 'M'
+   kSysexModel2         = 0x42,           // 'B'
+   kSysexDevice         = 0x02,           // SE V2
+
+   kSysexNumPrograms    = 128,            // 7 bit program number
+
+   kSysexHeaderSize     = 7,              // F0 up to the program
+   kSysexRequestSize    = kSysexHeaderSize + 1,
+   kSysexDumpDataSize   = kNumGuiParameters + kVstMaxProgNameLen,
+   kSysexDumpSize       = kSysexHeaderSize + kSysexDumpDataSize + 2,
+   kSysexMaxMessage     = kSysexDumpSize
+};
+
+enum SysexCommand
+{
+   kSysexRequestProgram = 0x01,
+   kSysexRequestBank    = 0x02,
+   kSysexProgramDump    = 0x10
+};
+
+struct MeeblipVST_SysexDump
+{
+   VstInt32 program;
+   unsigned char values[ kNumGuiParameters];
+   char name[ kVstMaxProgNameLen + 1];
+};
+
+// the size of the message of a command
+VstInt32 sysexMessageSize( VstInt32 command);
+
+// write a message to data, kSysexMaxMessage bytes are enough. Returns its
+// size
+VstInt32 sysexEncodeRequest( unsigned char* data, VstInt32 command, VstInt32 program);
+VstInt32 sysexEncodeDump( unsigned char* data, const MeeblipVST_SysexDump& dump);
+
+// a whole dump message from F0 to F7, false if it isn't one or the
+// checksum is wrong
+bool sysexDecodeDump( const unsigned char* data, VstInt32 size, MeeblipVST_SysexDump& dump);
+
+// --------------------------------------------------------------------------
+// MeeblipVST_SysexArena
+// --------------------------------------------------------------------------
+
+// The payloads of the sysex events of one block. The memory is allocated
+// once, alloc() only moves a pointer and reset() frees everything at once.
+// The host's sysexDump is only valid during processEvents(), the queues
+// hold events that point into an arena instead.
+
+class MeeblipVST_SysexArena
+{
+public:
+   MeeblipVST_SysexArena() : data( NULL), size( 0), used( 0), overflows( 0) {}
+   ~MeeblipVST_SysexArena()            { delete[] data; }
+
+   void allocate( VstInt32 size);
+
+   // bytes valid until reset(), NULL if the arena is full
+   unsigned char* alloc( VstInt32 bytes);
+   char* copy( const char* source, VstInt32 bytes);
+
+   void reset()                        { used = 0; }
+
+   VstInt32 getFree()                  { return size - used; }
+   VstInt32 getOverflows()             { return overflows; }
+
+protected:
+   unsigned char* data;
+   VstInt32 size;
+   VstInt32 used;
+   VstInt32 overflows;
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_SysexReceiver
+// --------------------------------------------------------------------------
+
+// Collects the dumps from the sysex input. A message may be split over
+// several events, realtime bytes in between are skipped. Other messages,
+// the requests included, are left to the pass thru.
+//
+// A dump is recognized by its first 6 bytes. An event which ends before
+// they are complete is held back, if the message turns out to be another
+// one in the next event, the held bytes are released to the pass thru
+// ahead of that event.
+
+class MeeblipVST_SysexReceiver
+{
+public:
+   MeeblipVST_SysexReceiver();
+
+   void reset();
+
+   // call before the first receive() of an event
+   void beginEvent();
+
+   // parses data from pos on. True when a dump is complete, pos is behind
+   // it then. False at the end of the data
+   bool receive( const unsigned char* data, VstInt32 size, VstInt32& pos, MeeblipVST_SysexDump& dump);
+
+   // the event held bytes of a dump or of a header still to be decided, it
+   // isn't passed thru
+   bool ownsEvent()                    { return ownBytes > 0; }
+
+   // after the event: the header bytes held back from earlier events which
+   // are no dump, to be passed thru before the event. 0 if there are none
+   VstInt32 getReleased( const unsigned char*& data)
+   {
+      data = released;
+      return releasedLength;
+   }
+
+   VstInt32 getReceived()              { return received; }
+   VstInt32 getErrors()                { return errors; }   // bad checksum, cut off
+
+protected:
+   enum State
+   {
+      kIdle = 0,
+      kCollect,                        // F0 up to now matches a dump
+      kForeign                         // another message, until F7
+   };
+
+   void release();
+
+   State state;
+   unsigned char buffer[ kSysexMaxMessage];
+   VstInt32 length;
+   VstInt32 heldLength;                // bytes of buffer from earlier events, undecided
+
+   unsigned char released[ kSysexHeaderSize];
+   VstInt32 releasedLength;
+
+   VstInt32 ownBytes;
+   VstInt32 received;
+   VstInt32 errors;
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_SysexSender
+// --------------------------------------------------------------------------
+
+// The transfers to the hardware. Any thread marks programs to request or
+// to send, the audio thread takes them one message at a time, as fast as
+// the link allows: a message goes out when the previous one, a CC or a
+// sysex message, has left at the byte rate( DIN MIDI by default), so a
+// bank of dumps is spread over many blocks. Marking a program twice before
+// it is sent sends it once.
+
+class MeeblipVST_SysexSender
+{
+public:
+   MeeblipVST_SysexSender();
+
+   // any thread, program < 0 is the whole bank
+   void request( VstInt32 program);
+   void send( VstInt32 program);
+   void cancel();
+   bool isBusy();
+
+   // audio thread: the next message that starts on the link within
+   // sampleFrames, in the order bank request, program requests, dumps. The
+   // caller checks first that the message fits into its queue and ends the
+   // block of the link
+   bool next( VstInt32 sampleFrames, MeeblipVST_MidiLink& link, VstInt32& command, VstInt32& program, VstInt32& deltaFrames);
+
+   VstInt32 getSent()                  { return sent; }
+
+protected:
+   enum
+   {
+      kMaskWords = kSysexNumPrograms / 32
+   };
+
+   static void mark( volatile int32* mask, VstInt32 program);
+   static bool take( volatile int32* mask, VstInt32& program);
+
+   volatile int32 bankRequest;
+   volatile int32 requests[ kMaskWords];
+   volatile int32 dumps[ kMaskWords];
+
+   VstInt32 sent;
+};
+
+#endif // __MeeblipVST_Sysex__
@@ -0,0 +1,345 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Voices.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   fixed size voice pool with mono/legato modes and
+//                      voice stealing, voice state as structure of arrays
+//
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST_Voices.h"
+
+#include <string.h>
+
+// --------------------------------------------------------------------------
+// Debug support
+// --------------------------------------------------------------------------
+
+#define VERBOSITY       99
+#define VERBOSITY_MIN   1
+
+#include "aweDBG.h"
+
+// --------------------------------------------------------------------------
+//  MeeblipVST_VoicePool Implementation
+// --------------------------------------------------------------------------
+
+MeeblipVST_VoicePool::MeeblipVST_VoicePool()
+   : polyphony( 8)
+   , voiceMode( kVoiceModeMono)
+   , stealMode( kStealOldest)
+{
+   DBG( 1, "\nMeeblipVST_VoicePool::MeeblipVST_VoicePool" );
+
+   memset( &state, 0, sizeof( state));
+
+   for( VstInt32 v = 0; v < kMaxVoices; v++)
+      state.random[v] = 0x1234567 + 0x9e3779b9 * v;
+
+   reset();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_VoicePool::reset()
+{
+   DBG( 1, "\nMeeblipVST_VoicePool::reset" );
+
+   for( VstInt32 v = 0; v < kMaxVoices; v++)
+   {
+      state.note[v]        = 60;
+      state.gate[v]        = 0;
+      state.age[v]         = 0;
+      state.pitch[v]       = 60.0f;
+      state.targetPitch[v] = 60.0f;
+      state.ampStage[v]    = kEnvIdle;
+      state.ampLevel[v]    = 0.0f;
+      state.filterStage[v] = kEnvIdle;
+      state.filterLevel[v] = 0.0f;
+      state.ic1eq[v]       = 0.0f;
+      state.ic2eq[v]       = 0.0f;
+
+      position[v] = -1;
+   }
+
+   numActive    = 0;
+   numHeldNotes = 0;
+   noteCounter  = 0;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_VoicePool::setPolyphony( VstInt32 polyphony)
+{
+   if( polyphony < 1)
+      polyphony = 1;
+   else if( polyphony > kMaxVoices)
+      polyphony = kMaxVoices;
+
+   DBG( 2, "      polyphony %d", polyphony );
+
+   this->polyphony = polyphony;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_VoicePool::setVoiceMode( VstInt32 mode)
+{
+   if( mode < 0 || mode >= kNumVoiceModes)
+      return;
+
+   DBG( 2, "      voice mode %d", mode );
+
+   voiceMode = mode;
+   numHeldNotes = 0;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_VoicePool::setStealMode( VstInt32 mode)
+{
+   if( mode < 0 || mode >= kNumStealModes)
+      return;
+
+   DBG( 2, "      steal mode %d", mode );
+
+   stealMode = mode;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+VstInt32 MeeblipVST_VoicePool::noteOn( VstInt32 note, bool& retrigger)
+{
+   VstInt32 voice;
+
+   if( voiceMode == kVoiceModePoly)
+   {
+      voice = findVoice( note);
+      retrigger = true;
+   }
+   else
+   {
+      // legato only restarts the envelopes if no other key is held
+      voice = 0;
+      retrigger = voiceMode == kVoiceModeMono || numHeldNotes == 0 || !isActive( 0);
+      pushHeldNote( note);
+   }
+
+   state.note[ voice]        = note;
+   state.gate[ voice]        = 1;
+   state.targetPitch[ voice] = (float)note;
+   if( retrigger)
+      state.age[ voice] = ++noteCounter;
+
+   activateVoice( voice);
+
+   DBG( 2, "      note on %d --> voice %d%s", note, voice, retrigger ? "" : " (legato)" );
+   return voice;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+VstInt32 MeeblipVST_VoicePool::noteOff( VstInt32 note, VstInt32& takeOver, bool& retrigger)
+{
+   takeOver = -1;
+   retrigger = false;
+
+   if( voiceMode == kVoiceModePoly)
+   {
+      for( VstInt32 i = 0; i < numActive; i++)
+      {
+         VstInt32 voice = active[i];
+         if( state.gate[ voice] && state.note[ voice] == note)
+         {
+            state.gate[ voice] = 0;
+            return voice;
+         }
+      }
+      return -1;
+   }
+
+   removeHeldNote( note);
+
+   if( !state.gate[0] || state.note[0] != note)
+      return -1;
+
+   if( numHeldNotes > 0)
+   {
+      // return to the last key which is still held
+      VstInt32 heldNote = heldNotes[ numHeldNotes-1];
+      state.note[0]        = heldNote;
+      state.targetPitch[0] = (float)heldNote;
+
+      takeOver  = 0;
+      retrigger = voiceMode == kVoiceModeMono;
+      return -1;
+   }
+
+   state.gate[0] = 0;
+   return 0;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_VoicePool::allNotesOff()
+{
+   for( VstInt32 i = 0; i < numActive; i++)
+      state.gate[ active[i]] = 0;
+
+   numHeldNotes = 0;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_VoicePool::freeVoice( VstInt32 voice)
+{
+   VstInt32 pos = position[ voice];
+   if( pos < 0)
+      return;
+
+   // swap the last active voice into the free slot
+   VstInt32 last = active[ --numActive];
+   active[ pos] = last;
+   position[ last] = pos;
+   position[ voice] = -1;
+
+   state.gate[ voice] = 0;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_VoicePool::activateVoice( VstInt32 voice)
+{
+   if( position[ voice] >= 0)
+      return;
+
+   position[ voice] = numActive;
+   active[ numActive++] = voice;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+VstInt32 MeeblipVST_VoicePool::findVoice( VstInt32 note)
+{
+   if( stealMode == kStealSameNote)
+   {
+      for( VstInt32 i = 0; i < numActive; i++)
+      {
+         if( state.note[ active[i]] == note)
+            return active[i];
+      }
+   }
+
+   // a free voice within the polyphony
+   if( numActive < polyphony)
+   {
+      for( VstInt32 v = 0; v < polyphony; v++)
+      {
+         if( position[v] < 0)
+            return v;
+      }
+   }
+
+   return stealVoice( note);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// released voices are stolen before voices whose key is still held
+
+VstInt32 MeeblipVST_VoicePool::stealVoice( VstInt32 note)
+{
+   VstInt32 best = -1;
+   bool bestGate = true;
+
+   for( VstInt32 i = 0; i < numActive; i++)
+   {
+      VstInt32 v = active[i];
+      if( v >= polyphony)
+         return v;            // polyphony was reduced, take this one first
+
+      bool gate = state.gate[v] != 0;
+
+      if( best < 0 || (bestGate && !gate))
+      {
+         best = v;
+         bestGate = gate;
+         continue;
+      }
+
+      if( gate && !bestGate)
+         continue;
+
+      if( stealMode == kStealQuietest)
+      {
+         if( state.ampLevel[v] < state.ampLevel[ best])
+            best = v;
+      }
+      else
+      {
+         if( state.age[v] < state.age[ best])
+            best = v;
+      }
+   }
+
+   DBG( 2, "      steal voice %d for note %d", best, note );
+   return best;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_VoicePool::pushHeldNote( VstInt32 note)
+{
+   removeHeldNote( note);
+   if( numHeldNotes < kNumMidiNotes)
+      heldNotes[ numHeldNotes++] = note;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_VoicePool::removeHeldNote( VstInt32 note)
+{
+   for( VstInt32 i = 0; i < numHeldNotes; i++)
+   {
+      if( heldNotes[i] == note)
+      {
+         for( VstInt32 j = i + 1; j < numHeldNotes; j++)
+            heldNotes[j-1] = heldNotes[j];
+         numHeldNotes--;
+         return;
+      }
+   }
+}
@@ -0,0 +1,173 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Voices.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   phases and filter integrators in double
+//    17.10.2026  AWe   wavetable offsets of the oscillators
+//    17.10.2026  AWe   per sample increments of the filter coefficients
+//    17.10.2026  AWe   fixed size voice pool with mono/legato modes and
+//                      voice stealing, voice state as structure of arrays
+//
+// --------------------------------------------------------------------------
+
+#ifndef __MeeblipVST_Voices__
+#define __MeeblipVST_Voices__
+
+#include "aweVSTtypes.h"
+#include "pluginterfaces/vst2.x/aeffect.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+enum
+{
+   kMaxVoices = 32,
+   kNumMidiNotes = 128
+};
+
+enum VoiceMode
+{
+   kVoiceModePoly = 0,
+   kVoiceModeMono,            // single voice, envelopes restart with every note
+   kVoiceModeLegato,          // single voice, envelopes restart only after all keys are up
+
+   kNumVoiceModes
+};
+
+enum StealMode
+{
+   kStealOldest = 0,
+   kStealQuietest,
+   kStealSameNote,            // a repeated note reuses its voice, else oldest
+
+   kNumStealModes
+};
+
+enum EnvStage
+{
+   kEnvIdle = 0,
+   kEnvAttack,
+   kEnvHold,
+   kEnvDecay
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_VoiceState
+// --------------------------------------------------------------------------
+
+// state of all voices as structure of arrays, the render loop of the engine
+// walks the arrays of the active voices in one pass
+
+struct MeeblipVST_VoiceState
+{
+   VstInt32 note[ kMaxVoices];
+   VstInt32 gate[ kMaxVoices];
+   uint32   age[ kMaxVoices];        // note on counter when the voice was started
+
+   float pitch[ kMaxVoices];
+   float targetPitch[ kMaxVoices];
+
+   double phaseA[ kMaxVoices];      // double for the double precision path,
+   double phaseB[ kMaxVoices];      // the float kernels round on load
+   float incA[ kMaxVoices];
+   float incB[ kMaxVoices];
+   VstInt32 tableA[ kMaxVoices];     // offset of the wavetable for the octave
+   VstInt32 tableB[ kMaxVoices];
+   uint32 random[ kMaxVoices];
+
+   float a1[ kMaxVoices];            // filter coefficients
+   float a2[ kMaxVoices];
+   float a3[ kMaxVoices];
+   float da1[ kMaxVoices];           // coefficient increments per sample
+   float da2[ kMaxVoices];
+   float da3[ kMaxVoices];
+   double ic1eq[ kMaxVoices];        // filter integrator states, double like the phases
+   double ic2eq[ kMaxVoices];
+
+   VstInt32 ampStage[ kMaxVoices];
+   float ampLevel[ kMaxVoices];
+   float ampTarget[ kMaxVoices];
+   float ampCoef[ kMaxVoices];
+
+   VstInt32 filterStage[ kMaxVoices];
+   float filterLevel[ kMaxVoices];
+   float filterTarget[ kMaxVoices];
+   float filterCoef[ kMaxVoices];
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_VoicePool
+// --------------------------------------------------------------------------
+
+// All memory is part of the object, note on and note off neither allocate
+// nor lock. The pool decides which voice plays a note, starting and
+// releasing the envelopes is left to the engine.
+
+class MeeblipVST_VoicePool
+{
+public:
+   MeeblipVST_VoicePool();
+
+   void reset();
+
+   void setPolyphony( VstInt32 polyphony);
+   void setVoiceMode( VstInt32 mode);
+   void setStealMode( VstInt32 mode);
+
+   VstInt32 getPolyphony() { return polyphony; }
+   VstInt32 getVoiceMode() { return voiceMode; }
+
+   // returns the voice which has to play the note. retrigger is false if
+   // the voice continues without restarting its envelopes( legato)
+   VstInt32 noteOn( VstInt32 note, bool& retrigger);
+
+   // returns the voice which has to be released, or -1. In mono and legato
+   // mode a still held note may take over the voice, in this case noteOff()
+   // returns -1 and takeOver is the voice which has to glide to its new note
+   VstInt32 noteOff( VstInt32 note, VstInt32& takeOver, bool& retrigger);
+
+   // clears all gates and held keys, the engine releases the active voices
+   void allNotesOff();
+
+   // the engine hands back voices which became silent
+   void freeVoice( VstInt32 voice);
+
+   VstInt32 getNumActive()                { return numActive; }
+   VstInt32 getActiveVoice( VstInt32 i)   { return active[i]; }
+   bool isActive( VstInt32 voice)         { return position[ voice] >= 0; }
+
+   MeeblipVST_VoiceState state;
+
+protected:
+   VstInt32 findVoice( VstInt32 note);
+   VstInt32 stealVoice( VstInt32 note);
+   void activateVoice( VstInt32 voice);
+
+   void pushHeldNote( VstInt32 note);
+   void removeHeldNote( VstInt32 note);
+
+   VstInt32 polyphony;
+   VstInt32 voiceMode;
+   VstInt32 stealMode;
+   uint32 noteCounter;
+
+   // compact list of the active voices, position[] is the index of a voice
+   // in active[] or -1
+   VstInt32 active[ kMaxVoices];
+   VstInt32 position[ kMaxVoices];
+   VstInt32 numActive;
+
+   // keys held down in the order they were pressed, used in mono and legato mode
+   VstInt32 heldNotes[ kNumMidiNotes];
+   VstInt32 numHeldNotes;
+};
+
+#endif // __MeeblipVST_Voices__
@@ -0,0 +1,207 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Wavetables.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   band limited sawtooth tables per octave, built once
+//                      per sample rate and shared by all instances
+//
+// --------------------------------------------------------------------------
+
+#include "MeeblipVST_Wavetables.h"
+#include "aweAtomic.h"
+#include "aweThread.h"
+
+#include <math.h>
+#include <stddef.h>
+
+// --------------------------------------------------------------------------
+// Debug support
+// --------------------------------------------------------------------------
+
+#define VERBOSITY       99
+#define VERBOSITY_MIN   1
+
+#include "aweDBG.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static const double kPi       = 3.14159265358979323846;
+static const float  kBaseFreq = 20.0f;     // Hz, lowest fundamental of the first octave
+
+MeeblipVST_Wavetables* MeeblipVST_Wavetables::sets = NULL;
+
+// acquire() and release() are rare, a spin lock is enough
+static volatile int32 setsLock = 0;
+
+static void lockSets()
+{
+   while( !aweAtomicCompareExchange( &setsLock, 0, 1))
+      aweSleep( 0);
+}
+
+static void unlockSets()
+{
+   aweAtomicStore( &setsLock, 0);
+}
+
+// --------------------------------------------------------------------------
+//  MeeblipVST_Wavetables Implementation
+// --------------------------------------------------------------------------
+
+const MeeblipVST_Wavetables* MeeblipVST_Wavetables::acquire( float sampleRate)
+{
+   lockSets();
+
+   MeeblipVST_Wavetables* tables = sets;
+   while( tables && tables->sampleRate != sampleRate)
+      tables = tables->next;
+
+   if( tables == NULL)
+   {
+      tables = new MeeblipVST_Wavetables( sampleRate);
+      tables->next = sets;
+      sets = tables;
+   }
+   tables->users++;
+
+   unlockSets();
+   return tables;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void MeeblipVST_Wavetables::release( const MeeblipVST_Wavetables* tables)
+{
+   if( tables == NULL)
+      return;
+
+   lockSets();
+
+   MeeblipVST_Wavetables** link = &sets;
+   while( *link && *link != tables)
+      link = &(*link)->next;
+
+   MeeblipVST_Wavetables* found = *link;
+   if( found && --found->users == 0)
+   {
+      *link = found->next;
+      delete found;
+   }
+
+   unlockSets();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+MeeblipVST_Wavetables::MeeblipVST_Wavetables( float sampleRate)
+   : sampleRate( sampleRate)
+   , octaveScale( sampleRate / kBaseFreq)
+   , users( 0)
+   , next( NULL)
+{
+   DBG( 1, "\nMeeblipVST_Wavetables::MeeblipVST_Wavetables %g", sampleRate );
+
+   // 16 extra floats to align the first table to 64 bytes
+   memory = new float[ kWavetableOctaves * kWavetableStride + 16];
+   saw = (float*)( ( (size_t)memory + 63) & ~(size_t)63);
+
+   build();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+MeeblipVST_Wavetables::~MeeblipVST_Wavetables()
+{
+   DBG( 1, "\nMeeblipVST_Wavetables::~MeeblipVST_Wavetables %g", sampleRate );
+
+   delete[] memory;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// The octave k is used for fundamentals up to kBaseFreq * 2^(k+1). The
+// tables are built from the highest octave down, each octave adds its
+// harmonics to the sum of the octave above.
+//
+//    saw( p) = 2p - 1 = -2/pi * sum( sin( 2 pi h p) / h)
+
+void MeeblipVST_Wavetables::build()
+{
+   double* sum  = new double[ kWavetableSize];
+   double* sine = new double[ kWavetableSize];
+
+   for( VstInt32 n = 0; n < kWavetableSize; n++)
+   {
+      sum[n]  = 0.0;
+      sine[n] = sin( 2.0 * kPi * n / kWavetableSize);
+   }
+
+   VstInt32 harmonic = 1;
+   for( VstInt32 k = kWavetableOctaves - 1; k >= 0; k--)
+   {
+      double topFreq = kBaseFreq * pow( 2.0, k + 1);
+      VstInt32 harmonics = (VstInt32)( 0.5 * sampleRate / topFreq);
+      if( harmonics < 1)
+         harmonics = 1;
+      if( harmonics > kWavetableSize / 2 - 1)
+         harmonics = kWavetableSize / 2 - 1;
+
+      for( ; harmonic <= harmonics; harmonic++)
+      {
+         double amplitude = -2.0 / (kPi * harmonic);
+         for( VstInt32 n = 0; n < kWavetableSize; n++)
+            sum[n] += amplitude * sine[ (harmonic * n) & (kWavetableSize - 1)];
+      }
+
+      float* table = saw + k * kWavetableStride;
+      for( VstInt32 n = 0; n < kWavetableSize; n++)
+         table[n] = (float)sum[n];
+
+      table[ kWavetableSize]     = table[0];
+      table[ kWavetableSize + 1] = table[1];
+      for( VstInt32 n = kWavetableSize + 2; n < kWavetableStride; n++)
+         table[n] = 0.0f;
+
+      DBG( 2, "      octave %d up to %g Hz, %d harmonics", k, topFreq, harmonics );
+   }
+
+   delete[] sine;
+   delete[] sum;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+VstInt32 MeeblipVST_Wavetables::getOffset( float increment) const
+{
+   // increment * octaveScale = m * 2^e with 0.5 <= m < 1, the fundamental
+   // is below kBaseFreq * 2^e, the octave is e - 1
+   int e;
+   frexpf( increment * octaveScale, &e);
+
+   VstInt32 k = e - 1;
+   if( k < 0)
+      k = 0;
+   else if( k > kWavetableOctaves - 1)
+      k = kWavetableOctaves - 1;
+
+   return k * kWavetableStride;
+}
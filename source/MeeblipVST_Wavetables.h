@@ -0,0 +1,84 @@
+// --------------------------------------------------------------------------
+//
+// Project       MeeblipVST
+//
+// File          Axel Werner
+//
+// Author        MeeblipVST_Wavetables.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   band limited sawtooth tables per octave, built once
+//                      per sample rate and shared by all instances
+//
+// --------------------------------------------------------------------------
+
+#ifndef __MeeblipVST_Wavetables__
+#define __MeeblipVST_Wavetables__
+
+#include "aweVSTtypes.h"
+#include "pluginterfaces/vst2.x/aeffect.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+enum
+{
+   kWavetableSize    = 2048,                    // samples per cycle
+   kWavetableStride  = kWavetableSize + 16,     // two guard points, padded to a cache line
+   kWavetableOctaves = 11
+};
+
+// --------------------------------------------------------------------------
+// MeeblipVST_Wavetables
+// --------------------------------------------------------------------------
+
+// One band limited sawtooth per octave of the fundamental. The table of an
+// octave holds all harmonics below the nyquist frequency at the top of the
+// octave. Pulse and square are the difference of two sawtooth lookups, so
+// one set of tables serves all waveforms.
+//
+// A set exists once per sample rate and process. acquire() builds it on the
+// first request and counts the users, release() frees it with the last one.
+// Both may allocate and must not be called from the audio thread. The
+// tables are read only after acquire() returned.
+//
+// Each table has kWavetableSize + 2 valid samples, the two guard points
+// repeat the first samples so the interpolation of the last sample needs
+// no wrap.
+
+class MeeblipVST_Wavetables
+{
+public:
+   static const MeeblipVST_Wavetables* acquire( float sampleRate);
+   static void release( const MeeblipVST_Wavetables* tables);
+
+   // start of the first table, 64 byte aligned
+   const float* getSaw() const   { return saw; }
+
+   // offset of the table for an oscillator with this phase increment per sample
+   VstInt32 getOffset( float increment) const;
+
+   float getSampleRate() const   { return sampleRate; }
+
+private:
+   MeeblipVST_Wavetables( float sampleRate);
+   ~MeeblipVST_Wavetables();
+
+   void build();
+
+   float sampleRate;
+   float octaveScale;            // increment to multiples of the lowest fundamental
+
+   float* memory;
+   float* saw;
+
+   VstInt32 users;
+   MeeblipVST_Wavetables* next;  // all sets of the process
+
+   static MeeblipVST_Wavetables* sets;
+};
+
+#endif // __MeeblipVST_Wavetables__
@@ -0,0 +1,129 @@
+// --------------------------------------------------------------------------
+//
+// Project       - generic -
+//
+// File          Axel Werner
+//
+// Author        aweAllocGuard.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   trap heap allocations made inside the audio callback
+//
+// --------------------------------------------------------------------------
+
+#include "aweAllocGuard.h"
+
+#if AWE_ALLOC_GUARD
+
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined( _MSC_VER)
+ #include <intrin.h>
+ #define AWE_THREAD_LOCAL   __declspec( thread)
+ #define AWE_TRAP()         __debugbreak()
+#else
+ #define AWE_THREAD_LOCAL   __thread
+ #define AWE_TRAP()         __builtin_trap()
+#endif
+
+#if __cplusplus >= 201103L
+ #define AWE_THROW_BAD_ALLOC
+ #define AWE_NOTHROW        noexcept
+#else
+ #define AWE_THROW_BAD_ALLOC throw( std::bad_alloc)
+ #define AWE_NOTHROW        throw()
+#endif
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static AWE_THREAD_LOCAL int guardDepth = 0;
+static volatile unsigned int allocCount = 0;
+static volatile bool trapAlloc = true;
+
+// --------------------------------------------------------------------------
+//  aweAllocGuard Implementation
+// --------------------------------------------------------------------------
+
+aweAllocGuard::aweAllocGuard()
+{
+   guardDepth++;
+}
+
+aweAllocGuard::~aweAllocGuard()
+{
+   guardDepth--;
+}
+
+unsigned int aweAllocGuard::getCount()
+{
+   return allocCount;
+}
+
+void aweAllocGuard::setTrap( bool trap)
+{
+   trapAlloc = trap;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static void* guardedAlloc( size_t size)
+{
+   if( guardDepth > 0)
+   {
+      allocCount++;
+      if( trapAlloc)
+      {
+         // no more guard while reporting
+         guardDepth = 0;
+         fprintf( stderr, "aweAllocGuard: heap allocation of %u bytes inside the audio callback\n", (unsigned int)size);
+         AWE_TRAP();
+      }
+   }
+
+   return malloc( size ? size : 1);
+}
+
+// --------------------------------------------------------------------------
+// replacements of the global operator new and delete
+// --------------------------------------------------------------------------
+
+void* operator new( size_t size) AWE_THROW_BAD_ALLOC
+{
+   void* p = guardedAlloc( size);
+   if( p == NULL)
+      throw std::bad_alloc();
+   return p;
+}
+
+void* operator new[]( size_t size) AWE_THROW_BAD_ALLOC
+{
+   void* p = guardedAlloc( size);
+   if( p == NULL)
+      throw std::bad_alloc();
+   return p;
+}
+
+void* operator new( size_t size, const std::nothrow_t&) AWE_NOTHROW
+{
+   return guardedAlloc( size);
+}
+
+void* operator new[]( size_t size, const std::nothrow_t&) AWE_NOTHROW
+{
+   return guardedAlloc( size);
+}
+
+void operator delete( void* p) AWE_NOTHROW                          { free( p); }
+void operator delete[]( void* p) AWE_NOTHROW                        { free( p); }
+void operator delete( void* p, const std::nothrow_t&) AWE_NOTHROW   { free( p); }
+void operator delete[]( void* p, const std::nothrow_t&) AWE_NOTHROW { free( p); }
+
+#endif // AWE_ALLOC_GUARD
@@ -0,0 +1,71 @@
+// --------------------------------------------------------------------------
+//
+// Project       - generic -
+//
+// File          Axel Werner
+//
+// Author        aweAllocGuard.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   trap heap allocations made inside the audio callback
+//
+// --------------------------------------------------------------------------
+
+#ifndef __aweAllocGuard__
+#define __aweAllocGuard__
+
+// enabled in debug builds, AWE_ALLOC_GUARD=0/1 overrides
+#if !defined( AWE_ALLOC_GUARD)
+ #if defined( _DEBUG)
+  #define AWE_ALLOC_GUARD 1
+ #else
+  #define AWE_ALLOC_GUARD 0
+ #endif
+#endif
+
+// --------------------------------------------------------------------------
+// aweAllocGuard
+// --------------------------------------------------------------------------
+
+// While an aweAllocGuard exists on a thread, every operator new of this
+// thread is counted and, if trapping is on, stops in the debugger. Put one
+// at the top of the audio callback:
+//
+//    void MyPlugin::processReplacing( ...)
+//    {
+//       aweAllocGuard allocGuard;
+//       ...
+//
+// With AWE_ALLOC_GUARD 0 the class is empty and operator new is not replaced.
+
+#if AWE_ALLOC_GUARD
+
+class aweAllocGuard
+{
+public:
+   aweAllocGuard();
+   ~aweAllocGuard();
+
+   // number of allocations inside a guard since the start of the program
+   static unsigned int getCount();
+
+   // false: count only, e.g. for benchmarks
+   static void setTrap( bool trap);
+};
+
+#else
+
+class aweAllocGuard
+{
+public:
+   aweAllocGuard() {}
+
+   static unsigned int getCount()   { return 0; }
+   static void setTrap( bool)       {}
+};
+
+#endif // AWE_ALLOC_GUARD
+
+#endif // __aweAllocGuard__
@@ -0,0 +1,162 @@
+// --------------------------------------------------------------------------
+//
+// Project       - generic -
+//
+// File          Axel Werner
+//
+// Author        aweAtomic.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   full fence and spin wait pause for the work-stealing deque
+//    17.10.2026  AWe   atomic load/store/exchange for lock-free queues
+//
+// --------------------------------------------------------------------------
+
+// The compilers we build with have no <atomic>( VS2010), so the few atomic
+// operations the plugin needs are mapped to the compiler intrinsics. On
+// msvc a volatile access plus a compiler barrier has acquire/release
+// semantics on x86/x64.
+
+#ifndef __aweAtomic__
+#define __aweAtomic__
+
+#include "aweVSTtypes.h"
+
+#if defined( _MSC_VER)
+ #include <intrin.h>
+ #pragma intrinsic( _ReadWriteBarrier, _InterlockedExchange, _InterlockedCompareExchange, _InterlockedExchangeAdd)
+#elif defined( __i386__) || defined( __x86_64__)
+ #include <emmintrin.h>
+#endif
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+#if defined( _MSC_VER)
+
+inline int32 aweAtomicLoad( volatile int32* p)
+{
+   int32 value = *p;
+   _ReadWriteBarrier();
+   return value;
+}
+
+inline void aweAtomicStore( volatile int32* p, int32 value)
+{
+   _ReadWriteBarrier();
+   *p = value;
+}
+
+inline int32 aweAtomicExchange( volatile int32* p, int32 value)
+{
+   return _InterlockedExchange( p, value);
+}
+
+inline int32 aweAtomicAdd( volatile int32* p, int32 value)
+{
+   return _InterlockedExchangeAdd( p, value) + value;
+}
+
+inline bool aweAtomicCompareExchange( volatile int32* p, int32 expected, int32 desired)
+{
+   return _InterlockedCompareExchange( p, desired, expected) == expected;
+}
+
+inline bool aweAtomicCompareExchangePtr( void* volatile* p, void* expected, void* desired)
+{
+#if defined( _M_IX86)
+   return (void*)_InterlockedCompareExchange( (volatile long*)p, (long)desired, (long)expected) == expected;
+#else
+   return _InterlockedCompareExchangePointer( p, desired, expected) == expected;
+#endif
+}
+
+inline void* aweAtomicLoadPtr( void* volatile* p)
+{
+   void* value = *p;
+   _ReadWriteBarrier();
+   return value;
+}
+
+inline void aweAtomicStorePtr( void* volatile* p, void* value)
+{
+   _ReadWriteBarrier();
+   *p = value;
+}
+
+// a store followed by a load of another variable needs a full fence, an
+// interlocked operation is one
+inline void aweAtomicFence()
+{
+   volatile long fence = 0;
+   _InterlockedExchange( &fence, 0);
+}
+
+// in spin wait loops
+inline void aweAtomicPause()
+{
+   _mm_pause();
+}
+
+#else
+
+inline int32 aweAtomicLoad( volatile int32* p)
+{
+   return __atomic_load_n( p, __ATOMIC_ACQUIRE);
+}
+
+inline void aweAtomicStore( volatile int32* p, int32 value)
+{
+   __atomic_store_n( p, value, __ATOMIC_RELEASE);
+}
+
+inline int32 aweAtomicExchange( volatile int32* p, int32 value)
+{
+   return __atomic_exchange_n( p, value, __ATOMIC_ACQ_REL);
+}
+
+inline int32 aweAtomicAdd( volatile int32* p, int32 value)
+{
+   return __atomic_add_fetch( p, value, __ATOMIC_ACQ_REL);
+}
+
+inline bool aweAtomicCompareExchange( volatile int32* p, int32 expected, int32 desired)
+{
+   return __atomic_compare_exchange_n( p, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+inline bool aweAtomicCompareExchangePtr( void* volatile* p, void* expected, void* desired)
+{
+   return __atomic_compare_exchange_n( p, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+inline void* aweAtomicLoadPtr( void* volatile* p)
+{
+   return __atomic_load_n( p, __ATOMIC_ACQUIRE);
+}
+
+inline void aweAtomicStorePtr( void* volatile* p, void* value)
+{
+   __atomic_store_n( p, value, __ATOMIC_RELEASE);
+}
+
+inline void aweAtomicFence()
+{
+   __atomic_thread_fence( __ATOMIC_SEQ_CST);
+}
+
+inline void aweAtomicPause()
+{
+#if defined( __i386__) || defined( __x86_64__)
+   _mm_pause();
+#elif defined( __aarch64__) || defined( __arm__)
+   __asm__ __volatile__( "yield");
+#endif
+}
+
+#endif
+
+#endif // __aweAtomic__
@@ -0,0 +1,280 @@
+// --------------------------------------------------------------------------
+//
+// Project       - generic -
+//
+// File          Axel Werner
+//
+// Author        aweFile.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   memory mapped files, file info and directory scan
+//
+// --------------------------------------------------------------------------
+
+#include "aweFile.h"
+
+#include <string.h>
+
+#if defined( _WIN32)
+ #define WIN32_LEAN_AND_MEAN
+ #include <windows.h>
+#else
+ #include <dirent.h>
+ #include <fcntl.h>
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+ #include <unistd.h>
+#endif
+
+// --------------------------------------------------------------------------
+// Debug support
+// --------------------------------------------------------------------------
+
+#define VERBOSITY       99
+#define VERBOSITY_MIN   1
+
+#include "aweDBG.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+#if defined( _WIN32)
+
+// 100 ns since 1601 to seconds since 1970
+static long long fileTimeToSeconds( const FILETIME& time)
+{
+   long long ticks = ( (long long)time.dwHighDateTime << 32) | time.dwLowDateTime;
+   return ticks / 10000000 - 11644473600LL;
+}
+
+#endif
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+bool aweGetFileInfo( const char* path, long long& size, long long& modified)
+{
+#if defined( _WIN32)
+   WIN32_FILE_ATTRIBUTE_DATA info;
+   if( !GetFileAttributesExA( path, GetFileExInfoStandard, &info))
+      return false;
+
+   size = ( (long long)info.nFileSizeHigh << 32) | info.nFileSizeLow;
+   modified = fileTimeToSeconds( info.ftLastWriteTime);
+#else
+   struct stat info;
+   if( stat( path, &info) != 0)
+      return false;
+
+   size = (long long)info.st_size;
+   modified = (long long)info.st_mtime;
+#endif
+   return true;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// path holds the directory, the names of its entries are appended to it
+
+static bool listFiles( char* path, size_t length, aweFileProc proc, void* context);
+
+static void visit( char* path, size_t length, const char* name, aweFileProc proc, void* context)
+{
+   if( strcmp( name, ".") == 0 || strcmp( name, "..") == 0)
+      return;
+
+   size_t nameLength = strlen( name);
+   if( length + 1 + nameLength >= kAweMaxPath)
+      return;
+
+   path[ length] = '/';
+   memcpy( path + length + 1, name, nameLength + 1);
+
+#if defined( _WIN32)
+   DWORD attributes = GetFileAttributesA( path);
+   bool directory = attributes != INVALID_FILE_ATTRIBUTES && ( attributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+#else
+   struct stat info;
+   bool directory = stat( path, &info) == 0 && S_ISDIR( info.st_mode);
+#endif
+
+   if( directory)
+      listFiles( path, length + 1 + nameLength, proc, context);
+   else
+      proc( context, path);
+
+   path[ length] = 0;
+}
+
+static bool listFiles( char* path, size_t length, aweFileProc proc, void* context)
+{
+#if defined( _WIN32)
+   if( length + 3 > kAweMaxPath)
+      return false;
+   strcpy( path + length, "/*");
+
+   WIN32_FIND_DATAA entry;
+   HANDLE find = FindFirstFileA( path, &entry);
+   path[ length] = 0;
+   if( find == INVALID_HANDLE_VALUE)
+      return false;
+
+   do
+      visit( path, length, entry.cFileName, proc, context);
+   while( FindNextFileA( find, &entry));
+
+   FindClose( find);
+#else
+   DIR* dir = opendir( path);
+   if( dir == NULL)
+      return false;
+
+   struct dirent* entry;
+   while( ( entry = readdir( dir)) != NULL)
+      visit( path, length, entry->d_name, proc, context);
+
+   closedir( dir);
+#endif
+   return true;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+bool aweListFiles( const char* dir, aweFileProc proc, void* context)
+{
+   char path[ kAweMaxPath];
+
+   size_t length = strlen( dir);
+   if( length >= kAweMaxPath)
+      return false;
+
+   memcpy( path, dir, length + 1);
+   while( length > 1 && ( path[ length - 1] == '/' || path[ length - 1] == '\\'))
+      path[ --length] = 0;
+
+   return listFiles( path, length, proc, context);
+}
+
+// --------------------------------------------------------------------------
+//  aweMappedFile Implementation
+// --------------------------------------------------------------------------
+
+aweMappedFile::aweMappedFile()
+   : data( NULL)
+   , size( 0)
+   , opened( false)
+#if defined( _WIN32)
+   , file( INVALID_HANDLE_VALUE)
+   , mapping( NULL)
+#endif
+{
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+aweMappedFile::~aweMappedFile()
+{
+   close();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+bool aweMappedFile::open( const char* path)
+{
+   DBG( 1, "\naweMappedFile::open %s", path );
+
+   close();
+
+#if defined( _WIN32)
+   file = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+   if( file == INVALID_HANDLE_VALUE)
+      return false;
+
+   LARGE_INTEGER fileSize;
+   if( !GetFileSizeEx( (HANDLE)file, &fileSize) || (unsigned long long)fileSize.QuadPart > (size_t)-1)
+   {
+      close();
+      return false;
+   }
+   size = (size_t)fileSize.QuadPart;
+
+   // an empty file can't be mapped
+   if( size > 0)
+   {
+      mapping = CreateFileMappingA( (HANDLE)file, NULL, PAGE_READONLY, 0, 0, NULL);
+      if( mapping != NULL)
+         data = (const unsigned char*)MapViewOfFile( (HANDLE)mapping, FILE_MAP_READ, 0, 0, 0);
+      if( data == NULL)
+      {
+         close();
+         return false;
+      }
+   }
+#else
+   int fd = ::open( path, O_RDONLY);
+   if( fd < 0)
+      return false;
+
+   struct stat info;
+   if( fstat( fd, &info) != 0)
+   {
+      ::close( fd);
+      return false;
+   }
+   size = (size_t)info.st_size;
+
+   // an empty file can't be mapped, the mapping stays valid after close()
+   if( size > 0)
+   {
+      void* memory = mmap( NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+      if( memory == MAP_FAILED)
+      {
+         ::close( fd);
+         size = 0;
+         return false;
+      }
+      data = (const unsigned char*)memory;
+   }
+   ::close( fd);
+#endif
+
+   opened = true;
+   return true;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void aweMappedFile::close()
+{
+#if defined( _WIN32)
+   if( data)
+      UnmapViewOfFile( data);
+   if( mapping)
+      CloseHandle( (HANDLE)mapping);
+   if( file != INVALID_HANDLE_VALUE)
+      CloseHandle( (HANDLE)file);
+   mapping = NULL;
+   file = INVALID_HANDLE_VALUE;
+#else
+   if( data)
+      munmap( (void*)data, size);
+#endif
+
+   data = NULL;
+   size = 0;
+   opened = false;
+}
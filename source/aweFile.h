@@ -0,0 +1,75 @@
+// --------------------------------------------------------------------------
+//
+// Project       - generic -
+//
+// File          Axel Werner
+//
+// Author        aweFile.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   memory mapped files, file info and directory scan
+//
+// --------------------------------------------------------------------------
+
+#ifndef __aweFile__
+#define __aweFile__
+
+#include <stddef.h>
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+enum
+{
+   kAweMaxPath = 1024
+};
+
+// size in bytes and time of the last change in seconds, false if there is
+// no such file
+bool aweGetFileInfo( const char* path, long long& size, long long& modified);
+
+// calls proc( context, path) for every file below dir, subdirectories
+// included. The path starts with dir, the separator is '/'. The order is
+// the one of the file system. Returns false if dir can't be read
+typedef void (*aweFileProc)( void* context, const char* path);
+
+bool aweListFiles( const char* dir, aweFileProc proc, void* context);
+
+// --------------------------------------------------------------------------
+// aweMappedFile
+// --------------------------------------------------------------------------
+
+// A whole file mapped read only into memory. The pages are read by the
+// system when they are touched, opening a large file costs nothing.
+
+class aweMappedFile
+{
+public:
+   aweMappedFile();
+   ~aweMappedFile();
+
+   bool open( const char* path);
+   void close();
+
+   bool isOpen() const                    { return opened; }
+   const unsigned char* getData() const   { return data; }     // NULL for an empty file
+   size_t getSize() const                 { return size; }
+
+private:
+   aweMappedFile( const aweMappedFile&);
+   aweMappedFile& operator=( const aweMappedFile&);
+
+   const unsigned char* data;
+   size_t size;
+   bool opened;
+
+#if defined( _WIN32)
+   void* file;
+   void* mapping;
+#endif
+};
+
+#endif // __aweFile__
@@ -0,0 +1,105 @@
+// --------------------------------------------------------------------------
+//
+// Project       - generic -
+//
+// File          Axel Werner
+//
+// Author        aweRingBuffer.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   fixed capacity ring buffer for the midi event queues
+//
+// --------------------------------------------------------------------------
+
+#ifndef __aweRingBuffer__
+#define __aweRingBuffer__
+
+#include <stddef.h>
+
+// --------------------------------------------------------------------------
+// aweRingBuffer
+// --------------------------------------------------------------------------
+
+// The memory is allocated once by allocate(), outside of the audio thread.
+// push() never allocates, if the buffer is full the element is dropped and
+// counted as overflow. Not thread safe, producer and consumer have to be
+// the same thread.
+
+template <typename T>
+class aweRingBuffer
+{
+public:
+   aweRingBuffer()
+      : buffer( NULL)
+      , mask( 0)
+      , head( 0)
+      , count( 0)
+      , overflows( 0)
+   {}
+
+   ~aweRingBuffer() { delete[] buffer; }
+
+   // capacity is rounded up to a power of two
+   void allocate( unsigned int capacity)
+   {
+      unsigned int size = 1;
+      while( size < capacity)
+         size <<= 1;
+
+      delete[] buffer;
+      buffer = NULL;
+      buffer = new T[ size];
+      mask = size - 1;
+      head = 0;
+      count = 0;
+   }
+
+   bool push( const T& element)
+   {
+      if( buffer == NULL || count > mask)
+      {
+         overflows++;
+         return false;
+      }
+
+      buffer[ (head + count) & mask] = element;
+      count++;
+      return true;
+   }
+
+   // removes the oldest element
+   void pop()
+   {
+      if( count > 0)
+      {
+         head = (head + 1) & mask;
+         count--;
+      }
+   }
+
+   void clear()                        { head = 0; count = 0; }
+
+   // index 0 is the oldest element
+   T& operator[]( unsigned int i)      { return buffer[ (head + i) & mask]; }
+
+   unsigned int size() const           { return count; }
+   unsigned int capacity() const       { return buffer ? mask + 1 : 0; }
+   bool empty() const                  { return count == 0; }
+   bool full() const                   { return buffer == NULL || count > mask; }
+
+   unsigned int getOverflows() const   { return overflows; }
+
+private:
+   aweRingBuffer( const aweRingBuffer&);
+   aweRingBuffer& operator=( const aweRingBuffer&);
+
+   T* buffer;
+   unsigned int mask;
+   unsigned int head;
+   unsigned int count;
+   unsigned int overflows;
+};
+
+#endif // __aweRingBuffer__
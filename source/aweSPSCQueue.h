@@ -0,0 +1,106 @@
+// --------------------------------------------------------------------------
+//
+// Project       - generic -
+//
+// File          Axel Werner
+//
+// Author        aweSPSCQueue.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   lock-free single producer/single consumer queue
+//
+// --------------------------------------------------------------------------
+
+#ifndef __aweSPSCQueue__
+#define __aweSPSCQueue__
+
+#include "aweAtomic.h"
+
+#include <stddef.h>
+
+// --------------------------------------------------------------------------
+// aweSPSCQueue
+// --------------------------------------------------------------------------
+
+// Exactly one thread may push() and exactly one other thread may pop().
+// Neither side locks or allocates, the memory is allocated once by
+// allocate() before both threads use the queue. head and tail count up
+// forever, their difference is the number of elements.
+
+template <typename T>
+class aweSPSCQueue
+{
+public:
+   aweSPSCQueue()
+      : buffer( NULL)
+      , mask( 0)
+      , head( 0)
+      , tail( 0)
+   {}
+
+   ~aweSPSCQueue() { delete[] buffer; }
+
+   // capacity is rounded up to a power of two
+   void allocate( unsigned int capacity)
+   {
+      unsigned int size = 1;
+      while( size < capacity)
+         size <<= 1;
+
+      delete[] buffer;
+      buffer = NULL;
+      buffer = new T[ size];
+      mask = size - 1;
+      head = 0;
+      tail = 0;
+   }
+
+   // producer side, returns false if the queue is full
+   bool push( const T& element)
+   {
+      if( buffer == NULL)
+         return false;
+
+      int32 t = tail;                     // only the producer writes tail
+      int32 h = aweAtomicLoad( &head);
+      if( (uint32)t - (uint32)h > mask)
+         return false;
+
+      buffer[ t & mask] = element;
+      aweAtomicStore( &tail, (int32)((uint32)t + 1));   // publish the element
+      return true;
+   }
+
+   // consumer side, returns false if the queue is empty
+   bool pop( T& element)
+   {
+      int32 h = head;                     // only the consumer writes head
+      int32 t = aweAtomicLoad( &tail);
+      if( h == t)
+         return false;
+
+      element = buffer[ h & mask];
+      aweAtomicStore( &head, (int32)((uint32)h + 1));   // hand the slot back
+      return true;
+   }
+
+   bool empty()   { return aweAtomicLoad( &head) == aweAtomicLoad( &tail); }
+
+private:
+   aweSPSCQueue( const aweSPSCQueue&);
+   aweSPSCQueue& operator=( const aweSPSCQueue&);
+
+   T* buffer;
+   uint32 mask;
+
+   // producer and consumer index on their own cache lines
+   char pad0[ 64];
+   volatile int32 head;
+   char pad1[ 64];
+   volatile int32 tail;
+   char pad2[ 64];
+};
+
+#endif // __aweSPSCQueue__
@@ -0,0 +1,287 @@
+// --------------------------------------------------------------------------
+//
+// Project       - generic -
+//
+// File          Axel Werner
+//
+// Author        aweThread.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   aweThreadLocal, a pointer per thread with a call at the
+//                      end of the thread
+//    17.10.2026  AWe   aweSemaphore, number of processors, realtime priority
+//    17.10.2026  AWe   add aweThread for background threads, aweSleep
+//    17.10.2026  AWe   thread id and monotonic time stamps
+//
+// --------------------------------------------------------------------------
+
+#include "aweThread.h"
+
+#if defined( _WIN32)
+ #define WIN32_LEAN_AND_MEAN
+ #include <windows.h>
+#else
+ #include <pthread.h>
+ #include <sched.h>
+ #include <semaphore.h>
+ #include <time.h>
+ #include <stdint.h>
+ #include <unistd.h>
+#endif
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+aweThreadId aweCurrentThreadId()
+{
+#if defined( _WIN32)
+   // thread ids are never zero on windows
+   return (aweThreadId)(size_t)GetCurrentThreadId();
+#else
+   return (aweThreadId)(uintptr_t)pthread_self();
+#endif
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+double aweGetTime()
+{
+#if defined( _WIN32)
+   static double period = 0.0;
+   LARGE_INTEGER count;
+
+   if( period == 0.0)
+   {
+      LARGE_INTEGER frequency;
+      QueryPerformanceFrequency( &frequency);
+      period = 1.0 / (double)frequency.QuadPart;
+   }
+
+   QueryPerformanceCounter( &count);
+   return (double)count.QuadPart * period;
+#else
+   struct timespec ts;
+   clock_gettime( CLOCK_MONOTONIC, &ts);
+   return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+#endif
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void aweSleep( int milliseconds)
+{
+#if defined( _WIN32)
+   Sleep( milliseconds);
+#else
+   struct timespec ts;
+   ts.tv_sec  = milliseconds / 1000;
+   ts.tv_nsec = ( milliseconds % 1000) * 1000000L;
+   nanosleep( &ts, NULL);
+#endif
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+int aweNumProcessors()
+{
+#if defined( _WIN32)
+   SYSTEM_INFO info;
+   GetSystemInfo( &info);
+   int count = (int)info.dwNumberOfProcessors;
+#else
+   int count = (int)sysconf( _SC_NPROCESSORS_ONLN);
+#endif
+   return count > 0 ? count : 1;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// on linux the priority is in the middle of the SCHED_FIFO range, below
+// the threads of the audio driver and about the one of the host's audio
+// thread( jack uses 70 for the driver, the clients run below it)
+
+bool aweSetRealtimePriority()
+{
+#if defined( _WIN32)
+   return SetThreadPriority( GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL) != 0;
+#else
+   struct sched_param param;
+   int low  = sched_get_priority_min( SCHED_FIFO);
+   int high = sched_get_priority_max( SCHED_FIFO);
+   param.sched_priority = low + ( high - low) / 2;
+   return pthread_setschedparam( pthread_self(), SCHED_FIFO, &param) == 0;
+#endif
+}
+
+// --------------------------------------------------------------------------
+//  aweThread Implementation
+// --------------------------------------------------------------------------
+
+aweThread::aweThread()
+   : handle( 0)
+   , proc( 0)
+   , arg( 0)
+{
+}
+
+aweThread::~aweThread()
+{
+   join();
+}
+
+#if defined( _WIN32)
+unsigned long __stdcall aweThread::entry( void* self)
+#else
+void* aweThread::entry( void* self)
+#endif
+{
+   aweThread* thread = (aweThread*)self;
+   thread->proc( thread->arg);
+   return 0;
+}
+
+bool aweThread::start( aweThreadProc proc, void* arg)
+{
+   if( handle)
+      return false;
+
+   this->proc = proc;
+   this->arg  = arg;
+
+#if defined( _WIN32)
+   handle = CreateThread( NULL, 0, entry, this, 0, NULL);
+#else
+   pthread_t thread;
+   if( pthread_create( &thread, NULL, entry, this) == 0)
+   {
+      pthread_t* p = new pthread_t;
+      *p = thread;
+      handle = p;
+   }
+#endif
+   return handle != 0;
+}
+
+void aweThread::join()
+{
+   if( handle == 0)
+      return;
+
+#if defined( _WIN32)
+   WaitForSingleObject( (HANDLE)handle, INFINITE);
+   CloseHandle( (HANDLE)handle);
+#else
+   pthread_t* p = (pthread_t*)handle;
+   pthread_join( *p, NULL);
+   delete p;
+#endif
+   handle = 0;
+}
+
+// --------------------------------------------------------------------------
+//  aweSemaphore Implementation
+// --------------------------------------------------------------------------
+
+aweSemaphore::aweSemaphore()
+{
+#if defined( _WIN32)
+   handle = CreateSemaphore( NULL, 0, 0x7fffffff, NULL);
+#else
+   sem_t* s = new sem_t;
+   sem_init( s, 0, 0);
+   handle = s;
+#endif
+}
+
+aweSemaphore::~aweSemaphore()
+{
+#if defined( _WIN32)
+   CloseHandle( (HANDLE)handle);
+#else
+   sem_destroy( (sem_t*)handle);
+   delete (sem_t*)handle;
+#endif
+}
+
+void aweSemaphore::post()
+{
+#if defined( _WIN32)
+   ReleaseSemaphore( (HANDLE)handle, 1, NULL);
+#else
+   sem_post( (sem_t*)handle);
+#endif
+}
+
+void aweSemaphore::wait()
+{
+#if defined( _WIN32)
+   WaitForSingleObject( (HANDLE)handle, INFINITE);
+#else
+   // retry after a signal interrupted the wait
+   while( sem_wait( (sem_t*)handle) != 0)
+      ;
+#endif
+}
+
+// --------------------------------------------------------------------------
+//  aweThreadLocal Implementation
+// --------------------------------------------------------------------------
+
+aweThreadLocal::aweThreadLocal( aweThreadExitProc exitProc)
+{
+#if defined( _WIN32)
+   key = FlsAlloc( exitProc);
+   valid = key != FLS_OUT_OF_INDEXES;
+#else
+   pthread_key_t k;
+   valid = pthread_key_create( &k, exitProc) == 0;
+   key = (unsigned long)k;
+#endif
+}
+
+aweThreadLocal::~aweThreadLocal()
+{
+   if( !valid)
+      return;
+
+#if defined( _WIN32)
+   FlsFree( key);          // calls exitProc for the values left
+#else
+   pthread_key_delete( (pthread_key_t)key);
+#endif
+}
+
+void* aweThreadLocal::get()
+{
+   if( !valid)
+      return NULL;
+
+#if defined( _WIN32)
+   return FlsGetValue( key);
+#else
+   return pthread_getspecific( (pthread_key_t)key);
+#endif
+}
+
+void aweThreadLocal::set( void* value)
+{
+   if( !valid)
+      return;
+
+#if defined( _WIN32)
+   FlsSetValue( key, value);
+#else
+   pthread_setspecific( (pthread_key_t)key, value);
+#endif
+}
@@ -0,0 +1,133 @@
+// --------------------------------------------------------------------------
+//
+// Project       - generic -
+//
+// File          Axel Werner
+//
+// Author        aweThread.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   aweThreadLocal, a pointer per thread with a call at the
+//                      end of the thread
+//    17.10.2026  AWe   aweSemaphore, number of processors, realtime priority
+//    17.10.2026  AWe   add aweThread for background threads, aweSleep
+//    17.10.2026  AWe   thread id and monotonic time stamps
+//
+// --------------------------------------------------------------------------
+
+#ifndef __aweThread__
+#define __aweThread__
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+typedef void* aweThreadId;    // never NULL for a running thread
+
+aweThreadId aweCurrentThreadId();
+
+// seconds since an arbitrary start, monotonic
+double aweGetTime();
+
+void aweSleep( int milliseconds);
+
+// number of processors the system has online, at least 1
+int aweNumProcessors();
+
+// raises the priority of the calling thread to the realtime class
+// ( SCHED_FIFO on linux, TIME_CRITICAL on windows), returns false if the
+// system doesn't allow it, the thread keeps its priority then
+bool aweSetRealtimePriority();
+
+// --------------------------------------------------------------------------
+// aweThread
+// --------------------------------------------------------------------------
+
+// a plain background thread running proc( arg), join() waits for its end
+
+typedef void (*aweThreadProc)( void* arg);
+
+class aweThread
+{
+public:
+   aweThread();
+   ~aweThread();
+
+   bool start( aweThreadProc proc, void* arg);
+   void join();
+   bool isRunning()     { return handle != 0; }
+
+private:
+   aweThread( const aweThread&);
+   aweThread& operator=( const aweThread&);
+
+   void* handle;
+   aweThreadProc proc;
+   void* arg;
+
+#if defined( _WIN32)
+   static unsigned long __stdcall entry( void* self);
+#else
+   static void* entry( void* self);
+#endif
+};
+
+// --------------------------------------------------------------------------
+// aweSemaphore
+// --------------------------------------------------------------------------
+
+// counting semaphore, post() never blocks and takes no lock in user space
+
+class aweSemaphore
+{
+public:
+   aweSemaphore();
+   ~aweSemaphore();
+
+   void post();
+   void wait();
+
+private:
+   aweSemaphore( const aweSemaphore&);
+   aweSemaphore& operator=( const aweSemaphore&);
+
+   void* handle;
+};
+
+// --------------------------------------------------------------------------
+// aweThreadLocal
+// --------------------------------------------------------------------------
+
+// A pointer per thread. When a thread ends with a value other than NULL,
+// exitProc( value) is called on that thread, for the threads of the host
+// as well as for aweThread. A slot of the system( pthread key, fiber local
+// storage on windows), so keep the number of instances small.
+
+#if defined( _WIN32)
+ #define AWE_THREAD_EXIT_CALL   __stdcall
+#else
+ #define AWE_THREAD_EXIT_CALL
+#endif
+
+typedef void (AWE_THREAD_EXIT_CALL *aweThreadExitProc)( void* value);
+
+class aweThreadLocal
+{
+public:
+   aweThreadLocal( aweThreadExitProc exitProc);
+   ~aweThreadLocal();
+
+   void* get();
+   void set( void* value);
+
+private:
+   aweThreadLocal( const aweThreadLocal&);
+   aweThreadLocal& operator=( const aweThreadLocal&);
+
+   unsigned long key;
+   bool valid;
+};
+
+#endif // __aweThread__
@@ -0,0 +1,250 @@
+// --------------------------------------------------------------------------
+//
+// Project       - generic -
+//
+// File          Axel Werner
+//
+// Author        aweTrace.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   a queue is released at the end of its thread and freed
+//                      by the drain thread once it is empty
+//    17.10.2026  AWe   lock-free tracing of the real-time paths, written as
+//                      Chrome trace JSON by a background thread
+//
+// References
+//    Chrome "Trace Event Format", JSON object format, loads into
+//    chrome://tracing and ui.perfetto.dev
+//
+// --------------------------------------------------------------------------
+
+#include "aweTrace.h"
+#include "aweThread.h"
+#include "aweSPSCQueue.h"
+
+#include <stdio.h>
+
+#if defined( _MSC_VER)
+ #define AWE_THREAD_LOCAL   __declspec( thread)
+#else
+ #define AWE_THREAD_LOCAL   __thread
+#endif
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+typedef aweSPSCQueue<aweTraceRecord> aweTraceQueue;
+
+volatile int32 aweTrace::enabled = 0;
+
+enum QueueState
+{
+   kQueueFree = 0,
+   kQueueClaimed,
+   kQueueReleased                         // its thread ended, the drain frees it
+};
+
+// producer side
+static aweTraceQueue* queues = NULL;                        // kMaxThreads, never freed
+static volatile int32 claimed[ aweTrace::kMaxThreads];      // QueueState
+static volatile int32 dropped = 0;
+static AWE_THREAD_LOCAL aweTraceQueue* threadQueue = NULL;
+static AWE_THREAD_LOCAL int32 threadNoQueue = 0;             // all queues were taken
+
+static void AWE_THREAD_EXIT_CALL releaseQueue( void* queue);
+static aweThreadLocal threadExit( releaseQueue);
+
+// drain side
+static volatile int32 refCount = 0;
+static volatile int32 draining = 0;
+static aweThread drainThread;
+static FILE* file = NULL;
+static bool firstRecord = true;
+static uint64 startTicks = 0;
+static double startTime = 0.0;
+static double ticksPerMicrosecond = 1.0;
+
+// --------------------------------------------------------------------------
+//  aweTrace Implementation
+// --------------------------------------------------------------------------
+
+// called at the end of a thread which claimed a queue, the records left
+// in it are still written
+
+static void AWE_THREAD_EXIT_CALL releaseQueue( void* queue)
+{
+   if( queue != NULL)
+      aweAtomicStore( &claimed[ (aweTraceQueue*)queue - queues], kQueueReleased);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void aweTrace::write( const char* name, int32 phase, int32 value, uint64 ticks)
+{
+   aweTraceQueue* queue = threadQueue;
+
+   if( queue == NULL)
+   {
+      // first record of this thread, claim a queue
+      if( threadNoQueue == 0)
+      {
+         for( int32 i = 0; i < kMaxThreads; i++)
+         {
+            if( aweAtomicCompareExchange( &claimed[i], kQueueFree, kQueueClaimed))
+            {
+               queue = &queues[i];
+               break;
+            }
+         }
+      }
+
+      if( queue == NULL)
+      {
+         threadNoQueue = 1;
+         aweAtomicAdd( &dropped, 1);
+         return;
+      }
+      threadQueue = queue;
+      threadExit.set( queue);
+   }
+
+   aweTraceRecord record;
+   record.ticks = ticks;
+   record.name  = name;
+   record.phase = phase;
+   record.value = value;
+
+   if( !queue->push( record))
+      aweAtomicAdd( &dropped, 1);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+uint32 aweTrace::getDropped()
+{
+   return (uint32)aweAtomicLoad( &dropped);
+}
+
+// --------------------------------------------------------------------------
+// drain thread
+// --------------------------------------------------------------------------
+
+static void writeRecord( int32 tid, const aweTraceRecord& record)
+{
+   static const char phases[] = { 'B', 'E', 'C', 'i' };
+
+   double ts = (double)(int64)( record.ticks - startTicks) / ticksPerMicrosecond;
+
+   fprintf( file, "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d",
+            firstRecord ? "" : ",", record.name, phases[ record.phase & 3], ts, tid);
+
+   switch( record.phase)
+   {
+      case kTraceEnd:      fprintf( file, ",\"args\":{\"cycles\":%u}}", (uint32)record.value);   break;
+      case kTraceCounter:  fprintf( file, ",\"args\":{\"value\":%d}}", record.value);            break;
+      case kTraceInstant:  fprintf( file, ",\"s\":\"t\",\"args\":{\"value\":%d}}", record.value); break;
+      default:             fprintf( file, "}");                                                  break;
+   }
+   firstRecord = false;
+}
+
+static void drainQueues()
+{
+   aweTraceRecord record;
+
+   for( int32 i = 0; i < aweTrace::kMaxThreads; i++)
+   {
+      int32 state = aweAtomicLoad( &claimed[i]);
+      if( state == kQueueFree)
+         continue;
+
+      while( queues[i].pop( record))
+         writeRecord( i + 1, record);
+
+      // the thread has ended and its records are written, the queue is
+      // free for the next thread
+      if( state == kQueueReleased)
+         aweAtomicStore( &claimed[i], kQueueFree);
+   }
+   fflush( file);
+}
+
+static void drainProc( void*)
+{
+   // the tick rate is measured once, over the first interval
+   aweSleep( 5 * aweTrace::kDrainInterval);
+
+   double seconds = aweGetTime() - startTime;
+   ticksPerMicrosecond = (double)( aweTraceTicks() - startTicks) / ( seconds * 1.0e6);
+   if( ticksPerMicrosecond <= 0.0)
+      ticksPerMicrosecond = 1.0;
+
+   while( aweAtomicLoad( &draining))
+   {
+      drainQueues();
+      aweSleep( aweTrace::kDrainInterval);
+   }
+   drainQueues();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+bool aweTrace::start( const char* path)
+{
+   if( aweAtomicAdd( &refCount, 1) > 1)
+      return true;                        // already running
+
+   if( queues == NULL)
+   {
+      queues = new aweTraceQueue[ kMaxThreads];
+      for( int32 i = 0; i < kMaxThreads; i++)
+         queues[i].allocate( kRecordsPerThread);
+   }
+
+   file = fopen( path, "w");
+   if( file == NULL)
+   {
+      aweAtomicAdd( &refCount, -1);
+      return false;
+   }
+
+   fprintf( file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+   firstRecord = true;
+   aweAtomicStore( &dropped, 0);
+
+   startTicks = aweTraceTicks();
+   startTime  = aweGetTime();
+
+   aweAtomicStore( &draining, 1);
+   drainThread.start( drainProc, NULL);
+
+   aweAtomicStore( &enabled, 1);
+   return true;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void aweTrace::stop()
+{
+   if( aweAtomicAdd( &refCount, -1) > 0 || file == NULL)
+      return;
+
+   aweAtomicStore( &enabled, 0);
+   aweAtomicStore( &draining, 0);
+   drainThread.join();
+
+   fprintf( file, "\n],\"otherData\":{\"dropped\":\"%u\"}}\n", getDropped());
+   fclose( file);
+   file = NULL;
+}
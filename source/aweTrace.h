@@ -0,0 +1,170 @@
+// --------------------------------------------------------------------------
+//
+// Project       - generic -
+//
+// File          Axel Werner
+//
+// Author        aweTrace.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   the queue of a thread is released when the thread ends
+//    17.10.2026  AWe   lock-free tracing of the real-time paths, written as
+//                      Chrome trace JSON by a background thread
+//
+// --------------------------------------------------------------------------
+
+#ifndef __aweTrace__
+#define __aweTrace__
+
+#include "aweVSTtypes.h"
+#include "aweAtomic.h"
+#include "aweThread.h"
+
+// compiled in by default, AWE_TRACE=0 removes the trace points
+#if !defined( AWE_TRACE)
+ #define AWE_TRACE 1
+#endif
+
+#if defined( _MSC_VER) && ( defined( _M_IX86) || defined( _M_X64))
+ #include <intrin.h>
+#elif defined( __i386__) || defined( __x86_64__)
+ #include <x86intrin.h>
+#endif
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+enum aweTracePhase
+{
+   kTraceBegin = 0,
+   kTraceEnd,                 // value: ticks since the begin
+   kTraceCounter,
+   kTraceInstant
+};
+
+// cpu cycles where the cpu has a cycle counter, else nanoseconds
+inline uint64 aweTraceTicks()
+{
+#if defined( _MSC_VER) && ( defined( _M_IX86) || defined( _M_X64))
+   return __rdtsc();
+#elif defined( __i386__) || defined( __x86_64__)
+   return __rdtsc();
+#elif defined( __aarch64__)
+   uint64 ticks;
+   __asm__ __volatile__( "mrs %0, cntvct_el0" : "=r"( ticks));
+   return ticks;
+#else
+   return (uint64)( aweGetTime() * 1.0e9);
+#endif
+}
+
+// one fixed size record, name has to be a string literal
+struct aweTraceRecord
+{
+   uint64 ticks;
+   const char* name;
+   int32 phase;
+   int32 value;
+};
+
+// --------------------------------------------------------------------------
+// aweTrace
+// --------------------------------------------------------------------------
+
+// Every thread writes its records into its own SPSC ring buffer, the drain
+// thread empties the buffers every kDrainInterval ms into the trace file.
+// While tracing is off a trace point costs one load and one branch. The
+// buffers are allocated by the first start() and kept, a thread keeps its
+// buffer for its lifetime and releases it when it ends, the drain thread
+// frees it for the next thread once it is empty. At most kMaxThreads
+// threads trace at the same time, the records of any other thread and
+// those which don't fit are counted as dropped. The trace shows the
+// queue as the thread id, a later thread may show up under the id of an
+// ended one.
+//
+// start() and stop() nest, the file is closed by the last stop().
+
+class aweTrace
+{
+public:
+   enum
+   {
+      kMaxThreads       = 16,
+      kRecordsPerThread = 16384,
+      kDrainInterval    = 10     // ms
+   };
+
+   static bool start( const char* path);
+   static void stop();
+
+   static bool isEnabled()    { return aweAtomicLoad( &enabled) != 0; }
+
+   static void record( const char* name, int32 phase, int32 value)
+   {
+      if( isEnabled())
+         write( name, phase, value, aweTraceTicks());
+   }
+
+   static void record( const char* name, int32 phase, int32 value, uint64 ticks)
+   {
+      if( isEnabled())
+         write( name, phase, value, ticks);
+   }
+
+   static uint32 getDropped();
+
+private:
+   static void write( const char* name, int32 phase, int32 value, uint64 ticks);
+
+   static volatile int32 enabled;
+};
+
+// --------------------------------------------------------------------------
+// aweTraceScope
+// --------------------------------------------------------------------------
+
+// begin record in the constructor, end record with the elapsed ticks in the
+// destructor. No end record if tracing was off at the begin
+
+class aweTraceScope
+{
+public:
+   aweTraceScope( const char* name)
+      : name( name)
+      , ticks( aweTrace::isEnabled() ? aweTraceTicks() : 0)
+   {
+      aweTrace::record( name, kTraceBegin, 0, ticks);
+   }
+
+   ~aweTraceScope()
+   {
+      if( ticks && aweTrace::isEnabled())
+      {
+         uint64 now = aweTraceTicks();
+         aweTrace::record( name, kTraceEnd, (int32)( now - ticks), now);
+      }
+   }
+
+private:
+   const char* name;
+   uint64 ticks;
+};
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+#if AWE_TRACE
+ #define AWE_TRACE_SCOPE( name)            aweTraceScope traceScope( name)
+ #define AWE_TRACE_COUNTER( name, value)   aweTrace::record( name, kTraceCounter, (int32)( value))
+ #define AWE_TRACE_INSTANT( name, value)   aweTrace::record( name, kTraceInstant, (int32)( value))
+#else
+ #define AWE_TRACE_SCOPE( name)
+ #define AWE_TRACE_COUNTER( name, value)
+ #define AWE_TRACE_INSTANT( name, value)
+#endif
+
+#endif // __aweTrace__
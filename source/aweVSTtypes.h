@@ -9,6 +9,8 @@
 // --------------------------------------------------------------------------
 // Changelog
 //
+//    17.10.2026  AWe   add int64 and uint64
+//    17.10.2026  AWe   int32 and uint32 are 32 bit on all 64 bit platforms
 //    19.08.2013  AWe   define some types which are defined for in VST3 as
 //                      their VST2.x pendant. see also
 //                       ...\VST3 SDK\pluginterfaces\base\ftypes.h
@@ -30,7 +32,7 @@
    typedef short int16;
    typedef unsigned short uint16;
 
-#if MAC && __LP64__
+#if __LP64__
    typedef int int32;
    typedef unsigned int uint32;
 #else
@@ -38,6 +40,9 @@
    typedef unsigned long uint32;
 #endif
 
+   typedef long long int64;
+   typedef unsigned long long uint64;
+
 // --------------------------------------------------------------------------
 //
 // --------------------------------------------------------------------------
@@ -0,0 +1,138 @@
+// --------------------------------------------------------------------------
+//
+// Project       - generic -
+//
+// File          Axel Werner
+//
+// Author        aweWorkDeque.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   lock-free work-stealing deque of task numbers
+//
+// --------------------------------------------------------------------------
+
+// Chase, Lev "Dynamic Circular Work-Stealing Deque" with the memory order of
+// Le, Pop, Cohen, Zappa Nardelli "Correct and Efficient Work-Stealing for
+// Weak Memory Models", with a fixed capacity.
+
+#ifndef __aweWorkDeque__
+#define __aweWorkDeque__
+
+#include "aweAtomic.h"
+
+#include <stddef.h>
+
+// --------------------------------------------------------------------------
+// aweWorkDeque
+// --------------------------------------------------------------------------
+
+// The owner thread push()es and pop()s at the bottom, any other thread may
+// steal() from the top. Nobody locks or allocates, the memory is allocated
+// once by allocate(). top and bottom count up forever, so a compare and
+// swap on top never sees an old value again.
+
+class aweWorkDeque
+{
+public:
+   aweWorkDeque()
+      : buffer( NULL)
+      , mask( 0)
+      , top( 0)
+      , bottom( 0)
+   {}
+
+   ~aweWorkDeque() { delete[] buffer; }
+
+   // capacity is rounded up to a power of two, not while the deque is used
+   void allocate( unsigned int capacity)
+   {
+      unsigned int size = 1;
+      while( size < capacity)
+         size <<= 1;
+
+      delete[] buffer;
+      buffer = NULL;
+      buffer = new int32[ size];
+      mask = size - 1;
+      top = 0;
+      bottom = 0;
+   }
+
+   // owner side, returns false if the deque is full
+   bool push( int32 task)
+   {
+      int32 b = bottom;                   // only the owner writes bottom
+      int32 t = aweAtomicLoad( &top);
+      if( (uint32)b - (uint32)t > mask)
+         return false;
+
+      // a thief with an old top may read the slot, its steal fails then
+      aweAtomicStore( &buffer[ b & mask], task);
+      aweAtomicStore( &bottom, (int32)((uint32)b + 1));   // publish the task
+      return true;
+   }
+
+   // owner side, the task pushed last. Returns false if the deque is empty
+   bool pop( int32& task)
+   {
+      int32 b = (int32)((uint32)bottom - 1);
+      aweAtomicStore( &bottom, b);
+      aweAtomicFence();                   // the thieves see bottom before we read top
+      int32 t = aweAtomicLoad( &top);
+
+      if( (int32)((uint32)b - (uint32)t) < 0)
+      {
+         aweAtomicStore( &bottom, (int32)((uint32)b + 1));
+         return false;
+      }
+
+      task = aweAtomicLoad( &buffer[ b & mask]);
+      if( b != t)
+         return true;
+
+      // the last task, race against the thieves for it
+      bool won = aweAtomicCompareExchange( &top, t, (int32)((uint32)t + 1));
+      aweAtomicStore( &bottom, (int32)((uint32)b + 1));
+      return won;
+   }
+
+   // any other thread, the oldest task. Returns false if the deque is empty
+   // or another thread was faster
+   bool steal( int32& task)
+   {
+      int32 t = aweAtomicLoad( &top);
+      aweAtomicFence();
+      int32 b = aweAtomicLoad( &bottom);
+
+      if( (int32)((uint32)b - (uint32)t) <= 0)
+         return false;
+
+      task = aweAtomicLoad( &buffer[ t & mask]);
+      return aweAtomicCompareExchange( &top, t, (int32)((uint32)t + 1));
+   }
+
+   bool isEmpty()
+   {
+      int32 t = aweAtomicLoad( &top);
+      int32 b = aweAtomicLoad( &bottom);
+      return (int32)((uint32)b - (uint32)t) <= 0;
+   }
+
+private:
+   aweWorkDeque( const aweWorkDeque&);
+   aweWorkDeque& operator=( const aweWorkDeque&);
+
+   volatile int32* buffer;
+   unsigned int mask;
+
+   // on their own cache lines, the thieves hammer top
+   char pad0[ 64];
+   volatile int32 top;
+   char pad1[ 64];
+   volatile int32 bottom;
+   char pad2[ 64];
+};
+
+#endif // __aweWorkDeque__
@@ -0,0 +1,268 @@
+// --------------------------------------------------------------------------
+//
+// Project       - generic -
+//
+// File          Axel Werner
+//
+// Author        aweWorkerPool.cpp
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   braces around the DBG of workerLoop(), empty without debug output
+//    17.10.2026  AWe   realtime worker threads for the audio thread
+//
+// --------------------------------------------------------------------------
+
+#include "aweWorkerPool.h"
+
+#include <stddef.h>
+
+// --------------------------------------------------------------------------
+// Debug support
+// --------------------------------------------------------------------------
+
+#define VERBOSITY       99
+#define VERBOSITY_MIN   1
+
+#include "aweDBG.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+static const int kSpinCount    = 4000;   // pauses a worker waits for more tasks before it sleeps
+static const int kMaxMisses    = 8;
+static const int kBackoffCalls = 1024;
+
+// --------------------------------------------------------------------------
+//  aweWorkerPool Implementation
+// --------------------------------------------------------------------------
+
+aweWorkerPool::aweWorkerPool()
+   : numWorkers( 0)
+   , workers( NULL)
+   , generation( 0)
+   , stolen( 0)
+   , quit( 0)
+   , render( NULL)
+   , context( NULL)
+   , misses( 0)
+   , backoff( 0)
+   , serialCalls( 0)
+{
+   for( int i = 0; i < kMaxPoolTasks; i++)
+      finished[i] = 0;
+
+   tasks.allocate( kMaxPoolTasks);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+aweWorkerPool::~aweWorkerPool()
+{
+   stop();
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void aweWorkerPool::start( int numWorkers)
+{
+   DBG( 1, "\naweWorkerPool::start %d workers", numWorkers );
+
+   stop();
+
+   if( numWorkers > kMaxPoolWorkers)
+      numWorkers = kMaxPoolWorkers;
+   if( numWorkers <= 0)
+      return;
+
+   quit = 0;
+   misses = 0;
+   backoff = 0;
+   serialCalls = 0;
+
+   workers = new Worker[ numWorkers];
+   for( int i = 0; i < numWorkers; i++)
+   {
+      workers[i].pool = this;
+      workers[i].sleeping = 0;
+      if( !workers[i].thread.start( workerEntry, &workers[i]))
+         break;
+      this->numWorkers = i + 1;
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void aweWorkerPool::stop()
+{
+   if( workers == NULL)
+      return;
+
+   DBG( 1, "\naweWorkerPool::stop" );
+
+   aweAtomicStore( &quit, 1);
+   for( int i = 0; i < numWorkers; i++)
+   {
+      workers[i].wake.post();
+      workers[i].thread.join();
+   }
+
+   delete[] workers;
+   workers = NULL;
+   numWorkers = 0;
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+void aweWorkerPool::workerEntry( void* arg)
+{
+   Worker* worker = (Worker*)arg;
+   worker->pool->workerLoop( worker);
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// A worker spins for a while after its last task, the next process() call
+// of a host with small buffers finds it awake. Before it sleeps it
+// announces it in sleeping and looks at the deque once more, run() either
+// sees the flag or the worker sees the tasks.
+
+void aweWorkerPool::workerLoop( Worker* worker)
+{
+   if( !aweSetRealtimePriority())
+   {
+      DBG( 1, "\naweWorkerPool::workerLoop no realtime priority" );
+   }
+
+   for( ;;)
+   {
+      int spin = 0;
+      while( spin < kSpinCount && !aweAtomicLoad( &quit))
+      {
+         int32 task;
+         if( tasks.steal( task))
+         {
+            execute( task);
+            spin = 0;
+         }
+         else
+         {
+            aweAtomicPause();
+            spin++;
+         }
+      }
+
+      if( aweAtomicLoad( &quit))
+         break;
+
+      aweAtomicExchange( &worker->sleeping, 1);
+      if( !tasks.isEmpty() && aweAtomicExchange( &worker->sleeping, 0) == 1)
+         continue;
+
+      // sleeping, or run() cleared the flag and posts
+      worker->wake.wait();
+   }
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// a stolen task belongs to the current generation, run() doesn't return
+// before it is finished
+
+void aweWorkerPool::execute( int32 task)
+{
+   render( context, task);
+   aweAtomicAdd( &stolen, 1);
+   aweAtomicStore( &finished[ task], aweAtomicLoad( &generation));
+}
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+bool aweWorkerPool::run( aweTaskProc render, aweTaskProc done, void* context, int numTasks)
+{
+   if( numWorkers == 0 || numTasks < 2 || numTasks > kMaxPoolTasks)
+      return false;
+
+   if( backoff > 0)
+   {
+      backoff--;
+      serialCalls++;
+      return false;
+   }
+
+   double start = aweGetTime();
+
+   // the job before the tasks, the push publishes it
+   this->render  = render;
+   this->context = context;
+   int32 current = (int32)((uint32)generation + 1);
+   aweAtomicStore( &generation, current);
+   aweAtomicStore( &stolen, 0);
+
+   for( int i = 0; i < numTasks; i++)
+      tasks.push( i);
+
+   // one worker less than tasks, the audio thread takes one itself
+   int wake = numTasks - 1 < numWorkers ? numTasks - 1 : numWorkers;
+   for( int i = 0; i < wake; i++)
+   {
+      if( aweAtomicExchange( &workers[i].sleeping, 0) == 1)
+         workers[i].wake.post();
+   }
+
+   // render from the bottom, hand over the finished tasks from the top
+   int next = 0;
+   int32 task;
+   while( tasks.pop( task))
+   {
+      render( context, task);
+      aweAtomicStore( &finished[ task], current);
+
+      while( next < numTasks && aweAtomicLoad( &finished[ next]) == current)
+         done( context, next++);
+   }
+
+   double waitStart = aweGetTime();
+
+   // the rest is in the hands of the workers
+   while( next < numTasks)
+   {
+      if( aweAtomicLoad( &finished[ next]) == current)
+         done( context, next++);
+      else
+         aweAtomicPause();
+   }
+
+   double end = aweGetTime();
+
+   // the workers came too late or were interrupted
+   if( aweAtomicLoad( &stolen) == 0 || end - waitStart > waitStart - start)
+   {
+      if( ++misses >= kMaxMisses)
+      {
+         DBG( 2, "\naweWorkerPool::run cores busy, single threaded for %d calls", kBackoffCalls );
+         misses = 0;
+         backoff = kBackoffCalls;
+      }
+   }
+   else
+      misses = 0;
+
+   return true;
+}
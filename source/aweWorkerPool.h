@@ -0,0 +1,106 @@
+// --------------------------------------------------------------------------
+//
+// Project       - generic -
+//
+// File          Axel Werner
+//
+// Author        aweWorkerPool.h
+//
+// --------------------------------------------------------------------------
+// Changelog
+//
+//    17.10.2026  AWe   realtime worker threads for the audio thread
+//
+// --------------------------------------------------------------------------
+
+#ifndef __aweWorkerPool__
+#define __aweWorkerPool__
+
+#include "aweThread.h"
+#include "aweWorkDeque.h"
+
+// --------------------------------------------------------------------------
+//
+// --------------------------------------------------------------------------
+
+// render( context, task) computes a task, any thread may call it.
+// done( context, task) is called on the audio thread only
+
+typedef void (*aweTaskProc)( void* context, int task);
+
+enum
+{
+   kMaxPoolWorkers = 15,
+   kMaxPoolTasks   = 64
+};
+
+// --------------------------------------------------------------------------
+// aweWorkerPool
+// --------------------------------------------------------------------------
+
+// A fixed set of worker threads with realtime priority, which help the
+// audio thread with the tasks of one process() call.
+//
+// run() pushes the tasks into the work-stealing deque of the audio thread
+// and wakes the sleeping workers. The audio thread pops the tasks from the
+// bottom, the workers steal from the top. Every finished task is marked in
+// its own flag, the audio thread hands the tasks to done() in their order
+// as soon as all tasks before them are finished, there is no barrier
+// where all threads meet. Nothing in run() locks or allocates.
+//
+// Workers which don't get a core in time don't help, the audio thread
+// then renders the tasks alone and waits for the stolen ones. If that
+// happens in kMaxMisses calls in a row the host keeps the cores busy
+// itself, run() refuses the next kBackoffCalls calls and the caller
+// renders single threaded.
+
+class aweWorkerPool
+{
+public:
+   aweWorkerPool();
+   ~aweWorkerPool();
+
+   // starts numWorkers threads, 0 stops all. Not from the audio thread
+   void start( int numWorkers);
+   void stop();
+   int getNumWorkers()           { return numWorkers; }
+
+   // returns false without calling render() if the tasks are better run
+   // on the calling thread alone
+   bool run( aweTaskProc render, aweTaskProc done, void* context, int numTasks);
+
+   // the calls of run() which returned false since start()
+   int getNumSerialCalls()       { return serialCalls; }
+
+protected:
+   struct Worker
+   {
+      aweWorkerPool* pool;
+      aweThread thread;
+      aweSemaphore wake;
+      volatile int32 sleeping;      // 1 while the worker waits for wake
+   };
+
+   static void workerEntry( void* arg);
+   void workerLoop( Worker* worker);
+   void execute( int32 task);
+
+   int numWorkers;
+   Worker* workers;
+
+   aweWorkDeque tasks;
+   volatile int32 finished[ kMaxPoolTasks];  // generation in which the task was finished
+   volatile int32 generation;                // number of the current run()
+   volatile int32 stolen;                    // tasks finished by the workers
+   volatile int32 quit;
+
+   // the job of the current run(), published by the push of the tasks
+   aweTaskProc render;
+   void* context;
+
+   int misses;                   // calls in a row in which the workers didn't help
+   int backoff;                  // calls left to refuse
+   int serialCalls;
+};
+
+#endif // __aweWorkerPool__